@@ -62,6 +62,7 @@
 #define ALMOND_USING_SDL 
 #define ALMOND_USING_SOFTWARE_RENDERER 
 #define ALMOND_USING_VULKAN
+#define ALMOND_USING_NOOP_HEADLESS  // windowless noop backend for --headless-stress
 
 #if defined(ALMOND_FORCE_DISABLE_SDL)
 #undef ALMOND_USING_SDL
@@ -103,6 +104,14 @@
 #define ALMOND_USING_OPENGL 1
 #endif
 
+#if defined(ALMOND_FORCE_DISABLE_NOOP_HEADLESS)
+#undef ALMOND_USING_NOOP_HEADLESS
+#endif
+#if defined(ALMOND_FORCE_ENABLE_NOOP_HEADLESS)
+#undef ALMOND_USING_NOOP_HEADLESS
+#define ALMOND_USING_NOOP_HEADLESS 1
+#endif
+
 // ============================================================
 // Includes (verbatim, order preserved)
 // ============================================================
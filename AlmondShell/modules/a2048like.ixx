@@ -6,7 +6,7 @@ import aengine.core.context;      // core::Context
 import aengine.context.window;    // core::WindowData
 import aengine.input;             // input::Key
 import aatlas.manager;            // atlasmanager
-import aimage.loader;             // a_loadImage
+import aatlas.cache;              // atlascache::load_or_bake
 import aspritehandle;             // SpriteHandle
 import asprite.pool;              // spritepool
 import ascene;                    // scene::Scene
@@ -106,52 +106,19 @@ export namespace almondnamespace::a2048like
                 throw std::runtime_error("[A2048Like] Missing atlas registrar");
 
             TextureAtlas& atlas = registrar->atlas;
-            bool registered = false;
 
-            auto ensureSprite = [&](std::string_view id)
-            {
-                std::string name(id);
-
-                if (auto existing = atlasmanager::registry.get(name))
-                {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle))
-                    {
-                        sprites[name] = handle;
-                        return;
-                    }
-                }
-
-                auto img = a_loadImage("assets/games/a2048like/" + name + ".ppm", false);
-                if (img.pixels.empty())
-                    return; // optional assets
-
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    name, img.pixels, img.width, img.height, atlas);
+            std::vector<atlascache::SpriteSource> sources{};
+            for (std::string_view id : { "bg", "2", "4", "6", "8", "16", "32", "64", "128", "256", "512", "1024", "2048" })
+                sources.push_back({ std::string(id), "assets/games/a2048like/" + std::string(id) + ".ppm" });
 
-                if (handleOpt && spritepool::is_alive(*handleOpt))
-                {
-                    sprites[name] = *handleOpt;
-                    registered = true;
-                }
-            };
+            const auto baked = atlascache::load_or_bake(*registrar, sources);
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                if (baked.handles[i] && spritepool::is_alive(*baked.handles[i]))
+                    sprites[sources[i].name] = *baked.handles[i];
+            }
 
-            // Always try to load a background sprite if available
-            ensureSprite("bg");
-            ensureSprite("2");
-            ensureSprite("4");
-            ensureSprite("6");
-            ensureSprite("8");
-            ensureSprite("16");
-            ensureSprite("32");
-            ensureSprite("64");
-            ensureSprite("128");
-            ensureSprite("256");
-            ensureSprite("512");
-            ensureSprite("1024");
-            ensureSprite("2048");
-
-            if (createdAtlas || registered)
+            if (createdAtlas || baked.changed)
             {
                 atlas.rebuild_pixels();
                 atlasmanager::ensure_uploaded(atlas);
@@ -0,0 +1,409 @@
+/**************************************************************
+ *   AlmondShell - Modular C++ Framework
+ **************************************************************/
+
+module;
+
+export module aatlas.cache;
+
+// ────────────────────────────────────────────────────────────
+// STANDARD LIBRARY IMPORTS
+// ────────────────────────────────────────────────────────────
+
+import <algorithm>;
+import <cstdint>;
+import <cstring>;
+import <exception>;
+import <filesystem>;
+import <fstream>;
+import <iostream>;
+import <optional>;
+import <span>;
+import <string>;
+import <system_error>;
+import <tuple>;
+import <vector>;
+
+// ────────────────────────────────────────────────────────────
+// ENGINE DEPENDENCIES
+// ────────────────────────────────────────────────────────────
+
+import aatlas.texture;
+import aatlas.manager;
+import aimage.loader;
+import aspritehandle;
+import aspriteregistry;
+import asprite.pool;
+
+// ────────────────────────────────────────────────────────────
+// Baked atlas cache
+//
+// Scenes register a fixed list of image files into a fresh atlas on every
+// load. The cache keys that work by a content hash of the source files and
+// the atlas config; on a hit the packed pixels, region table and sprite names
+// are read back in one pass and adopted by the atlas, skipping decode and
+// packing entirely. Blobs live in <cache dir>/<atlas>-<key>.abake.
+// ────────────────────────────────────────────────────────────
+
+export namespace almondnamespace::atlascache
+{
+    using almondnamespace::atlasmanager::AtlasRegistrar;
+    using almondnamespace::atlasmanager::ImageSource;
+
+    struct SpriteSource
+    {
+        std::string           name;
+        std::filesystem::path path;
+        bool                  flipVertically{ false };
+    };
+
+    struct BakeResult
+    {
+        std::vector<std::optional<SpriteHandle>> handles; // parallel to the sources
+        bool changed{ false };   // atlas contents changed; rebuild + upload
+        bool cacheHit{ false };
+    };
+
+    inline std::filesystem::path g_cacheDirectory = "cache/atlases";
+    inline bool g_cacheEnabled = true;
+
+    inline void set_cache_directory(std::filesystem::path dir) { g_cacheDirectory = std::move(dir); }
+    inline void set_cache_enabled(bool enabled) noexcept { g_cacheEnabled = enabled; }
+
+    namespace detail
+    {
+        inline constexpr char          kMagic[4] = { 'A', 'B', 'A', 'K' };
+        inline constexpr std::uint32_t kFormatVersion = 1;
+        inline constexpr std::uint64_t kMissingSource = ~std::uint64_t{ 0 };
+
+        struct Fnv1a
+        {
+            std::uint64_t value = 14695981039346656037ull;
+
+            void bytes(const void* data, std::size_t size) noexcept
+            {
+                const auto* p = static_cast<const unsigned char*>(data);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    value ^= p[i];
+                    value *= 1099511628211ull;
+                }
+            }
+
+            template <typename T>
+            void pod(const T& v) noexcept { bytes(&v, sizeof(T)); }
+
+            void str(const std::string& s) noexcept
+            {
+                pod(static_cast<std::uint64_t>(s.size()));
+                bytes(s.data(), s.size());
+            }
+        };
+
+        // Absent sources hash as a sentinel so atlases with missing optional
+        // sprites still cache; the key changes once the file shows up.
+        inline std::uint64_t compute_key(
+            const TextureAtlas& atlas,
+            std::span<const SpriteSource> sources)
+        {
+            Fnv1a h{};
+            h.pod(kFormatVersion);
+            h.str(atlas.name);
+            h.pod(atlas.width);
+            h.pod(atlas.height);
+            h.pod(atlas.has_mipmaps);
+
+            std::vector<char> buffer{};
+            for (const auto& src : sources)
+            {
+                h.str(src.name);
+                h.str(src.path.generic_string());
+                h.pod(src.flipVertically);
+
+                std::ifstream in(src.path, std::ios::binary | std::ios::ate);
+                if (!in)
+                {
+                    h.pod(kMissingSource);
+                    continue;
+                }
+
+                buffer.resize(static_cast<std::size_t>(in.tellg()));
+                in.seekg(0);
+                in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                h.pod(static_cast<std::uint64_t>(buffer.size()));
+                h.bytes(buffer.data(), buffer.size());
+            }
+            return h.value;
+        }
+
+        inline std::filesystem::path blob_path(const TextureAtlas& atlas, std::uint64_t key)
+        {
+            char hex[17]{};
+            for (int i = 15; i >= 0; --i, key >>= 4)
+                hex[i] = "0123456789abcdef"[key & 0xF];
+            return g_cacheDirectory / (atlas.name + "-" + hex + ".abake");
+        }
+
+        template <typename T>
+        bool read_pod(std::istream& in, T& v) { return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(T))); }
+
+        template <typename T>
+        void write_pod(std::ostream& out, const T& v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+
+        // Reads the blob straight into atlas.pixel_data; returns the entry table.
+        inline std::optional<std::vector<AtlasEntry>> read_blob(
+            const std::filesystem::path& path,
+            std::uint64_t key,
+            TextureAtlas& atlas)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                return std::nullopt;
+
+            char magic[4]{};
+            std::uint32_t version = 0, width = 0, height = 0, count = 0;
+            std::uint64_t storedKey = 0;
+
+            in.read(magic, 4);
+            if (!in || std::memcmp(magic, kMagic, 4) != 0
+                || !read_pod(in, version) || version != kFormatVersion
+                || !read_pod(in, storedKey) || storedKey != key
+                || !read_pod(in, width) || !read_pod(in, height) || !read_pod(in, count)
+                || width != atlas.width || height != atlas.height)
+            {
+                return std::nullopt;
+            }
+
+            // Every entry needs at least a name length and a region, and the
+            // pixels follow the table; reject counts the file cannot hold.
+            constexpr std::uint64_t kMinEntryBytes = sizeof(std::uint32_t)
+                + sizeof(AtlasRegion::x) + sizeof(AtlasRegion::y)
+                + sizeof(AtlasRegion::width) + sizeof(AtlasRegion::height);
+            const std::uint64_t pixelBytes = static_cast<std::uint64_t>(width) * height * 4;
+            std::error_code sizeEc{};
+            const auto fileSize = std::filesystem::file_size(path, sizeEc);
+            const auto tableOffset = static_cast<std::uint64_t>(in.tellg());
+            if (sizeEc || fileSize < tableOffset + pixelBytes
+                || count > (fileSize - tableOffset - pixelBytes) / kMinEntryBytes)
+            {
+                return std::nullopt;
+            }
+
+            std::vector<AtlasEntry> entries(count);
+            for (auto& e : entries)
+            {
+                std::uint32_t nameLen = 0;
+                if (!read_pod(in, nameLen) || nameLen > 4096)
+                    return std::nullopt;
+                e.name.resize(nameLen);
+                in.read(e.name.data(), nameLen);
+                if (!read_pod(in, e.region.x) || !read_pod(in, e.region.y)
+                    || !read_pod(in, e.region.width) || !read_pod(in, e.region.height))
+                {
+                    return std::nullopt;
+                }
+            }
+
+            atlas.pixel_data.resize(static_cast<std::size_t>(width) * height * 4);
+            in.read(reinterpret_cast<char*>(atlas.pixel_data.data()),
+                static_cast<std::streamsize>(atlas.pixel_data.size()));
+            if (!in)
+            {
+                std::fill(atlas.pixel_data.begin(), atlas.pixel_data.end(), u8{ 0 });
+                return std::nullopt;
+            }
+
+            return entries;
+        }
+
+        inline void write_blob(const std::filesystem::path& path, std::uint64_t key, const TextureAtlas& atlas)
+        {
+            std::error_code ec{};
+            std::filesystem::create_directories(path.parent_path(), ec);
+
+            auto tmp = path;
+            tmp += ".tmp";
+
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                if (!out)
+                {
+                    std::cerr << "[AtlasCache] Cannot write '" << tmp.string() << "'\n";
+                    return;
+                }
+
+                const auto count = static_cast<std::uint32_t>(atlas.entries.size());
+                out.write(kMagic, 4);
+                write_pod(out, kFormatVersion);
+                write_pod(out, key);
+                write_pod(out, atlas.width);
+                write_pod(out, atlas.height);
+                write_pod(out, count);
+
+                for (const auto& e : atlas.entries)
+                {
+                    write_pod(out, static_cast<std::uint32_t>(e.name.size()));
+                    out.write(e.name.data(), static_cast<std::streamsize>(e.name.size()));
+                    write_pod(out, e.region.x);
+                    write_pod(out, e.region.y);
+                    write_pod(out, e.region.width);
+                    write_pod(out, e.region.height);
+                }
+
+                out.write(reinterpret_cast<const char*>(atlas.pixel_data.data()),
+                    static_cast<std::streamsize>(atlas.pixel_data.size()));
+            }
+
+            std::filesystem::rename(tmp, path, ec);
+            if (ec)
+                std::cerr << "[AtlasCache] Failed to publish '" << path.string() << "': " << ec.message() << "\n";
+        }
+
+        inline std::optional<SpriteHandle> find_registered(const std::string& name)
+        {
+            if (auto existing = atlasmanager::registry.get(name))
+            {
+                auto handle = std::get<0>(*existing);
+                if (spritepool::is_alive(handle))
+                    return handle;
+            }
+            return std::nullopt;
+        }
+    } // namespace detail
+
+    // Registers `sources` into the registrar's atlas, going through the baked
+    // cache when the atlas is still empty. Sources that fail to load come back
+    // as nullopt so callers can decide whether they are optional; a missing
+    // file still feeds the cache key, so warm loads of a partially populated
+    // asset folder skip decoding and packing like any other.
+    inline BakeResult load_or_bake(AtlasRegistrar& registrar, std::span<const SpriteSource> sources)
+    {
+        BakeResult result{};
+        result.handles.resize(sources.size());
+
+        TextureAtlas& atlas = registrar.atlas;
+
+        bool allRegistered = true;
+        for (std::size_t i = 0; i < sources.size(); ++i)
+        {
+            result.handles[i] = detail::find_registered(sources[i].name);
+            allRegistered = allRegistered && result.handles[i].has_value();
+        }
+        if (allRegistered)
+            return result;
+
+        const bool freshAtlas = atlas.entry_count() == 0;
+        std::optional<std::uint64_t> key{};
+        if (g_cacheEnabled && freshAtlas)
+            key = detail::compute_key(atlas, sources);
+
+        // ---- Warm path: adopt the baked blob ----
+        if (key)
+        {
+            const auto path = detail::blob_path(atlas, *key);
+            if (auto baked = detail::read_blob(path, *key, atlas))
+            {
+                if (atlas.adopt_baked_entries(std::move(*baked)))
+                {
+                    std::vector<SpriteRegistration> registrations{};
+                    registrations.reserve(atlas.entries.size());
+
+                    for (const auto& entry : atlas.entries)
+                    {
+                        // Sprite names are global; like register_batch, keep
+                        // whichever scene registered the name first.
+                        if (atlasmanager::registry.get(entry.name))
+                            continue;
+
+                        auto allocated = spritepool::allocate();
+                        if (!allocated.is_valid())
+                            continue;
+
+                        registrations.push_back({
+                            entry.name,
+                            SpriteHandle{ allocated.id, allocated.generation,
+                                static_cast<std::uint32_t>(atlas.index),
+                                static_cast<std::uint32_t>(entry.index) },
+                            entry.region.u1, entry.region.v1,
+                            entry.region.uv_width(), entry.region.uv_height() });
+                    }
+
+                    if (atlasmanager::registry.add_batch(registrations) != registrations.size())
+                    {
+                        // Lost a race for a name: free the slots the registry refused.
+                        for (const auto& reg : registrations)
+                        {
+                            const auto registered = atlasmanager::registry.get(reg.name);
+                            if (!registered || std::get<0>(*registered) != reg.handle)
+                                spritepool::free(reg.handle);
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < sources.size(); ++i)
+                        result.handles[i] = detail::find_registered(sources[i].name);
+
+                    result.changed = true;
+                    result.cacheHit = true;
+                    return result;
+                }
+
+                // Adoption failed (corrupt table): fall through and re-bake.
+                atlas.rebuild_pixels();
+            }
+        }
+
+        // ---- Cold path: decode + batch register, then bake ----
+        std::vector<ImageSource> images{};
+        std::vector<std::size_t> imageSource{};
+        bool allLoaded = true;
+
+        for (std::size_t i = 0; i < sources.size(); ++i)
+        {
+            if (result.handles[i])
+                continue;
+
+            // Absent files are part of the key, so they do not block baking.
+            std::error_code existsEc{};
+            if (!std::filesystem::exists(sources[i].path, existsEc))
+                continue;
+
+            try
+            {
+                auto img = a_loadImage(sources[i].path, sources[i].flipVertically);
+                if (img.pixels.empty())
+                {
+                    allLoaded = false;
+                    continue;
+                }
+
+                images.push_back({ sources[i].name, std::move(img.pixels),
+                    static_cast<u32>(img.width), static_cast<u32>(img.height) });
+                imageSource.push_back(i);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[AtlasCache] " << e.what() << "\n";
+                allLoaded = false;
+            }
+        }
+
+        const auto handles = registrar.register_batch(images);
+
+        bool allOnPage = true;
+        for (std::size_t k = 0; k < handles.size(); ++k)
+        {
+            result.handles[imageSource[k]] = handles[k];
+            if (!handles[k])
+                allLoaded = false;
+            else if (handles[k]->atlasIndex != static_cast<std::uint32_t>(atlas.index))
+                allOnPage = false;
+            result.changed = result.changed || handles[k].has_value();
+        }
+
+        // Only bake complete, single-page atlases; anything else re-packs next time.
+        if (key && allLoaded && allOnPage && result.changed)
+            detail::write_blob(detail::blob_path(atlas, *key), *key, atlas);
+
+        return result;
+    }
+} // namespace almondnamespace::atlascache
@@ -5,10 +5,14 @@ import aengine.platform;
 
 import asprite.pool;
 import aatlas.texture;
+import atexture;
 import aspriteregistry;
 import aspritehandle;
 import aengine.context.type;
+import aengine.systems;             // Task
+import aengine.taskgraph.dotsystem;  // taskgraph::TaskGraph, Node
 
+import <algorithm>;
 import <atomic>;
 import <cstdint>;
 import <exception>;
@@ -19,6 +23,8 @@ import <mutex>;
 import <optional>;
 import <queue>;
 import <shared_mutex>;
+import <span>;
+import <thread>;
 import <string>;
 import <tuple>;
 import <unordered_map>;
@@ -49,6 +55,14 @@ export namespace almondnamespace::atlasmanager
     // Stable pointers to heap atlases.
     export inline std::vector<const TextureAtlas*> atlas_vector{};
 
+    export struct ImageSource
+    {
+        std::string     name;
+        std::vector<u8> pixels;     // RGBA8, width * height * 4 bytes
+        u32             width{ 0 };
+        u32             height{ 0 };
+    };
+
     export struct AtlasRegistrar
     {
         TextureAtlas& atlas;
@@ -86,52 +100,41 @@ export namespace almondnamespace::atlasmanager
             return true;
         }
 
+        // Adds the image to sharedAtlas, spilling onto further pages of the atlas
+        // group when sharedAtlas is full. The returned handle's atlasIndex names
+        // the page that actually received the pixels.
         std::optional<SpriteHandle> register_atlas_sprites_by_image(
             const std::string& name,
             const std::vector<u8>& pixels,
             u32 width,
             u32 height,
-            TextureAtlas& sharedAtlas)
-        {
-            if (auto existing = registry.get(name))
-                return std::get<0>(*existing);
-
-            Texture tex{ 0, name, width, height, 4, pixels };
+            TextureAtlas& sharedAtlas);
 
-            auto addedOpt = sharedAtlas.add_entry(name, tex);
-            if (!addedOpt)
-            {
-                std::cerr << "[AtlasRegistrar] Failed to add '" << name << "' to atlas\n";
-                return std::nullopt;
-            }
-
-            auto& added = *addedOpt;
-
-            auto allocated = allocate();
-            if (!allocated.is_valid())
-            {
-                std::cerr << "[AtlasRegistrar] Failed to allocate spritepool handle for '" << name << "'\n";
-                return std::nullopt;
-            }
-
-            SpriteHandle handle{
-                allocated.id,
-                allocated.generation,
-                static_cast<std::uint32_t>(sharedAtlas.index),
-                static_cast<std::uint32_t>(added.index)
-            };
+        // Registers many images at once: one packing pass over all rectangles,
+        // blits fanned out on a task graph, and a single publish into the atlas
+        // and the sprite registry. Results line up with `images`; images that do
+        // not fit this page fall back to the per-image spill path.
+        std::vector<std::optional<SpriteHandle>> register_batch(std::span<const ImageSource> images);
+    };
 
-            registry.add(name, handle,
-                added.region.u1,
-                added.region.v1,
-                added.region.u2 - added.region.u1,
-                added.region.v2 - added.region.v1);
+    export inline std::unordered_map<std::string, std::unique_ptr<AtlasRegistrar>> registrar_map{};
 
-            return handle;
-        }
+    // An atlas group is a growable array of same-sized pages. Page 0 is the atlas
+    // created through create_atlas (and keeps its name); overflow pages are named
+    // "<group>#<n>" and live in atlas_map/atlas_vector like any other atlas, so a
+    // SpriteHandle's atlasIndex addresses the page directly. Groups only spill:
+    // backends still upload and bind every page as a separate texture (binding
+    // a group as one array texture is on the roadmap).
+    export struct AtlasGroup
+    {
+        std::string name;
+        AtlasConfig pageConfig{};
+        std::vector<TextureAtlas*> pages{};   // guarded by atlasMutex
+        std::mutex spillMutex{};              // serialises page creation
     };
 
-    export inline std::unordered_map<std::string, std::unique_ptr<AtlasRegistrar>> registrar_map{};
+    export inline std::unordered_map<std::string, std::unique_ptr<AtlasGroup>> group_map{};
+    export inline std::unordered_map<const TextureAtlas*, AtlasGroup*> page_groups{};
 
     export inline void update_atlas_vector_locked()
     {
@@ -206,42 +209,349 @@ export namespace almondnamespace::atlasmanager
         }
     }
 
+    namespace detail
+    {
+        // Creates one atlas page. A null group starts a new group named after the
+        // atlas; otherwise the page is appended to the given group.
+        inline TextureAtlas* create_atlas_page(const AtlasConfig& config, AtlasGroup* group)
+        {
+            AtlasConfig copy = config;
+            copy.index = nextAtlasIndex.fetch_add(1, std::memory_order_relaxed);
+
+            TextureAtlas* atlasPtr = nullptr;
+
+            {
+                std::unique_lock<std::shared_mutex> atlasLock(atlasMutex);
+
+                if (atlas_map.contains(config.name))
+                {
+                    std::cerr << "[create_atlas] Atlas already exists: " << config.name << "\n";
+                    return nullptr;
+                }
+
+                auto up = std::make_unique<TextureAtlas>();
+                if (!up->init(copy))
+                {
+                    std::cerr << "[create_atlas] Failed to initialize atlas '" << config.name << "'\n";
+                    return nullptr;
+                }
+
+                atlasPtr = up.get();
+                atlas_map.emplace(config.name, std::move(up));
+
+                if (!group)
+                {
+                    auto groupUp = std::make_unique<AtlasGroup>();
+                    groupUp->name = config.name;
+                    groupUp->pageConfig = config;
+                    group = groupUp.get();
+                    group_map.insert_or_assign(config.name, std::move(groupUp));
+                }
+
+                group->pages.push_back(atlasPtr);
+                page_groups.emplace(atlasPtr, group);
+
+                update_atlas_vector_locked();
+            }
+
+            {
+                std::unique_lock<std::shared_mutex> registrarLock(registrarMutex);
+                registrar_map.emplace(config.name, std::make_unique<AtlasRegistrar>(*atlasPtr));
+            }
+
+            notify_backends_of_new_atlas(*atlasPtr);
+            return atlasPtr;
+        }
+
+        inline AtlasGroup* find_group(const TextureAtlas& atlas)
+        {
+            std::shared_lock lock(atlasMutex);
+            auto it = page_groups.find(&atlas);
+            return (it != page_groups.end()) ? it->second : nullptr;
+        }
+
+        // Tries every other page of atlas's group, then appends a fresh page.
+        inline std::pair<TextureAtlas*, std::optional<AtlasEntry>> add_entry_with_spill(
+            TextureAtlas& atlas,
+            const std::string& id,
+            const Texture& tex)
+        {
+            AtlasGroup* group = find_group(atlas);
+            if (!group)
+                return { &atlas, std::nullopt };
+
+            std::scoped_lock spillLock(group->spillMutex);
+
+            std::vector<TextureAtlas*> pages{};
+            {
+                std::shared_lock lock(atlasMutex);
+                pages = group->pages;
+            }
+
+            for (auto* page : pages)
+            {
+                if (page == &atlas)
+                    continue;
+                if (auto added = page->try_add_entry(id, tex))
+                    return { page, std::move(added) };
+            }
+
+            AtlasConfig pageConfig = group->pageConfig;
+            pageConfig.name = group->name + "#" + std::to_string(pages.size());
+
+            TextureAtlas* page = create_atlas_page(pageConfig, group);
+            if (!page)
+                return { &atlas, std::nullopt };
+
+            std::cerr << "[AtlasManager] Atlas group '" << group->name
+                << "' full; spilled to page '" << pageConfig.name << "'\n";
+
+            return { page, page->try_add_entry(id, tex) };
+        }
+    } // namespace detail
+
+    namespace detail
+    {
+        // Below this many bytes a worker pool costs more than the copies.
+        inline constexpr std::size_t kParallelBlitMinBytes = std::size_t{ 1 } << 20;
+
+        inline Task run_range_task(
+            const std::function<void(std::size_t, std::size_t)>* fn,
+            std::size_t begin,
+            std::size_t end)
+        {
+            (*fn)(begin, end);
+            co_return;
+        }
+
+        // Runs fn over [0, count) in contiguous chunks on a short-lived task graph.
+        inline void parallel_for_ranges(
+            std::size_t count,
+            std::size_t totalBytes,
+            const std::function<void(std::size_t, std::size_t)>& fn)
+        {
+            const std::size_t hw = (std::max)(1u, std::thread::hardware_concurrency());
+            const std::size_t workers = (std::min)(hw, count);
+
+            if (workers <= 1 || totalBytes < kParallelBlitMinBytes)
+            {
+                fn(0, count);
+                return;
+            }
+
+            taskgraph::TaskGraph graph(workers);
+            const std::size_t chunks = workers * 4;
+            const std::size_t step = (count + chunks - 1) / chunks;
+
+            for (std::size_t begin = 0; begin < count; begin += step)
+            {
+                auto node = std::make_unique<taskgraph::Node>(
+                    run_range_task(&fn, begin, (std::min)(count, begin + step)));
+                node->Label = "AtlasBatchBlit";
+                graph.AddNode(std::move(node));
+            }
+
+            graph.Execute();
+            graph.WaitAll();
+        }
+    } // namespace detail
+
     export inline bool create_atlas(const AtlasConfig& config)
     {
-        AtlasConfig copy = config;
-        copy.index = nextAtlasIndex.fetch_add(1, std::memory_order_relaxed);
+        return detail::create_atlas_page(config, nullptr) != nullptr;
+    }
+
+    inline std::optional<SpriteHandle> AtlasRegistrar::register_atlas_sprites_by_image(
+        const std::string& name,
+        const std::vector<u8>& pixels,
+        u32 width,
+        u32 height,
+        TextureAtlas& sharedAtlas)
+    {
+        if (auto existing = registry.get(name))
+            return std::get<0>(*existing);
+
+        Texture tex{ 0, name, width, height, 4, pixels };
 
-        TextureAtlas* atlasPtr = nullptr;
+        TextureAtlas* target = &sharedAtlas;
+        auto addedOpt = sharedAtlas.try_add_entry(name, tex);
 
+        const bool packFailure = !addedOpt
+            && !pixels.empty()
+            && width <= sharedAtlas.width
+            && height <= sharedAtlas.height
+            && !sharedAtlas.get_region(name);
+
+        if (packFailure)
+            std::tie(target, addedOpt) = detail::add_entry_with_spill(sharedAtlas, name, tex);
+
+        if (!addedOpt)
         {
-            std::unique_lock<std::shared_mutex> atlasLock(atlasMutex);
+            std::cerr << "[AtlasRegistrar] Failed to add '" << name << "' to atlas\n";
+            return std::nullopt;
+        }
+
+        auto& added = *addedOpt;
 
-            if (atlas_map.contains(config.name))
+        auto allocated = allocate();
+        if (!allocated.is_valid())
+        {
+            std::cerr << "[AtlasRegistrar] Failed to allocate spritepool handle for '" << name << "'\n";
+            return std::nullopt;
+        }
+
+        SpriteHandle handle{
+            allocated.id,
+            allocated.generation,
+            static_cast<std::uint32_t>(target->index),
+            static_cast<std::uint32_t>(added.index)
+        };
+
+        registry.add(name, handle,
+            added.region.u1,
+            added.region.v1,
+            added.region.u2 - added.region.u1,
+            added.region.v2 - added.region.v1);
+
+        return handle;
+    }
+
+    inline std::vector<std::optional<SpriteHandle>> AtlasRegistrar::register_batch(
+        std::span<const ImageSource> images)
+    {
+        std::vector<std::optional<SpriteHandle>> results(images.size());
+
+        std::vector<std::size_t> pending{};
+        std::vector<AtlasBatchRequest> requests{};
+        pending.reserve(images.size());
+        requests.reserve(images.size());
+
+        // A name repeated within the batch resolves to its first occurrence.
+        std::unordered_map<std::string, std::size_t> firstByName{};
+        std::vector<std::pair<std::size_t, std::size_t>> repeats{};
+        firstByName.reserve(images.size());
+
+        for (std::size_t i = 0; i < images.size(); ++i)
+        {
+            const auto& img = images[i];
+
+            if (auto [it, inserted] = firstByName.try_emplace(img.name, i); !inserted)
             {
-                std::cerr << "[create_atlas] Atlas already exists: " << config.name << "\n";
-                return false;
+                repeats.emplace_back(i, it->second);
+                continue;
             }
 
-            auto up = std::make_unique<TextureAtlas>();
-            if (!up->init(copy))
+            if (auto existing = registry.get(img.name))
             {
-                std::cerr << "[create_atlas] Failed to initialize atlas '" << config.name << "'\n";
-                return false;
+                results[i] = std::get<0>(*existing);
+                continue;
             }
 
-            atlasPtr = up.get();
-            atlas_map.emplace(config.name, std::move(up));
+            const std::size_t required = static_cast<std::size_t>(img.width) * img.height * 4;
+            if (img.width == 0 || img.height == 0 || img.pixels.size() < required)
+            {
+                std::cerr << "[AtlasRegistrar] Rejected empty or short image '" << img.name << "'\n";
+                continue;
+            }
+
+            pending.push_back(i);
+            requests.push_back({ img.name, img.width, img.height });
+        }
+
+        const auto regions = atlas.reserve_regions(requests);
+
+        std::vector<AtlasEntry> placed{};
+        std::vector<std::size_t> placedSource{};
+        std::vector<SpriteHandle> placedHandles{};
+        std::vector<std::size_t> overflow{};
+        std::vector<AtlasRegion> unused{};
+        std::size_t totalBytes = 0;
+
+        placed.reserve(pending.size());
+        placedSource.reserve(pending.size());
+        placedHandles.reserve(pending.size());
+
+        for (std::size_t k = 0; k < pending.size(); ++k)
+        {
+            const auto& img = images[pending[k]];
+            if (!regions[k])
+            {
+                overflow.push_back(pending[k]);
+                continue;
+            }
+
+            // Handles come before the commit, so a failed allocation hands its
+            // region back instead of leaving an entry nothing refers to.
+            auto allocated = allocate();
+            if (!allocated.is_valid())
+            {
+                std::cerr << "[AtlasRegistrar] Failed to allocate spritepool handle for '" << img.name << "'\n";
+                unused.push_back(*regions[k]);
+                continue;
+            }
+            placedHandles.push_back(allocated);
+
+            AtlasEntry entry{};
+            entry.name = img.name;
+            entry.region = *regions[k];
+            entry.texWidth = img.width;
+            entry.texHeight = img.height;
+            placed.push_back(std::move(entry));
+            placedSource.push_back(pending[k]);
+            totalBytes += static_cast<std::size_t>(img.width) * img.height * 4;
+        }
 
-            update_atlas_vector_locked();
+        const std::function<void(std::size_t, std::size_t)> blitRange =
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t j = begin; j < end; ++j)
+                {
+                    const auto& img = images[placedSource[j]];
+                    auto& entry = placed[j];
+                    entry.pixels.assign(img.pixels.begin(),
+                        img.pixels.begin() + static_cast<std::ptrdiff_t>(img.width) * img.height * 4);
+                    atlas.blit_region(entry.region, entry.pixels.data());
+                }
+            };
+
+        detail::parallel_for_ranges(placed.size(), totalBytes, blitRange);
+
+        atlas.release_regions(unused);
+        atlas.commit_entries(placed);
+
+        std::vector<SpriteRegistration> registrations{};
+        registrations.reserve(placed.size());
+
+        for (std::size_t j = 0; j < placed.size(); ++j)
+        {
+            const auto& entry = placed[j];
+            SpriteHandle handle{
+                placedHandles[j].id,
+                placedHandles[j].generation,
+                static_cast<std::uint32_t>(atlas.index),
+                static_cast<std::uint32_t>(entry.index)
+            };
+
+            results[placedSource[j]] = handle;
+            registrations.push_back({
+                images[placedSource[j]].name, handle,
+                entry.region.u1, entry.region.v1,
+                entry.region.u2 - entry.region.u1,
+                entry.region.v2 - entry.region.v1 });
         }
 
+        registry.add_batch(registrations);
+
+        for (std::size_t i : overflow)
         {
-            std::unique_lock<std::shared_mutex> registrarLock(registrarMutex);
-            registrar_map.emplace(config.name, std::make_unique<AtlasRegistrar>(*atlasPtr));
+            const auto& img = images[i];
+            results[i] = register_atlas_sprites_by_image(img.name, img.pixels, img.width, img.height, atlas);
         }
 
-        notify_backends_of_new_atlas(*atlasPtr);
-        return true;
+        for (const auto& [repeat, first] : repeats)
+            results[repeat] = results[first];
+
+        return results;
     }
 
     export inline AtlasRegistrar* get_registrar(const std::string& name)
@@ -258,6 +568,17 @@ export namespace almondnamespace::atlasmanager
         return atlas_vector;
     }
 
+    // Pages of the group that owns `atlas`, in page order; an atlas outside
+    // any group yields just itself. Each page uploads as its own texture.
+    export inline std::vector<const TextureAtlas*> get_atlas_group_pages(const TextureAtlas& atlas)
+    {
+        std::shared_lock lock(atlasMutex);
+        auto it = page_groups.find(&atlas);
+        if (it == page_groups.end())
+            return { &atlas };
+        return { it->second->pages.begin(), it->second->pages.end() };
+    }
+
     export inline void register_backend_uploader(
         core::ContextType type,
         std::function<void(const TextureAtlas&)> ensureFn)
@@ -382,9 +703,12 @@ export namespace almondnamespace::atlasmanager
         }
     }
 
+    // Uploading any page also queues its sibling pages: spill pages are created
+    // mid-registration and callers usually only hold the group's first page.
     export inline void ensure_uploaded(const TextureAtlas& atlas)
     {
-        enqueue_upload_for_all(atlas);
+        for (const auto* page : get_atlas_group_pages(atlas))
+            enqueue_upload_for_all(*page);
 
         if (detail::activeBackend && !detail::processingUploads)
             process_pending_uploads(*detail::activeBackend);
@@ -21,6 +21,9 @@ import <shared_mutex>; // legacy include; this module now uses recursive_mutex f
 import <unordered_map>;
 import <memory>;    // std::unique_ptr
 import <utility>;   // std::pair
+import <numeric>;   // std::iota
+import <span>;
+import <string_view>;
 
 // ────────────────────────────────────────────────────────────
 // ENGINE DEPENDENCIES
@@ -53,6 +56,14 @@ export namespace almondnamespace
         [[nodiscard]] float uv_height() const noexcept { return v2 - v1; }
     };
 
+    // Pixel rectangle rewritten by the version bump that recorded it.
+    struct AtlasDirtyRect
+    {
+        u64 version{};
+        u32 x{}, y{};
+        u32 width{}, height{};
+    };
+
     // ────────────────────────────────────────────────────────
     // ATLAS ENTRY
     // ────────────────────────────────────────────────────────
@@ -98,6 +109,17 @@ export namespace almondnamespace
         int index{ 0 };
     };
 
+    // ────────────────────────────────────────────────────────
+    // ATLAS BATCH REQUEST
+    // ────────────────────────────────────────────────────────
+
+    struct AtlasBatchRequest
+    {
+        std::string_view id;
+        u32 width{ 0 };
+        u32 height{ 0 };
+    };
+
     // ────────────────────────────────────────────────────────
     // TEXTURE ATLAS
     // ────────────────────────────────────────────────────────
@@ -147,6 +169,8 @@ export namespace almondnamespace
                 std::unique_lock lock(entriesMutex);
                 entries.clear();
                 lookup.clear();
+                dirtyLog.clear();
+                dirtyLogFloor = 0;
             }
 
             version = 0;
@@ -199,10 +223,43 @@ export namespace almondnamespace
         [[nodiscard]] int get_index() const noexcept { return index; }
 
         std::optional<AtlasEntry> add_entry(const std::string& id, const Texture& tex);
+        // Same as add_entry but stays quiet when the page is full so callers can spill
+        // to another atlas page without spamming "Failed to pack".
+        std::optional<AtlasEntry> try_add_entry(const std::string& id, const Texture& tex);
         std::optional<AtlasEntry> add_slice_entry(const std::string& id, int x, int y, int w, int h);
         std::optional<AtlasRegion> get_region(const std::string& id) const;
         void rebuild_pixels() const;
 
+        // Batch registration, in three steps:
+        //   reserve_regions - packs every rectangle under a single lock (tallest first);
+        //   blit_region     - copies pixels into a reserved region; disjoint regions may
+        //                     be blitted concurrently from worker threads;
+        //   commit_entries  - publishes the entries (assigning indices in place) with a
+        //                     single version bump. Entry pixels are moved into the atlas.
+        // IDs already in the atlas, and repeats of an ID within one batch, get no
+        // region. Reserved regions that will not be committed go back through
+        // release_regions.
+        std::vector<std::optional<AtlasRegion>> reserve_regions(std::span<const AtlasBatchRequest> requests);
+        void blit_region(const AtlasRegion& region, const u8* pixels) const noexcept;
+        void commit_entries(std::span<AtlasEntry> batch);
+        void release_regions(std::span<const AtlasRegion> regions);
+
+        // Publishes an in-place rewrite of an already committed region (e.g.
+        // blit_region over an animated tile): bumps the version and logs the
+        // rectangle so mirrors pick it up through dirty_regions_since.
+        void mark_region_dirty(const AtlasRegion& region);
+
+        // Adopts a pre-packed entry table (baked atlas cache) whose pixels have
+        // already been loaded into pixel_data. Only valid on an empty atlas; marks
+        // the regions used and slices per-entry pixels back out so rebuild_pixels
+        // keeps working.
+        bool adopt_baked_entries(std::vector<AtlasEntry>&& baked);
+
+        // Appends the rectangles written after `sinceVersion` to `out`, for
+        // CPU-side mirrors that refresh incrementally. Returns false when the
+        // log no longer reaches back that far; the caller re-reads everything.
+        bool dirty_regions_since(u64 sinceVersion, std::vector<AtlasDirtyRect>& out) const;
+
     private:
         // IMPORTANT:
         // This atlas is accessed by both upload/build paths and GUI query paths.
@@ -217,15 +274,37 @@ export namespace almondnamespace
         std::unordered_map<std::string, AtlasRegion> lookup;
         std::vector<std::vector<bool>> occupancy;
 
+        // Bounded; dropping old rects raises the floor instead of losing updates.
+        static constexpr std::size_t kMaxDirtyLog = 64;
+        mutable std::vector<AtlasDirtyRect> dirtyLog;
+        mutable u64 dirtyLogFloor{ 0 };
+
+        std::optional<AtlasEntry> add_entry_impl(const std::string& id, const Texture& tex, bool reportPackFailure);
         std::optional<std::pair<u32, u32>> try_pack(u32 w, u32 h);
+        AtlasRegion make_region(u32 x, u32 y, u32 w, u32 h) const noexcept;
         bool can_place(u32 x, u32 y, u32 w, u32 h) const;
-        void mark_used(u32 x, u32 y, u32 w, u32 h);
+        std::optional<u32> last_blocked_column(u32 x, u32 y, u32 w, u32 h) const;
+        void mark_used(u32 x, u32 y, u32 w, u32 h, bool used = true);
+        void note_dirty(u32 x, u32 y, u32 w, u32 h) const;
     };
 }
 
 namespace almondnamespace
 {
     inline std::optional<AtlasEntry> TextureAtlas::add_entry(const std::string& id, const Texture& tex)
+    {
+        return add_entry_impl(id, tex, true);
+    }
+
+    inline std::optional<AtlasEntry> TextureAtlas::try_add_entry(const std::string& id, const Texture& tex)
+    {
+        return add_entry_impl(id, tex, false);
+    }
+
+    inline std::optional<AtlasEntry> TextureAtlas::add_entry_impl(
+        const std::string& id,
+        const Texture& tex,
+        bool reportPackFailure)
     {
         if (tex.width == 0 || tex.height == 0 || tex.pixels.empty()) {
             std::cerr << "[Atlas] Rejected empty texture '" << id << "'\n";
@@ -241,35 +320,21 @@ namespace almondnamespace
 
         auto pos = try_pack(tex.width, tex.height);
         if (!pos) {
-            std::cerr << "[Atlas] Failed to pack '" << id << "'\n";
+            if (reportPackFailure)
+                std::cerr << "[Atlas] Failed to pack '" << id << "'\n";
             return std::nullopt;
         }
 
         auto [x, y] = *pos;
-        const u32 stride = width * 4;
-
-        for (u32 row = 0; row < tex.height; ++row) {
-            u8* dst = pixel_data.data() + ((y + row) * stride) + (x * 4);
-            const u8* src = tex.pixels.data() + (row * tex.width * 4);
-            std::copy_n(src, tex.width * 4, dst);
-        }
-
-        AtlasRegion region{
-            .u1 = static_cast<float>(x) / width,
-            .v1 = static_cast<float>(height - (y + tex.height)) / height,
-            .u2 = static_cast<float>(x + tex.width) / width,
-            .v2 = static_cast<float>(height - y) / height,
-            .x = x,
-            .y = y,
-            .width = tex.width,
-            .height = tex.height
-        };
+        const AtlasRegion region = make_region(x, y, tex.width, tex.height);
+        blit_region(region, tex.pixels.data());
 
         int entryIndex = static_cast<int>(entries.size());
         AtlasEntry entry{ entryIndex, id, region, tex.pixels, tex.width, tex.height };
         entries.push_back(entry);
         lookup.emplace(id, region);
         ++version;
+        note_dirty(region.x, region.y, region.width, region.height);
 #if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
         std::cerr << "[Atlas] Added '" << id << "' at (" << x << ", " << y
             << ") EntryIndex=" << entryIndex << "\n";
@@ -371,22 +436,218 @@ namespace almondnamespace
         }
 
         ++version;
+        note_dirty(0, 0, width, height);
+    }
+
+    inline std::vector<std::optional<AtlasRegion>> TextureAtlas::reserve_regions(
+        std::span<const AtlasBatchRequest> requests)
+    {
+        std::vector<std::optional<AtlasRegion>> regions(requests.size());
+
+        // Tallest (then widest) first keeps the first-fit scan dense.
+        std::vector<std::size_t> order(requests.size());
+        std::iota(order.begin(), order.end(), std::size_t{ 0 });
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            if (requests[a].height != requests[b].height)
+                return requests[a].height > requests[b].height;
+            return requests[a].width > requests[b].width;
+            });
+
+        // The first request for an ID (in request order) is the one packed.
+        std::unordered_map<std::string_view, std::size_t> firstRequest{};
+        firstRequest.reserve(requests.size());
+        for (std::size_t i = 0; i < requests.size(); ++i)
+            firstRequest.try_emplace(requests[i].id, i);
+
+        std::unique_lock<std::recursive_mutex> lock(entriesMutex);
+
+        for (std::size_t i : order) {
+            const auto& req = requests[i];
+            if (req.width == 0 || req.height == 0)
+                continue;
+
+            if (firstRequest[req.id] != i || lookup.contains(std::string(req.id))) {
+                std::cerr << "[Atlas] Duplicate ID: '" << req.id << "'\n";
+                continue;
+            }
+
+            if (auto pos = try_pack(req.width, req.height))
+                regions[i] = make_region(pos->first, pos->second, req.width, req.height);
+        }
+
+        return regions;
+    }
+
+    inline void TextureAtlas::blit_region(const AtlasRegion& region, const u8* pixels) const noexcept
+    {
+        const std::size_t stride = static_cast<std::size_t>(width) * 4;
+        const std::size_t rowBytes = static_cast<std::size_t>(region.width) * 4;
+
+        for (u32 row = 0; row < region.height; ++row) {
+            u8* dst = pixel_data.data() + ((region.y + row) * stride) + (region.x * 4);
+            const u8* src = pixels + (static_cast<std::size_t>(row) * rowBytes);
+            std::copy_n(src, rowBytes, dst);
+        }
+    }
+
+    inline void TextureAtlas::commit_entries(std::span<AtlasEntry> batch)
+    {
+        if (batch.empty())
+            return;
+
+        std::unique_lock<std::recursive_mutex> lock(entriesMutex);
+
+        entries.reserve(entries.size() + batch.size());
+        for (auto& entry : batch) {
+            entry.index = static_cast<int>(entries.size());
+            entries.push_back(AtlasEntry{
+                entry.index, entry.name, entry.region,
+                std::move(entry.pixels), entry.texWidth, entry.texHeight });
+            lookup.emplace(entry.name, entry.region);
+        }
+
+        ++version;
+        for (const auto& entry : batch)
+            note_dirty(entry.region.x, entry.region.y, entry.region.width, entry.region.height);
+#if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
+        std::cerr << "[Atlas] Committed batch of " << batch.size()
+            << " entries to '" << name << "'\n";
+#endif
+    }
+
+    inline void TextureAtlas::release_regions(std::span<const AtlasRegion> regions)
+    {
+        std::unique_lock<std::recursive_mutex> lock(entriesMutex);
+        for (const auto& r : regions)
+            mark_used(r.x, r.y, r.width, r.height, false);
+    }
+
+    inline void TextureAtlas::mark_region_dirty(const AtlasRegion& region)
+    {
+        std::unique_lock<std::recursive_mutex> lock(entriesMutex);
+        ++version;
+        note_dirty(region.x, region.y, region.width, region.height);
+    }
+
+    inline bool TextureAtlas::adopt_baked_entries(std::vector<AtlasEntry>&& baked)
+    {
+        std::unique_lock<std::recursive_mutex> lock(entriesMutex);
+
+        if (!entries.empty()) {
+            std::cerr << "[Atlas] Refusing to adopt baked entries into non-empty atlas '" << name << "'\n";
+            return false;
+        }
+
+        const std::size_t stride = static_cast<std::size_t>(width) * 4;
+        entries.reserve(baked.size());
+
+        for (auto& entry : baked) {
+            const auto& r = entry.region;
+            if (r.width == 0 || r.height == 0 || r.x + r.width > width || r.y + r.height > height
+                || lookup.contains(entry.name)) {
+                std::cerr << "[Atlas] Baked entry '" << entry.name << "' is out of bounds or duplicated\n";
+                entries.clear();
+                lookup.clear();
+                occupancy.assign(height, std::vector<bool>(width, false));
+                return false;
+            }
+
+            mark_used(r.x, r.y, r.width, r.height);
+
+            const std::size_t rowBytes = static_cast<std::size_t>(r.width) * 4;
+            entry.pixels.resize(rowBytes * r.height);
+            for (u32 row = 0; row < r.height; ++row) {
+                const u8* src = pixel_data.data() + ((r.y + row) * stride) + (r.x * 4);
+                std::copy_n(src, rowBytes, entry.pixels.data() + row * rowBytes);
+            }
+
+            entry.region = make_region(r.x, r.y, r.width, r.height);
+            entry.texWidth = r.width;
+            entry.texHeight = r.height;
+            entry.index = static_cast<int>(entries.size());
+            lookup.emplace(entry.name, entry.region);
+            entries.push_back(std::move(entry));
+        }
+
+        ++version;
+        note_dirty(0, 0, width, height);
+        return true;
+    }
+
+    inline void TextureAtlas::note_dirty(u32 x, u32 y, u32 w, u32 h) const
+    {
+        std::unique_lock<std::recursive_mutex> lock(entriesMutex);
+
+        if (dirtyLog.size() >= kMaxDirtyLog) {
+            const auto drop = dirtyLog.size() / 2;
+            dirtyLogFloor = dirtyLog[drop - 1].version;
+            dirtyLog.erase(dirtyLog.begin(), dirtyLog.begin() + static_cast<std::ptrdiff_t>(drop));
+        }
+        dirtyLog.push_back({ version, x, y, w, h });
+    }
+
+    inline bool TextureAtlas::dirty_regions_since(u64 sinceVersion, std::vector<AtlasDirtyRect>& out) const
+    {
+        std::unique_lock<std::recursive_mutex> lock(entriesMutex);
+
+        if (sinceVersion < dirtyLogFloor || sinceVersion > version)
+            return false;
+
+        for (const auto& rect : dirtyLog) {
+            if (rect.version > sinceVersion)
+                out.push_back(rect);
+        }
+        return true;
+    }
+
+    inline AtlasRegion TextureAtlas::make_region(u32 x, u32 y, u32 w, u32 h) const noexcept
+    {
+        return AtlasRegion{
+            .u1 = static_cast<float>(x) / width,
+            .v1 = static_cast<float>(height - (y + h)) / height,
+            .u2 = static_cast<float>(x + w) / width,
+            .v2 = static_cast<float>(height - y) / height,
+            .x = x,
+            .y = y,
+            .width = w,
+            .height = h
+        };
     }
 
     inline std::optional<std::pair<u32, u32>> TextureAtlas::try_pack(u32 w, u32 h)
     {
         for (u32 y = 0; y + h <= height; ++y) {
-            for (u32 x = 0; x + w <= width; ++x) {
-                if (can_place(x, y, w, h)) {
+            for (u32 x = 0; x + w <= width;) {
+                const auto blocked = last_blocked_column(x, y, w, h);
+                if (!blocked) {
                     mark_used(x, y, w, h);
                     return { std::pair{ x, y } };
                 }
+                // Any start left of the blocking cell overlaps it as well.
+                x = *blocked + 1;
             }
         }
 
         return std::nullopt;
     }
 
+    inline std::optional<u32> TextureAtlas::last_blocked_column(u32 x, u32 y, u32 w, u32 h) const
+    {
+        std::optional<u32> blocked{};
+        for (u32 dy = 0; dy < h; ++dy) {
+            const auto& row = occupancy[y + dy];
+            for (u32 dx = w; dx-- > 0;) {
+                if (row[x + dx]) {
+                    if (!blocked || x + dx > *blocked)
+                        blocked = x + dx;
+                    break;
+                }
+            }
+        }
+
+        return blocked;
+    }
+
     inline bool TextureAtlas::can_place(u32 x, u32 y, u32 w, u32 h) const
     {
         for (u32 dy = 0; dy < h; ++dy) {
@@ -400,11 +661,11 @@ namespace almondnamespace
         return true;
     }
 
-    inline void TextureAtlas::mark_used(u32 x, u32 y, u32 w, u32 h)
+    inline void TextureAtlas::mark_used(u32 x, u32 y, u32 w, u32 h, bool used)
     {
         for (u32 dy = 0; dy < h; ++dy) {
             for (u32 dx = 0; dx < w; ++dx) {
-                occupancy[y + dy][x + dx] = true;
+                occupancy[y + dy][x + dx] = used;
             }
         }
     }
@@ -8,24 +8,49 @@ module;
 export module acontext.noop.context;
 
 import <atomic>;
+import <chrono>;
+import <cstdint>;
 import <memory>;
+import <span>;
 
 import aengine.context.commandqueue;
+import aengine.context.type;
 import aengine.core.context;
 import aengine.diagnostics;
+import aatlas.manager;
+import aatlas.texture;
+import aspritehandle;
 
 namespace almondnamespace::noopcontext
 {
 #if defined(ALMOND_USING_NOOP_HEADLESS)
     inline std::atomic_bool running{ false };
+    inline std::atomic<std::uint64_t> uploadPasses{ 0 };
+    inline std::atomic<std::uint64_t> uploadNs{ 0 };
 #endif
 }
 
 export namespace almondnamespace::noopcontext
 {
 #if defined(ALMOND_USING_NOOP_HEADLESS)
+    // Atlas upload bookkeeping done by noop frames: the same queue walk a
+    // real backend does, with nothing to upload.
+    struct UploadTotals
+    {
+        std::uint64_t passes = 0;
+        std::uint64_t ns = 0;
+    };
+
+    inline UploadTotals upload_totals() noexcept
+    {
+        return UploadTotals{
+            uploadPasses.load(std::memory_order_relaxed),
+            uploadNs.load(std::memory_order_relaxed) };
+    }
+
     inline void noop_initialize()
     {
+        atlasmanager::register_backend_uploader(core::ContextType::Noop, [](const TextureAtlas&) {});
         running.store(true, std::memory_order_release);
     }
 
@@ -43,6 +68,12 @@ export namespace almondnamespace::noopcontext
             ctx->virtualHeight = 1;
         }
 
+        const auto uploadStart = std::chrono::steady_clock::now();
+        atlasmanager::process_pending_uploads(core::ContextType::Noop);
+        uploadNs.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - uploadStart).count()), std::memory_order_relaxed);
+        uploadPasses.fetch_add(1, std::memory_order_relaxed);
+
         queue.drain();
 
         frameTimer.finish();
@@ -58,6 +89,10 @@ export namespace almondnamespace::noopcontext
     inline void noop_clear() {}
     inline void noop_present() {}
 
+    // Accepts draws so scenes exercise the command queue; nothing is drawn.
+    inline void noop_draw_sprite(SpriteHandle, std::span<const TextureAtlas* const>,
+        float, float, float, float) {}
+
     inline int noop_get_width() { return 1; }
     inline int noop_get_height() { return 1; }
 #endif
@@ -0,0 +1,245 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondEngine - Modular C++ Game Engine                   *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for non-commercial purposes only           *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution allowed with this notice.                 *
+ *   No obligation to disclose modifications.                 *
+ *   See LICENSE file for full terms.                         *
+ **************************************************************/
+ //
+ // acontext.softrenderer.blit.ixx
+ // SoftRenderer - 2D blit engine (scaled sprite/quad copies and blends)
+ //
+ // Clipping is done once per blit, source coordinates are stepped in 16.16
+ // fixed point, and each destination row is processed as one span through
+ // the apixel.convert kernels: format swizzle, premultiply and "over" blend
+ // run 4-8 pixels per instruction. Spans whose source is fully opaque skip
+ // the blend and are copied directly. Bilinear blits filter with the
+ // sampler's fixed-point kernel, clamped to the source region so atlas
+ // neighbours never bleed in.
+ //
+
+module;
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+export module acontext.softrenderer.blit;
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+
+import <algorithm>;
+import <cstdint>;
+import <cstring>;
+import <vector>;
+
+import apixel.convert;                   // pixel::* kernels
+import acontext.softrenderer.sampler;    // sampler::Filter, bilinear kernel
+
+export namespace almondnamespace::anativecontext::blit
+{
+    enum class SourceFormat : std::uint8_t
+    {
+        RGBA8,   // atlas bytes R,G,B,A
+        ARGB32   // packed 0xAARRGGBB, same as the framebuffer
+    };
+
+    enum class BlendMode : std::uint8_t
+    {
+        Copy,       // overwrite, alpha ignored
+        AlphaOver   // straight-alpha source composited over the target
+    };
+
+    struct BlitSource
+    {
+        const std::uint32_t* pixels = nullptr;
+        int stride = 0;                 // pixels per source row
+        int x = 0, y = 0;               // region origin
+        int width = 0, height = 0;      // region size
+        SourceFormat format = SourceFormat::RGBA8;
+    };
+
+    struct BlitTarget
+    {
+        std::uint32_t* color = nullptr; // packed 0xAARRGGBB, stride == width
+        int width = 0;
+        int height = 0;
+    };
+
+    namespace detail
+    {
+        struct RowScratch
+        {
+            std::vector<std::uint32_t> columns{};  // source column per destination pixel
+            std::vector<std::uint32_t> columns1{}; // bilinear: right-hand column
+            std::vector<std::uint32_t> weights{};  // bilinear: 8-bit x fraction
+            std::vector<std::uint32_t> gathered{};
+            std::vector<std::uint32_t> shaded{};
+        };
+
+        inline RowScratch& scratch()
+        {
+            thread_local RowScratch rows{};
+            return rows;
+        }
+
+        // Source texel for destination offset d, matching floor(d * src / dst).
+        [[nodiscard]] inline std::uint64_t fixed_step(int src, int dst) noexcept
+        {
+            return (std::uint64_t(src) << 16) / std::uint64_t(dst);
+        }
+
+        // Texel pair + fraction for a 16.16 position measured from texel centres.
+        inline void bilinear_tap(std::int64_t f, int size, std::uint32_t& i0, std::uint32_t& i1, std::uint32_t& w) noexcept
+        {
+            const std::int64_t base = f >> 16;
+            w = std::uint32_t((f >> 8) & 0xFF);
+            i0 = std::uint32_t(std::clamp<std::int64_t>(base, 0, size - 1));
+            i1 = std::uint32_t(std::clamp<std::int64_t>(base + 1, 0, size - 1));
+        }
+
+        inline void to_argb(const std::uint32_t* src, std::uint32_t* dst, std::size_t n, SourceFormat format) noexcept
+        {
+            if (format == SourceFormat::RGBA8)
+                pixel::rgba8_to_argb32(reinterpret_cast<const std::uint8_t*>(src), dst, n);
+            else if (src != dst)
+                std::memcpy(dst, src, n * sizeof(std::uint32_t));
+        }
+    } // namespace detail
+
+    // Scales the source region onto [destX, destX+destW) x [destY, destY+destH),
+    // clipped to the target. 1:1 bilinear blits land on texel centres and
+    // reproduce the source exactly.
+    inline void blit_scaled(
+        const BlitTarget& target,
+        const BlitSource& source,
+        int destX, int destY, int destW, int destH,
+        BlendMode mode,
+        sampler::Filter filter = sampler::Filter::Nearest)
+    {
+        if (!target.color || !source.pixels || destW <= 0 || destH <= 0
+            || source.width <= 0 || source.height <= 0)
+        {
+            return;
+        }
+
+        const int clipX0 = (std::max)(0, destX);
+        const int clipY0 = (std::max)(0, destY);
+        const int clipX1 = (std::min)(target.width, destX + destW);
+        const int clipY1 = (std::min)(target.height, destY + destH);
+        if (clipX0 >= clipX1 || clipY0 >= clipY1)
+            return;
+
+        const std::size_t spanLen = std::size_t(clipX1 - clipX0);
+        const bool bilinear = filter == sampler::Filter::Bilinear
+            && (destW != source.width || destH != source.height);
+        const bool identityX = !bilinear && destW == source.width;
+
+        auto& rows = detail::scratch();
+        rows.gathered.resize(spanLen);
+        rows.shaded.resize(spanLen);
+
+        if (bilinear)
+        {
+            rows.columns.resize(spanLen);
+            rows.columns1.resize(spanLen);
+            rows.weights.resize(spanLen);
+            const auto stepX = std::int64_t(detail::fixed_step(source.width, destW));
+            std::int64_t fx = std::int64_t(clipX0 - destX) * stepX + stepX / 2 - 0x8000;
+            for (std::size_t i = 0; i < spanLen; ++i, fx += stepX)
+                detail::bilinear_tap(fx, source.width, rows.columns[i], rows.columns1[i], rows.weights[i]);
+        }
+        else if (!identityX)
+        {
+            rows.columns.resize(spanLen);
+            const std::uint64_t stepX = detail::fixed_step(source.width, destW);
+            std::uint64_t fx = std::uint64_t(clipX0 - destX) * stepX;
+            const auto lastCol = std::uint32_t(source.width - 1);
+            for (std::size_t i = 0; i < spanLen; ++i, fx += stepX)
+                rows.columns[i] = (std::min)(std::uint32_t(fx >> 16), lastCol);
+        }
+
+        const std::uint64_t stepY = detail::fixed_step(source.height, destH);
+        std::uint64_t fy = std::uint64_t(clipY0 - destY) * stepY;
+        int previousSrcY = -1;
+
+        auto source_row = [&](std::uint32_t row)
+            {
+                return source.pixels
+                    + std::size_t(source.y + int(row)) * std::size_t(source.stride)
+                    + std::size_t(source.x);
+            };
+
+        for (int y = clipY0; y < clipY1; ++y, fy += stepY)
+        {
+            const int srcY = (std::min)(int(fy >> 16), source.height - 1);
+            std::uint32_t* dst = target.color + std::size_t(y) * std::size_t(target.width) + std::size_t(clipX0);
+
+            // Copies of a repeated source row are identical to the row above.
+            if (!bilinear && mode == BlendMode::Copy && srcY == previousSrcY)
+            {
+                std::memcpy(dst, dst - target.width, spanLen * sizeof(std::uint32_t));
+                continue;
+            }
+            previousSrcY = srcY;
+
+            const std::uint32_t* srcRow = source_row(std::uint32_t(srcY));
+
+            const std::uint32_t* span = nullptr;
+            if (bilinear)
+            {
+                std::uint32_t row0 = 0, row1 = 0, wy = 0;
+                detail::bilinear_tap(std::int64_t(fy) + std::int64_t(stepY / 2) - 0x8000, source.height, row0, row1, wy);
+                const std::uint32_t* top = source_row(row0);
+                const std::uint32_t* bottom = source_row(row1);
+
+                // Channel order does not matter to the filter, so RGBA8 is converted afterwards.
+                for (std::size_t i = 0; i < spanLen; ++i)
+                {
+                    const std::uint32_t c0 = rows.columns[i];
+                    const std::uint32_t c1 = rows.columns1[i];
+                    rows.gathered[i] = sampler::detail::bilinear(
+                        top[c0], top[c1], bottom[c0], bottom[c1], rows.weights[i], wy);
+                }
+                span = rows.gathered.data();
+            }
+            else if (identityX)
+            {
+                span = srcRow + (clipX0 - destX);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < spanLen; ++i)
+                    rows.gathered[i] = srcRow[rows.columns[i]];
+                span = rows.gathered.data();
+            }
+
+            // Alpha is the high byte in both formats, so opacity is format-agnostic.
+            if (mode == BlendMode::Copy || pixel::is_opaque(span, spanLen))
+            {
+                detail::to_argb(span, dst, spanLen, source.format);
+                continue;
+            }
+
+            detail::to_argb(span, rows.shaded.data(), spanLen, source.format);
+            pixel::premultiply_alpha(rows.shaded.data(), rows.shaded.data(), spanLen);
+            pixel::blend_over(rows.shaded.data(), dst, spanLen);
+        }
+    }
+} // namespace almondnamespace::anativecontext::blit
+
+#else
+export namespace almondnamespace::anativecontext::blit {}
+#endif // ALMOND_USING_SOFTWARE_RENDERER
@@ -0,0 +1,311 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondEngine - Modular C++ Game Engine                   *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for non-commercial purposes only           *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution allowed with this notice.                 *
+ *   No obligation to disclose modifications.                 *
+ *   See LICENSE file for full terms.                         *
+ **************************************************************/
+ //
+ // acontext.softrenderer.capture.ixx
+ // SoftRenderer - frame capture + offscreen frame streaming
+ //
+ // Every presented software frame is offered to an optional capture callback
+ // as a span over the live framebuffer (no copy; valid only for the call).
+ // A FrameStreamWriter can additionally stream frames to PPM or raw ARGB32
+ // files from a background thread, using a small pool of recycled buffers
+ // so the render thread only pays for one memcpy per captured frame.
+ //
+
+module;
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+export module acontext.softrenderer.capture;
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+
+import <atomic>;
+import <condition_variable>;
+import <cstdint>;
+import <cstdio>;
+import <cstring>;
+import <deque>;
+import <filesystem>;
+import <fstream>;
+import <functional>;
+import <iostream>;
+import <memory>;
+import <mutex>;
+import <span>;
+import <string>;
+import <system_error>;
+import <thread>;
+import <utility>;
+import <vector>;
+
+export namespace almondnamespace::anativecontext::capture
+{
+    struct CapturedFrame
+    {
+        std::span<const std::uint32_t> pixels{}; // packed 0xAARRGGBB, stride == width
+        int width = 0;
+        int height = 0;
+        std::uint64_t frameIndex = 0;
+    };
+
+    using FrameCaptureCallback = std::function<void(const CapturedFrame&)>;
+
+    enum class StreamFormat : std::uint8_t
+    {
+        PPM,   // binary P6, alpha dropped
+        Raw    // little-endian ARGB32 dump, dimensions in the file name
+    };
+
+    struct StreamOptions
+    {
+        std::filesystem::path directory = "captures";
+        StreamFormat format = StreamFormat::PPM;
+        std::size_t maxQueuedFrames = 4;
+        bool dropWhenFull = false;   // true for throughput runs; false blocks instead of losing frames
+        std::uint32_t everyNthFrame = 1;
+    };
+
+    class FrameStreamWriter
+    {
+    public:
+        explicit FrameStreamWriter(StreamOptions options)
+            : options_(std::move(options))
+        {
+            if (options_.maxQueuedFrames == 0)
+                options_.maxQueuedFrames = 1;
+            if (options_.everyNthFrame == 0)
+                options_.everyNthFrame = 1;
+
+            std::error_code ec{};
+            std::filesystem::create_directories(options_.directory, ec);
+            if (ec)
+                std::cerr << "[SoftCapture] Cannot create '" << options_.directory.string() << "': " << ec.message() << "\n";
+
+            worker_ = std::thread(&FrameStreamWriter::run, this);
+        }
+
+        ~FrameStreamWriter()
+        {
+            {
+                std::scoped_lock lock(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            space_.notify_all();
+            if (worker_.joinable())
+                worker_.join();
+        }
+
+        FrameStreamWriter(const FrameStreamWriter&) = delete;
+        FrameStreamWriter& operator=(const FrameStreamWriter&) = delete;
+
+        // Copies the frame into a pooled buffer and queues it. Returns false
+        // when the frame was skipped or dropped.
+        bool submit(const CapturedFrame& frame)
+        {
+            if (frame.pixels.empty() || frame.frameIndex % options_.everyNthFrame != 0)
+                return false;
+
+            std::unique_lock lock(mutex_);
+            if (pending_.size() >= options_.maxQueuedFrames)
+            {
+                if (options_.dropWhenFull)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                space_.wait(lock, [&] { return pending_.size() < options_.maxQueuedFrames || stopping_; });
+                if (stopping_)
+                    return false;
+            }
+
+            Job job{};
+            if (!pool_.empty())
+            {
+                job.pixels = std::move(pool_.back());
+                pool_.pop_back();
+            }
+            job.pixels.assign(frame.pixels.begin(), frame.pixels.end());
+            job.width = frame.width;
+            job.height = frame.height;
+            job.frameIndex = frame.frameIndex;
+
+            pending_.push_back(std::move(job));
+            lock.unlock();
+            wake_.notify_one();
+            return true;
+        }
+
+        [[nodiscard]] std::uint64_t written() const noexcept { return written_.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Job
+        {
+            std::vector<std::uint32_t> pixels{};
+            int width = 0;
+            int height = 0;
+            std::uint64_t frameIndex = 0;
+        };
+
+        void run()
+        {
+            std::vector<std::uint8_t> row{};
+            for (;;)
+            {
+                Job job{};
+                {
+                    std::unique_lock lock(mutex_);
+                    wake_.wait(lock, [&] { return !pending_.empty() || stopping_; });
+                    if (pending_.empty())
+                        return; // stopping and drained
+                    job = std::move(pending_.front());
+                    pending_.pop_front();
+                }
+                space_.notify_one();
+
+                if (write(job, row))
+                    written_.fetch_add(1, std::memory_order_relaxed);
+
+                std::scoped_lock lock(mutex_);
+                pool_.push_back(std::move(job.pixels));
+            }
+        }
+
+        bool write(const Job& job, std::vector<std::uint8_t>& row) const
+        {
+            char name[96]{};
+            if (options_.format == StreamFormat::PPM)
+                std::snprintf(name, sizeof(name), "frame_%06llu.ppm", static_cast<unsigned long long>(job.frameIndex));
+            else
+                std::snprintf(name, sizeof(name), "frame_%06llu_%dx%d.argb",
+                    static_cast<unsigned long long>(job.frameIndex), job.width, job.height);
+
+            const auto path = options_.directory / name;
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                std::cerr << "[SoftCapture] Cannot write '" << path.string() << "'\n";
+                return false;
+            }
+
+            if (options_.format == StreamFormat::Raw)
+            {
+                out.write(reinterpret_cast<const char*>(job.pixels.data()),
+                    static_cast<std::streamsize>(job.pixels.size() * sizeof(std::uint32_t)));
+                return static_cast<bool>(out);
+            }
+
+            out << "P6\n" << job.width << ' ' << job.height << "\n255\n";
+            row.resize(std::size_t(job.width) * 3u);
+            for (int y = 0; y < job.height; ++y)
+            {
+                const std::uint32_t* src = job.pixels.data() + std::size_t(y) * std::size_t(job.width);
+                for (int x = 0; x < job.width; ++x)
+                {
+                    row[std::size_t(x) * 3 + 0] = static_cast<std::uint8_t>(src[x] >> 16);
+                    row[std::size_t(x) * 3 + 1] = static_cast<std::uint8_t>(src[x] >> 8);
+                    row[std::size_t(x) * 3 + 2] = static_cast<std::uint8_t>(src[x]);
+                }
+                out.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+            }
+            return static_cast<bool>(out);
+        }
+
+        StreamOptions options_{};
+        std::mutex mutex_{};
+        std::condition_variable wake_{};
+        std::condition_variable space_{};
+        std::deque<Job> pending_{};
+        std::vector<std::vector<std::uint32_t>> pool_{};
+        bool stopping_ = false;
+        std::atomic<std::uint64_t> written_{ 0 };
+        std::atomic<std::uint64_t> dropped_{ 0 };
+        std::thread worker_{};
+    };
+
+    namespace detail
+    {
+        inline std::mutex g_captureMutex{};
+        inline FrameCaptureCallback g_callback{};
+        inline std::unique_ptr<FrameStreamWriter> g_stream{};
+        inline std::atomic<bool> g_active{ false };
+
+        inline void refresh_active_locked() noexcept
+        {
+            g_active.store(static_cast<bool>(g_callback) || static_cast<bool>(g_stream), std::memory_order_release);
+        }
+    } // namespace detail
+
+    // Installs (or clears, with an empty function) the per-frame capture callback.
+    inline void set_frame_capture_callback(FrameCaptureCallback callback)
+    {
+        std::scoped_lock lock(detail::g_captureMutex);
+        detail::g_callback = std::move(callback);
+        detail::refresh_active_locked();
+    }
+
+    inline void start_frame_stream(StreamOptions options)
+    {
+        auto writer = std::make_unique<FrameStreamWriter>(std::move(options));
+        std::unique_ptr<FrameStreamWriter> previous{};
+        {
+            std::scoped_lock lock(detail::g_captureMutex);
+            previous = std::exchange(detail::g_stream, std::move(writer));
+            detail::refresh_active_locked();
+        }
+        // previous (if any) drains and joins outside the lock
+    }
+
+    // Flushes queued frames and joins the writer thread.
+    inline void stop_frame_stream()
+    {
+        std::unique_ptr<FrameStreamWriter> previous{};
+        {
+            std::scoped_lock lock(detail::g_captureMutex);
+            previous = std::move(detail::g_stream);
+            detail::refresh_active_locked();
+        }
+        if (previous)
+        {
+            std::cout << "[SoftCapture] Stream stopped: " << previous->written() << " written, "
+                << previous->dropped() << " dropped\n";
+        }
+    }
+
+    // Called by the backend once per presented frame.
+    inline void publish_frame(const CapturedFrame& frame)
+    {
+        if (!detail::g_active.load(std::memory_order_acquire))
+            return;
+
+        std::scoped_lock lock(detail::g_captureMutex);
+        if (detail::g_callback)
+            detail::g_callback(frame);
+        if (detail::g_stream)
+            detail::g_stream->submit(frame);
+    }
+} // namespace almondnamespace::anativecontext::capture
+
+#else
+export namespace almondnamespace::anativecontext::capture {}
+#endif // ALMOND_USING_SOFTWARE_RENDERER
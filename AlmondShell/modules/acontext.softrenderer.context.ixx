@@ -66,6 +66,10 @@ import acontext.softrenderer.state;      // s_softrendererstate, SoftRendState
 import acontext.softrenderer.textures;   // Texture, TexturePtr (as in your project)
 import acontext.softrenderer.renderer;   // SoftwareRenderer (as in your project)
 import aatlas.manager;                  // atlasmanager::atlas_vector (as in your header)
+import acontext.softrenderer.blit;      // blit::blit_scaled
+import acontext.softrenderer.sampler;   // sampler::Filter
+import acontext.softrenderer.capture;   // capture::publish_frame
+import acontext.softrenderer.x11present; // x11present::present (Linux)
 import aengine.diagnostics;
 import aengine.telemetry;
 
@@ -76,6 +80,7 @@ namespace almondnamespace::anativecontext
     // These stay module-internal; nobody else should poke them directly.
     inline TexturePtr       cubeTexture{};
     inline SoftwareRenderer renderer{};
+    inline AtlasTextureCache atlasTextures{}; // ARGB mirrors read by sprite/quad blits
 
 #if defined(_WIN32)
     // --- Optional accessors for HWND/HDC without assuming member names exist ---
@@ -131,15 +136,22 @@ export namespace almondnamespace::anativecontext
         }
     }
 
+    // Requests offscreen rendering for the next initialize: no window is
+    // needed and frames are only delivered through acontext.softrenderer.capture.
+    inline bool g_headlessRequested = false;
+
+    void softrenderer_set_headless(bool headless) noexcept
+    {
+        g_headlessRequested = headless;
+    }
+
     void softrenderer_resize(int width, int height)
     {
         auto& sr = s_softrendererstate;
         sr.width = (std::max)(1, width);
         sr.height = (std::max)(1, height);
 
-        sr.framebuffer.assign(
-            std::size_t(sr.width) * std::size_t(sr.height),
-            0xFF000000u);
+        sr.frame.resize(sr.width, sr.height);
 
 #if defined(_WIN32)
         sr.bmi.bmiHeader.biWidth = sr.width;
@@ -169,6 +181,7 @@ export namespace almondnamespace::anativecontext
         sr.width = static_cast<int>(w);
         sr.height = static_cast<int>(h);
         sr.running = true;
+        sr.presentedFrames = 0;
 
         ctx->get_width = get_width;
         ctx->get_height = get_height;
@@ -187,7 +200,7 @@ export namespace almondnamespace::anativecontext
         sr.onResize = ctx->onResize;
 
         // Allocate framebuffer
-        sr.framebuffer.assign(std::size_t(w) * std::size_t(h), 0xFF000000u);
+        sr.frame.resize(sr.width, sr.height);
 
 #if defined(_WIN32)
         // Prefer explicit parentWnd from multiplexer; fall back to accessor if it exists.
@@ -195,7 +208,12 @@ export namespace almondnamespace::anativecontext
         if (!resolvedParent)
             resolvedParent = try_get_hwnd(*ctx);
 
-        if (!resolvedParent)
+        sr.headless = g_headlessRequested;
+        if (sr.headless)
+        {
+            std::cout << "[SoftRenderer] Initialized headless " << sr.width << "x" << sr.height << "\n";
+        }
+        else if (!resolvedParent)
         {
             std::cerr << "[SoftRenderer] No parent HWND available. Pass parentWnd from multiplexer.\n";
             return false;
@@ -213,11 +231,20 @@ export namespace almondnamespace::anativecontext
         sr.bmi.bmiHeader.biBitCount = 32;
         sr.bmi.bmiHeader.biCompression = BI_RGB;
 
-        std::cout << "[SoftRenderer] Initialized. HWND=" << sr.hwnd
-            << " (" << sr.width << "x" << sr.height << ")\n";
+        if (!sr.headless)
+        {
+            std::cout << "[SoftRenderer] Initialized. HWND=" << sr.hwnd
+                << " (" << sr.width << "x" << sr.height << ")\n";
+        }
 #else
         (void)parentWnd;
-        std::cout << "[SoftRenderer] Initialized (non-Win32) "
+#if defined(__linux__)
+        // Presentation targets ctx->hwnd / hdc (X window / Display*) each frame.
+        sr.headless = g_headlessRequested;
+#else
+        sr.headless = true;
+#endif
+        std::cout << "[SoftRenderer] Initialized " << (sr.headless ? "headless " : "")
             << sr.width << "x" << sr.height << "\n";
 #endif
 
@@ -245,43 +272,20 @@ export namespace almondnamespace::anativecontext
         const auto* atlas = atlasmanager::atlas_vector.back();
         if (!atlas) return;
 
-        const int w = atlas->width;
-        const int h = atlas->height;
-        if (w <= 0 || h <= 0) return;
-
-        const std::size_t expected = std::size_t(w) * std::size_t(h) * 4u;
-        if (atlas->pixel_data.size() < expected) return;
+        const Texture* tex = atlasTextures.acquire(*atlas);
+        if (!tex) return;
 
         const int dstW = (std::max)(1, softstate.width);
         const int dstH = (std::max)(1, softstate.height);
+        if (softstate.frame.color.size() < std::size_t(dstW) * std::size_t(dstH)) return;
 
-        for (int y = 0; y < softstate.height; ++y)
-        {
-            const int texY = std::clamp((y * h) / dstH, 0, h - 1);
+        const blit::BlitSource source{
+            tex->pixels.data(), tex->width, 0, 0, tex->width, tex->height, blit::SourceFormat::ARGB32 };
 
-            for (int x = 0; x < softstate.width; ++x)
-            {
-                const int texX = std::clamp((x * w) / dstW, 0, w - 1);
-
-                const std::size_t src = (std::size_t(texY) * std::size_t(w) + std::size_t(texX)) * 4u;
-                const std::uint8_t r = atlas->pixel_data[src + 0];
-                const std::uint8_t g = atlas->pixel_data[src + 1];
-                const std::uint8_t b = atlas->pixel_data[src + 2];
-                const std::uint8_t a = atlas->pixel_data[src + 3];
-
-                // If you want straight blit ignoring alpha, force a=255.
-                const std::uint32_t packed =
-                    (std::uint32_t(a) << 24) |
-                    (std::uint32_t(r) << 16) |
-                    (std::uint32_t(g) << 8) |
-                    (std::uint32_t(b) << 0);
-
-                softstate.framebuffer[std::size_t(y) * std::size_t(softstate.width) + std::size_t(x)] = packed;
-            }
-        }
+        blit::blit_scaled({ softstate.frame.color.data(), dstW, dstH }, source,
+            0, 0, dstW, dstH, blit::BlendMode::Copy);
     }
 
-
     inline void draw_sprite(
         SpriteHandle handle,
         std::span<const TextureAtlas* const> atlases,
@@ -309,7 +313,7 @@ export namespace almondnamespace::anativecontext
             const_cast<TextureAtlas*>(atlas)->rebuild_pixels();
 
         auto& sr = s_softrendererstate;
-        if (sr.framebuffer.empty() || sr.width <= 0 || sr.height <= 0)
+        if (sr.frame.color.empty() || sr.width <= 0 || sr.height <= 0)
             return;
 
         // Normalize coords if caller uses 0..1
@@ -340,71 +344,28 @@ export namespace almondnamespace::anativecontext
         const int destW = (std::max)(1, static_cast<int>(std::lround(drawW)));
         const int destH = (std::max)(1, static_cast<int>(std::lround(drawH)));
 
-        const int clipX0 = (std::max)(0, destX);
-        const int clipY0 = (std::max)(0, destY);
-        const int clipX1 = (std::min)(sr.width, destX + destW);
-        const int clipY1 = (std::min)(sr.height, destY + destH);
-        if (clipX0 >= clipX1 || clipY0 >= clipY1)
-            return;
-
-        const int srcW = static_cast<int>((std::max)(1u, region.width));
-        const int srcH = static_cast<int>((std::max)(1u, region.height));
-
-        const float invDestW = 1.0f / static_cast<float>(destW);
-        const float invDestH = 1.0f / static_cast<float>(destH);
-
-        // atlas->pixel_data is byte RGBA, matching softrenderer_draw_quad().
-        for (int py = clipY0; py < clipY1; ++py)
+        // Validate the region once instead of per pixel.
+        if (region.width == 0 || region.height == 0
+            || std::uint64_t(region.x) + region.width > std::uint64_t(atlas->width)
+            || std::uint64_t(region.y) + region.height > std::uint64_t(atlas->height))
         {
-            const float v = (py - destY) * invDestH;
-            const int sampleY = std::clamp(static_cast<int>(std::floor(v * srcH)), 0, srcH - 1);
-
-            for (int px = clipX0; px < clipX1; ++px)
-            {
-                const float u = (px - destX) * invDestW;
-                const int sampleX = std::clamp(static_cast<int>(std::floor(u * srcW)), 0, srcW - 1);
-
-                const int atlasX = static_cast<int>(region.x) + sampleX;
-                const int atlasY = static_cast<int>(region.y) + sampleY;
-
-                // bounds (no signed/unsigned mismatch)
-                if (static_cast<unsigned>(atlasX) >= static_cast<unsigned>(atlas->width) ||
-                    static_cast<unsigned>(atlasY) >= static_cast<unsigned>(atlas->height))
-                    continue;
-
-                const size_t srcIndex =
-                    (static_cast<size_t>(atlasY) * static_cast<size_t>(atlas->width) + static_cast<size_t>(atlasX)) * 4u;
-
-                if (srcIndex + 3u >= static_cast<size_t>(atlas->pixel_data.size()))
-                    continue;
-
-                const uint8_t srcR = atlas->pixel_data[srcIndex + 0];
-                const uint8_t srcG = atlas->pixel_data[srcIndex + 1];
-                const uint8_t srcB = atlas->pixel_data[srcIndex + 2];
-                const uint8_t srcA = atlas->pixel_data[srcIndex + 3];
-                if (srcA == 0)
-                    continue;
-
-                const size_t dstIndex =
-                    static_cast<size_t>(py) * static_cast<size_t>(sr.width) + static_cast<size_t>(px);
-
-                const uint32_t dst = sr.framebuffer[dstIndex];
-
-                const float a = static_cast<float>(srcA) / 255.0f;
-                const float ia = 1.0f - a;
+            return;
+        }
 
-                const uint8_t dstR = static_cast<uint8_t>((dst >> 16) & 0xFF);
-                const uint8_t dstG = static_cast<uint8_t>((dst >> 8) & 0xFF);
-                const uint8_t dstB = static_cast<uint8_t>(dst & 0xFF);
+        // Native-format mirror; only regions the atlas marked dirty get re-swizzled.
+        const Texture* tex = atlasTextures.acquire(*atlas);
+        if (!tex)
+            return;
 
-                const uint8_t outR = static_cast<uint8_t>(srcR * a + dstR * ia + 0.5f);
-                const uint8_t outG = static_cast<uint8_t>(srcG * a + dstG * ia + 0.5f);
-                const uint8_t outB = static_cast<uint8_t>(srcB * a + dstB * ia + 0.5f);
+        const blit::BlitSource source{
+            tex->pixels.data(), tex->width,
+            static_cast<int>(region.x), static_cast<int>(region.y),
+            static_cast<int>(region.width), static_cast<int>(region.height),
+            blit::SourceFormat::ARGB32 };
 
-                sr.framebuffer[dstIndex] =
-                    (0xFFu << 24) | (uint32_t(outR) << 16) | (uint32_t(outG) << 8) | uint32_t(outB);
-            }
-        }
+        // Bilinear, like the GPU backends' linear atlas samplers.
+        blit::blit_scaled({ sr.frame.color.data(), sr.width, sr.height }, source,
+            destX, destY, destW, destH, blit::BlendMode::AlphaOver, sampler::Filter::Bilinear);
     }
 
 
@@ -433,7 +394,8 @@ export namespace almondnamespace::anativecontext
             | (std::uint32_t(clearR) << 16)
             | (std::uint32_t(clearG) << 8)
             | std::uint32_t(clearB);
-        std::fill(sr.framebuffer.begin(), sr.framebuffer.end(), packedColor);
+        sr.frame.clear_color(packedColor);
+        sr.frame.invalidate_depth();
 
         telemetry::emit_gauge(
             "renderer.framebuffer.size",
@@ -445,7 +407,7 @@ export namespace almondnamespace::anativecontext
             telemetry::RendererTelemetryTags{ ctx.type, windowId, "height" });
         telemetry::emit_gauge(
             "renderer.framebuffer.size",
-            static_cast<std::int64_t>(sr.framebuffer.size()),
+            static_cast<std::int64_t>(sr.frame.color.size()),
             telemetry::RendererTelemetryTags{ ctx.type, windowId, "buffer_length" });
 
         // debug fullscreen atlas blit
@@ -466,7 +428,17 @@ export namespace almondnamespace::anativecontext
         }
         queue.drain();
 
+        // Capture sees the finished frame in place, before any window present.
+        capture::publish_frame({ sr.frame.color, sr.frame.width, sr.frame.height, sr.presentedFrames });
+        ++sr.presentedFrames;
+
 #if defined(_WIN32)
+        if (sr.headless)
+        {
+            frameTimer.finish();
+            return true;
+        }
+
         // Present
         // Prefer HDC accessor if it exists; otherwise use GetDC on the stored HWND.
         HDC hdc = try_get_hdc(ctx);
@@ -484,7 +456,7 @@ export namespace almondnamespace::anativecontext
                 hdc,
                 0, 0, sr.width, sr.height,
                 0, 0, sr.width, sr.height,
-                sr.framebuffer.data(),
+                sr.frame.color.data(),
                 &sr.bmi,
                 DIB_RGB_COLORS,
                 SRCCOPY);
@@ -492,6 +464,14 @@ export namespace almondnamespace::anativecontext
             if (tempDC && sr.hwnd)
                 ReleaseDC(sr.hwnd, hdc);
         }
+#elif defined(__linux__)
+        // The X11 multiplexer stores the Display* in hdc and the X window in hwnd.
+        if (!sr.headless && ctx.hdc && ctx.hwnd)
+        {
+            x11present::present(reinterpret_cast<void*>(ctx.hdc),
+                reinterpret_cast<std::uintptr_t>(ctx.hwnd),
+                sr.frame.color.data(), sr.frame.width, sr.frame.height);
+        }
 #endif
 
         frameTimer.finish();
@@ -502,12 +482,17 @@ export namespace almondnamespace::anativecontext
     {
         auto& sr = s_softrendererstate;
 
-        sr.framebuffer.clear();
+        sr.frame.release();
         cubeTexture.reset();
+        atlasTextures.clear();
 
         // DO NOT DestroyWindow here. This backend does not own the window.
+#if defined(_WIN32)
         sr.hwnd = nullptr;
         sr.parent = nullptr;
+#elif defined(__linux__)
+        x11present::shutdown();
+#endif
         sr.running = false;
 
         sr = {}; // reset remaining fields
@@ -23,6 +23,8 @@ import <algorithm>;
 import <cstdint>;
 import <cstring>;
 
+import apixel.convert;                 // pixel::rgba8_to_argb32
+import acontext.softrenderer.blit;     // blit::blit_scaled
 import acontext.softrenderer.textures; // BackendData, Texture, TexturePtr, create_texture
 import aatlas.manager;                 // atlasmanager::atlas_vector (and atlas types)
 import aatlas.texture;                 // TextureAtlas
@@ -51,19 +53,8 @@ export namespace almondnamespace::anativecontext
         if (tex.width != atlas.width || tex.height != atlas.height) return;
         if (tex.pixels.size() < pixelCount) return;
 
-        for (std::size_t i = 0; i < pixelCount; ++i)
-        {
-            const std::uint8_t r = src[i * 4 + 0];
-            const std::uint8_t g = src[i * 4 + 1];
-            const std::uint8_t b = src[i * 4 + 2];
-            const std::uint8_t a = src[i * 4 + 3];
-
-            tex.pixels[i] =
-                (std::uint32_t(a) << 24) |
-                (std::uint32_t(r) << 16) |
-                (std::uint32_t(g) << 8) |
-                (std::uint32_t(b) << 0);
-        }
+        pixel::rgba8_to_argb32(src, tex.pixels.data(), pixelCount);
+        tex.mark_dirty();
     }
 
     // Draw a textured quad into the software framebuffer.
@@ -72,32 +63,14 @@ export namespace almondnamespace::anativecontext
         const Texture& tex,
         int dstX, int dstY, int dstW, int dstH)
     {
-        if (backend.srState.framebuffer.empty()) return;
+        if (backend.srState.frame.color.empty()) return;
         if (tex.width <= 0 || tex.height <= 0) return;
         if (dstW <= 0 || dstH <= 0) return;
 
-        const int fbW = backend.srState.width;
-        const int fbH = backend.srState.height;
-
-        // Integer mapping avoids the “u==1.0 => src==width” OOB.
-        for (int y = 0; y < dstH; ++y)
-        {
-            const int fbY = dstY + y;
-            if (fbY < 0 || fbY >= fbH) continue;
-
-            const int srcY = clamp_int((y * tex.height) / dstH, 0, tex.height - 1);
-
-            for (int x = 0; x < dstW; ++x)
-            {
-                const int fbX = dstX + x;
-                if (fbX < 0 || fbX >= fbW) continue;
-
-                const int srcX = clamp_int((x * tex.width) / dstW, 0, tex.width - 1);
-
-                const std::uint32_t src = tex.sample(srcX, srcY);
-                backend.srState.framebuffer[fbY * fbW + fbX] = src;
-            }
-        }
+        auto& frame = backend.srState.frame;
+        blit::blit_scaled({ frame.color.data(), frame.width, frame.height },
+            { tex.pixels.data(), tex.width, 0, 0, tex.width, tex.height, blit::SourceFormat::ARGB32 },
+            dstX, dstY, dstW, dstH, blit::BlendMode::Copy, tex.filter);
     }
 
     // High-level entry: blit first atlas onto framebuffer.
@@ -108,30 +81,8 @@ export namespace almondnamespace::anativecontext
         const auto* atlas = atlasmanager::atlas_vector[0];
         if (!atlas) return;
 
-        // Ensure pixels exist and are RGBA8-sized.
-        {
-            const auto expected = std::size_t(atlas->width) * std::size_t(atlas->height) * 4u;
-            if (atlas->pixel_data.size() != expected)
-            {
-                // If your atlas type supports rebuild_pixels(), do it:
-                // const_cast<TextureAtlas*>(atlas)->rebuild_pixels();
-                // (Leaving commented because I can’t assume mutability here.)
-            }
-        }
-
-        auto it = backend.textures.find(atlas);
-        if (it == backend.textures.end())
-        {
-            auto tex = create_texture(atlas->width, atlas->height);
-
-            // Convert RGBA8 atlas bytes -> packed software texture pixels.
-            upload_rgba8_to_software_texture(*tex, *atlas);
-
-            backend.textures[atlas] = tex;
-            it = backend.textures.find(atlas);
-        }
-
-        TexturePtr tex = it->second;
+        // Converted once, then refreshed from the atlas's dirty regions.
+        const Texture* tex = backend.textures.acquire(*atlas);
         if (!tex) return;
 
         draw_textured_quad(backend, *tex, 0, 0, backend.srState.width, backend.srState.height);
@@ -0,0 +1,497 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondEngine - Modular C++ Game Engine                   *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for non-commercial purposes only           *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution allowed with this notice.                 *
+ *   No obligation to disclose modifications.                 *
+ *   See LICENSE file for full terms.                         *
+ **************************************************************/
+ //
+ // acontext.softrenderer.raster.ixx
+ // SoftRenderer - binned tile rasterizer
+ //
+ // Triangles are set up once (barycentric + perspective planes), binned into
+ // kTileSize x kTileSize screen tiles with a hierarchical reject/accept test,
+ // and the non-empty tiles are rasterized in parallel on a shared task graph.
+ // Inside a tile, edge and attribute planes are stepped incrementally four
+ // pixels at a time (SSE2) with a scalar tail. Triangles keep submission order
+ // per tile, so results match a serial rasterizer. Textured triangles pick a
+ // mip level per row from the analytic UV derivatives and sample it through
+ // acontext.softrenderer.sampler. Coverage follows the top-left fill rule, so
+ // meshes sharing an edge draw each pixel on it once.
+ //
+
+module;
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ALMOND_RASTER_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+export module acontext.softrenderer.raster;
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+
+import <algorithm>;
+import <cmath>;
+import <cstdint>;
+import <functional>;
+import <memory>;
+import <mutex>;
+import <span>;
+import <thread>;
+import <utility>;
+import <vector>;
+
+import aengine.systems;                  // Task
+import aengine.taskgraph.dotsystem;      // taskgraph::TaskGraph
+import acontext.softrenderer.state;      // SoftFrameResources, kFrameTileSize
+import acontext.softrenderer.textures;   // Texture
+import acontext.softrenderer.sampler;    // sampler::MipChain, sampler::sample
+
+export namespace almondnamespace::anativecontext::raster
+{
+    inline constexpr int kTileSize = kFrameTileSize;
+
+    // Colour + depth surfaces the rasterizer writes into. Depth stores 1/z:
+    // larger is nearer, and a cleared buffer holds 0.
+    struct RasterTarget
+    {
+        std::uint32_t* color = nullptr;
+        float* depth = nullptr;
+        int width = 0;
+        int height = 0;
+        SoftFrameResources* lazyDepth = nullptr; // when set, tiles clear stale depth on first touch
+
+        [[nodiscard]] static RasterTarget from(SoftFrameResources& frame) noexcept
+        {
+            return { frame.color.data(), frame.depth.data(), frame.width, frame.height, &frame };
+        }
+    };
+
+    // Pixel-space triangle with per-vertex perspective terms.
+    struct ScreenTriangle
+    {
+        float x[3]{};
+        float y[3]{};
+        float invZ[3]{};
+        float uOverZ[3]{};
+        float vOverZ[3]{};
+        const Texture* tex = nullptr;
+        std::uint32_t color = 0xFFFFFFFFu;
+    };
+
+    namespace detail
+    {
+        // f(x, y) = a*x + b*y + c
+        struct Plane
+        {
+            float a = 0.0f, b = 0.0f, c = 0.0f;
+
+            [[nodiscard]] float at(float x, float y) const noexcept { return a * x + b * y + c; }
+
+            [[nodiscard]] float max_over(float x0, float y0, float x1, float y1) const noexcept
+            {
+                return c + (std::max)(a * x0, a * x1) + (std::max)(b * y0, b * y1);
+            }
+
+            [[nodiscard]] float min_over(float x0, float y0, float x1, float y1) const noexcept
+            {
+                return c + (std::min)(a * x0, a * x1) + (std::min)(b * y0, b * y1);
+            }
+        };
+
+        struct TriSetup
+        {
+            Plane edge[3]{};   // barycentric weights plus fill-rule bias; inside when all are >= 0
+            Plane invZ{};
+            Plane uOverZ{};
+            Plane vOverZ{};
+            int minX = 0, minY = 0, maxX = -1, maxY = -1; // inclusive, clipped to target
+            std::shared_ptr<const sampler::MipChain> mips{};
+            sampler::Filter filter = sampler::Filter::Nearest;
+            std::uint32_t color = 0xFFFFFFFFu;
+        };
+
+        // Distance, in pixels, by which the fill rule moves each edge.
+        inline constexpr float kEdgeBias = 1.0f / 512.0f;
+
+        struct BinEntry
+        {
+            std::uint32_t tri = 0;
+            bool fullyCovered = false;
+        };
+
+        // Barycentric planes are edge functions divided by the signed area,
+        // so either winding yields weights that are positive inside.
+        [[nodiscard]] inline bool setup_triangle(const ScreenTriangle& t, int width, int height, TriSetup& out)
+        {
+            const float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+            if (!(std::fabs(area) >= 1e-6f))
+                return false;
+
+            const float invArea = 1.0f / area;
+            for (int i = 0; i < 3; ++i)
+            {
+                const int j = (i + 1) % 3;
+                const int k = (i + 2) % 3;
+                // Weight of vertex i: edge j->k evaluated at p.
+                out.edge[i].a = (t.y[j] - t.y[k]) * invArea;
+                out.edge[i].b = (t.x[k] - t.x[j]) * invArea;
+                out.edge[i].c = (t.x[j] * t.y[k] - t.x[k] * t.y[j]) * invArea;
+            }
+
+            auto interpolate = [&](const float (&v)[3])
+                {
+                    Plane p{};
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        p.a += out.edge[i].a * v[i];
+                        p.b += out.edge[i].b * v[i];
+                        p.c += out.edge[i].c * v[i];
+                    }
+                    return p;
+                };
+
+            out.invZ = interpolate(t.invZ);
+            out.uOverZ = interpolate(t.uOverZ);
+            out.vOverZ = interpolate(t.vOverZ);
+
+            // Top-left rule. Weights grow inward, so a left edge has a > 0 and
+            // a top edge (y down) has a == 0, b > 0. Those edges move out and
+            // the rest move in by kEdgeBias, so a pixel centre lying on an edge
+            // shared by two triangles passes exactly one of the >= 0 tests.
+            for (auto& e : out.edge)
+            {
+                const bool topLeft = e.a > 0.0f || (e.a == 0.0f && e.b > 0.0f);
+                const float bias = kEdgeBias * (std::fabs(e.a) + std::fabs(e.b));
+                e.c += topLeft ? bias : -bias;
+            }
+
+            out.minX = (std::max)(0, int(std::floor((std::min)({ t.x[0], t.x[1], t.x[2] }))));
+            out.maxX = (std::min)(width - 1, int(std::ceil((std::max)({ t.x[0], t.x[1], t.x[2] }))));
+            out.minY = (std::max)(0, int(std::floor((std::min)({ t.y[0], t.y[1], t.y[2] }))));
+            out.maxY = (std::min)(height - 1, int(std::ceil((std::max)({ t.y[0], t.y[1], t.y[2] }))));
+
+            out.mips.reset();
+            if (t.tex && t.tex->width > 0 && t.tex->height > 0)
+            {
+                out.mips = t.tex->mip_chain();
+                out.filter = t.tex->filter;
+            }
+            out.color = t.color;
+            return out.minX <= out.maxX && out.minY <= out.maxY;
+        }
+
+        // Mip level for the pixel at (px, py): u = U/Q has du/dx = (U.a - u*Q.a) / Q.
+        [[nodiscard]] inline const sampler::MipLevel& level_at(const TriSetup& s, float px, float py) noexcept
+        {
+            const sampler::MipChain& mips = *s.mips;
+            if (mips.levels.size() == 1)
+                return mips.levels.front();
+
+            const float q = s.invZ.at(px, py);
+            if (!(q > 0.0f))
+                return mips.levels.front();
+
+            const float invQ = 1.0f / q;
+            const float u = s.uOverZ.at(px, py) * invQ;
+            const float v = s.vOverZ.at(px, py) * invQ;
+            const float lod = sampler::compute_lod(
+                (s.uOverZ.a - u * s.invZ.a) * invQ, (s.vOverZ.a - v * s.invZ.a) * invQ,
+                (s.uOverZ.b - u * s.invZ.b) * invQ, (s.vOverZ.b - v * s.invZ.b) * invQ,
+                mips.width(), mips.height());
+            return sampler::select_level(mips, lod);
+        }
+
+        inline void shade_pixel(const TriSetup& s, const sampler::MipLevel* level,
+            std::uint32_t* color, float* depth, float iz, float uoz, float voz) noexcept
+        {
+            *depth = iz;
+            if (level)
+            {
+                const float z = 1.0f / iz;
+                *color = sampler::sample(*level, uoz * z, voz * z, s.filter);
+            }
+            else
+            {
+                *color = s.color;
+            }
+        }
+
+        inline void raster_span_scalar(const TriSetup& s, const sampler::MipLevel* level, bool full,
+            int x, int xEnd, float py, std::uint32_t* crow, float* zrow) noexcept
+        {
+            float px = float(x) + 0.5f;
+            float w0 = s.edge[0].at(px, py);
+            float w1 = s.edge[1].at(px, py);
+            float w2 = s.edge[2].at(px, py);
+            float iz = s.invZ.at(px, py);
+            float uoz = s.uOverZ.at(px, py);
+            float voz = s.vOverZ.at(px, py);
+
+            for (; x <= xEnd; ++x)
+            {
+                const bool inside = full || (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f);
+                if (inside && iz > zrow[x])
+                    shade_pixel(s, level, crow + x, zrow + x, iz, uoz, voz);
+
+                w0 += s.edge[0].a; w1 += s.edge[1].a; w2 += s.edge[2].a;
+                iz += s.invZ.a; uoz += s.uOverZ.a; voz += s.vOverZ.a;
+            }
+        }
+
+#if defined(ALMOND_RASTER_SSE2)
+        // Four pixels per step; returns the first x not processed.
+        inline int raster_span_sse2(const TriSetup& s, const sampler::MipLevel* level, bool full,
+            int x, int xEnd, float py, std::uint32_t* crow, float* zrow) noexcept
+        {
+            if (xEnd - x + 1 < 4)
+                return x;
+
+            const float px = float(x) + 0.5f;
+            const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+            auto start = [&](const Plane& p) { return _mm_add_ps(_mm_set1_ps(p.at(px, py)), _mm_mul_ps(lane, _mm_set1_ps(p.a))); };
+            auto step = [](const Plane& p) { return _mm_set1_ps(p.a * 4.0f); };
+
+            __m128 w0 = start(s.edge[0]), w1 = start(s.edge[1]), w2 = start(s.edge[2]);
+            __m128 iz = start(s.invZ), uoz = start(s.uOverZ), voz = start(s.vOverZ);
+            const __m128 dw0 = step(s.edge[0]), dw1 = step(s.edge[1]), dw2 = step(s.edge[2]);
+            const __m128 diz = step(s.invZ), duoz = step(s.uOverZ), dvoz = step(s.vOverZ);
+            const __m128 zero = _mm_setzero_ps();
+
+            alignas(16) float izLanes[4], uLanes[4], vLanes[4];
+
+            for (; x + 3 <= xEnd; x += 4)
+            {
+                __m128 mask = _mm_cmpgt_ps(iz, _mm_loadu_ps(zrow + x));
+                if (!full)
+                {
+                    const __m128 inside = _mm_and_ps(_mm_cmpge_ps(w0, zero),
+                        _mm_and_ps(_mm_cmpge_ps(w1, zero), _mm_cmpge_ps(w2, zero)));
+                    mask = _mm_and_ps(mask, inside);
+                }
+
+                if (int bits = _mm_movemask_ps(mask))
+                {
+                    _mm_store_ps(izLanes, iz);
+                    _mm_store_ps(uLanes, uoz);
+                    _mm_store_ps(vLanes, voz);
+                    for (int i = 0; i < 4; ++i, bits >>= 1)
+                    {
+                        if (bits & 1)
+                            shade_pixel(s, level, crow + x + i, zrow + x + i, izLanes[i], uLanes[i], vLanes[i]);
+                    }
+                }
+
+                w0 = _mm_add_ps(w0, dw0); w1 = _mm_add_ps(w1, dw1); w2 = _mm_add_ps(w2, dw2);
+                iz = _mm_add_ps(iz, diz); uoz = _mm_add_ps(uoz, duoz); voz = _mm_add_ps(voz, dvoz);
+            }
+            return x;
+        }
+#endif
+
+        inline void raster_tile(const RasterTarget& target, std::span<const TriSetup> tris,
+            std::span<const BinEntry> bin, int tileX0, int tileY0) noexcept
+        {
+            const int tileX1 = (std::min)(tileX0 + kTileSize, target.width) - 1;
+            const int tileY1 = (std::min)(tileY0 + kTileSize, target.height) - 1;
+
+            if (target.lazyDepth)
+                target.lazyDepth->clear_depth_tile(tileX0 / kTileSize, tileY0 / kTileSize);
+
+            for (const BinEntry& entry : bin)
+            {
+                const TriSetup& s = tris[entry.tri];
+                const int x0 = (std::max)(tileX0, s.minX);
+                const int x1 = (std::min)(tileX1, s.maxX);
+                const int y0 = (std::max)(tileY0, s.minY);
+                const int y1 = (std::min)(tileY1, s.maxY);
+
+                for (int y = y0; y <= y1; ++y)
+                {
+                    const float py = float(y) + 0.5f;
+                    const sampler::MipLevel* level = s.mips
+                        ? &level_at(s, 0.5f * float(x0 + x1) + 0.5f, py)
+                        : nullptr;
+                    std::uint32_t* crow = target.color + std::size_t(y) * std::size_t(target.width);
+                    float* zrow = target.depth + std::size_t(y) * std::size_t(target.width);
+
+                    int x = x0;
+#if defined(ALMOND_RASTER_SSE2)
+                    x = raster_span_sse2(s, level, entry.fullyCovered, x, x1, py, crow, zrow);
+#endif
+                    raster_span_scalar(s, level, entry.fullyCovered, x, x1, py, crow, zrow);
+                }
+            }
+        }
+
+        inline Task run_tile_task(const std::function<void(std::size_t)>* fn, std::size_t tile)
+        {
+            (*fn)(tile);
+            co_return;
+        }
+
+        // One worker graph shared by every software context; frames are
+        // serialized through the mutex and the graph is pruned after each.
+        struct TileWorkers
+        {
+            std::mutex mutex;
+            std::unique_ptr<taskgraph::TaskGraph> graph;
+        };
+
+        inline TileWorkers& tile_workers()
+        {
+            static TileWorkers workers{};
+            return workers;
+        }
+
+        // Below this many covered tiles, the handoff costs more than it saves.
+        inline constexpr std::size_t kParallelMinTiles = 4;
+    } // namespace detail
+
+    class TileRasterizer
+    {
+    public:
+        // Starts a new batch against `target`; bin storage is reused across frames.
+        void begin(const RasterTarget& target)
+        {
+            target_ = target;
+            tilesX_ = (std::max)(0, (target.width + kTileSize - 1) / kTileSize);
+            tilesY_ = (std::max)(0, (target.height + kTileSize - 1) / kTileSize);
+
+            setups_.clear();
+            bins_.resize(std::size_t(tilesX_) * std::size_t(tilesY_));
+            for (auto& bin : bins_)
+                bin.clear();
+        }
+
+        void submit(const ScreenTriangle& tri)
+        {
+            if (!target_.color || !target_.depth)
+                return;
+
+            detail::TriSetup s{};
+            if (!detail::setup_triangle(tri, target_.width, target_.height, s))
+                return;
+
+            const auto index = static_cast<std::uint32_t>(setups_.size());
+
+            const int tx0 = s.minX / kTileSize, tx1 = s.maxX / kTileSize;
+            const int ty0 = s.minY / kTileSize, ty1 = s.maxY / kTileSize;
+            bool binned = false;
+
+            for (int ty = ty0; ty <= ty1; ++ty)
+            {
+                for (int tx = tx0; tx <= tx1; ++tx)
+                {
+                    // Pixel-centre extent of the tile clipped to the triangle bounds.
+                    const float cx0 = float((std::max)(tx * kTileSize, s.minX)) + 0.5f;
+                    const float cy0 = float((std::max)(ty * kTileSize, s.minY)) + 0.5f;
+                    const float cx1 = float((std::min)(tx * kTileSize + kTileSize - 1, s.maxX)) + 0.5f;
+                    const float cy1 = float((std::min)(ty * kTileSize + kTileSize - 1, s.maxY)) + 0.5f;
+
+                    bool rejected = false;
+                    bool covered = true;
+                    for (const auto& e : s.edge)
+                    {
+                        if (e.max_over(cx0, cy0, cx1, cy1) < 0.0f) { rejected = true; break; }
+                        covered = covered && e.min_over(cx0, cy0, cx1, cy1) >= 0.0f;
+                    }
+                    if (rejected)
+                        continue;
+
+                    bins_[std::size_t(ty) * std::size_t(tilesX_) + std::size_t(tx)].push_back({ index, covered });
+                    binned = true;
+                }
+            }
+
+            if (binned)
+                setups_.push_back(std::move(s));
+        }
+
+        // Rasterizes every binned triangle and empties the bins.
+        void flush()
+        {
+            activeTiles_.clear();
+            for (std::size_t i = 0; i < bins_.size(); ++i)
+            {
+                if (!bins_[i].empty())
+                    activeTiles_.push_back(i);
+            }
+
+            const std::function<void(std::size_t)> rasterOne = [this](std::size_t slot)
+                {
+                    const std::size_t tile = activeTiles_[slot];
+                    const int tx = int(tile % std::size_t(tilesX_));
+                    const int ty = int(tile / std::size_t(tilesX_));
+                    detail::raster_tile(target_, setups_, bins_[tile], tx * kTileSize, ty * kTileSize);
+                };
+
+            const std::size_t hw = std::thread::hardware_concurrency();
+            if (activeTiles_.size() < detail::kParallelMinTiles || hw <= 1)
+            {
+                for (std::size_t i = 0; i < activeTiles_.size(); ++i)
+                    rasterOne(i);
+            }
+            else
+            {
+                auto& workers = detail::tile_workers();
+                std::scoped_lock lock(workers.mutex);
+                if (!workers.graph)
+                    workers.graph = std::make_unique<taskgraph::TaskGraph>(hw - 1);
+
+                for (std::size_t i = 0; i < activeTiles_.size(); ++i)
+                {
+                    auto node = std::make_unique<taskgraph::Node>(detail::run_tile_task(&rasterOne, i));
+                    node->Label = "SoftRasterTile";
+                    workers.graph->AddNode(std::move(node));
+                }
+
+                workers.graph->Execute();
+                workers.graph->WaitAll();
+                workers.graph->PruneFinished();
+            }
+
+            setups_.clear();
+            for (std::size_t tile : activeTiles_)
+                bins_[tile].clear();
+        }
+
+        void draw(const RasterTarget& target, std::span<const ScreenTriangle> triangles)
+        {
+            begin(target);
+            for (const auto& tri : triangles)
+                submit(tri);
+            flush();
+        }
+
+    private:
+        RasterTarget target_{};
+        int tilesX_ = 0;
+        int tilesY_ = 0;
+        std::vector<detail::TriSetup> setups_{};
+        std::vector<std::vector<detail::BinEntry>> bins_{};
+        std::vector<std::size_t> activeTiles_{};
+    };
+} // namespace almondnamespace::anativecontext::raster
+
+#else
+export namespace almondnamespace::anativecontext::raster {}
+#endif // ALMOND_USING_SOFTWARE_RENDERER
@@ -39,19 +39,18 @@ import <algorithm>;
 import <cstdint>;
 import <cmath>;
 import <limits>;
+import <span>;
 import <vector>;
 
 // Provides TexturePtr / Texture (with sample(), width/height).
 // If your textures unit is named differently, change this import to match.
+import acontext.softrenderer.state;      // SoftFrameResources
 import acontext.softrenderer.textures;
+import acontext.softrenderer.raster;     // raster::TileRasterizer
+export import acontext.softrenderer.vertex; // Vec3, Mat4, Vertex, vertex::transform
 
 export namespace almondnamespace::anativecontext
 {
-    struct Vec3 { float x = 0.0f, y = 0.0f, z = 0.0f; };
-    struct Vec2 { float u = 0.0f, v = 0.0f; };
-    struct Mat4 { float m[4][4] = {}; };
-    export struct Vertex { Vec3 pos; Vec2 uv; };
-
     struct Triangle
     {
         Vertex v0{};
@@ -61,6 +60,16 @@ export namespace almondnamespace::anativecontext
         std::uint32_t color = 0xFFFFFFFFu;
     };
 
+    // Indexed triangle list; every three indices form one triangle.
+    struct MeshView
+    {
+        std::span<const Vertex> vertices{};
+        std::span<const std::uint32_t> indices{};
+        const Texture* texture = nullptr;
+        std::uint32_t color = 0xFFFFFFFFu;
+        std::span<const std::uint32_t> triangleColors{}; // optional, overrides color per triangle
+    };
+
     export struct Camera
     {
         Vec3 pos{ 0.0f, 0.0f, -3.0f };
@@ -69,27 +78,6 @@ export namespace almondnamespace::anativecontext
         float roll = 0.0f;
     };
 
-    struct Framebuffer
-    {
-        int width = 0;
-        int height = 0;
-        std::vector<std::uint32_t> pixels;
-
-        Framebuffer() = default;
-        Framebuffer(int w, int h) : width(w), height(h), pixels(std::size_t(w)* std::size_t(h), 0xFF101010u) {}
-
-        inline void clear(std::uint32_t color)
-        {
-            std::fill(pixels.begin(), pixels.end(), color);
-        }
-
-        inline void put_pixel(int x, int y, std::uint32_t color)
-        {
-            if (x < 0 || y < 0 || x >= width || y >= height) return;
-            pixels[std::size_t(y) * std::size_t(width) + std::size_t(x)] = color;
-        }
-    };
-
     class SoftwareRenderer
     {
     public:
@@ -157,6 +145,16 @@ export namespace almondnamespace::anativecontext
             };
         }
 
+        static Mat4 translation(const Vec3& t)
+        {
+            Mat4 m{};
+            m.m[0][0] = m.m[1][1] = m.m[2][2] = m.m[3][3] = 1.0f;
+            m.m[0][3] = t.x;
+            m.m[1][3] = t.y;
+            m.m[2][3] = t.z;
+            return m;
+        }
+
         static Mat4 transpose(const Mat4& a)
         {
             Mat4 r{};
@@ -176,148 +174,112 @@ export namespace almondnamespace::anativecontext
             {{ 1.0f, 1.0f, 1.0f},{1.0f,1.0f}}, {{-1.0f, 1.0f, 1.0f},{0.0f,1.0f}}
         };
 
-        static inline const int cubeTris[12][3] = {
-            {0,1,2},{0,2,3},{5,4,7},{5,7,6},{4,0,3},{4,3,7},
-            {1,5,6},{1,6,2},{3,2,6},{3,6,7},{4,5,1},{4,1,0}
+        static inline const std::uint32_t cubeIndices[36] = {
+            0,1,2, 0,2,3, 5,4,7, 5,7,6, 4,0,3, 4,3,7,
+            1,5,6, 1,6,2, 3,2,6, 3,6,7, 4,5,1, 4,1,0
         };
 
-        static inline const std::uint32_t faceColors[6] = {
-            0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u, 0xFFFFFF00u, 0xFFFF00FFu, 0xFF00FFFFu
+        // One colour per face, repeated for both of its triangles.
+        static inline const std::uint32_t cubeTriangleColors[12] = {
+            0xFF0000FFu, 0xFF0000FFu, 0xFF00FF00u, 0xFF00FF00u, 0xFFFF0000u, 0xFFFF0000u,
+            0xFFFFFF00u, 0xFFFFFF00u, 0xFFFF00FFu, 0xFFFF00FFu, 0xFF00FFFFu, 0xFF00FFFFu
         };
 
         // =======================
         // Rasterization
         // =======================
-        static void rasterize_triangle(Framebuffer& fb, const Triangle& tri, std::vector<float>& zbuf)
-        {
-            auto project = [&](const Vec3& v) -> Vec3
-                {
-                    constexpr float scale = 200.0f;
-                    float z = v.z + 3.0f;
-                    if (z < 0.001f) z = 0.001f;
-                    const float f = scale / z;
-                    return { v.x * f + fb.width * 0.5f, -v.y * f + fb.height * 0.5f, z };
-                };
-
-            const Vec3 v0 = tri.v0.pos;
-            const Vec3 v1 = tri.v1.pos;
-            const Vec3 v2 = tri.v2.pos;
-
-            // Backface culling
-            const Vec3 ab{ v1.x - v0.x, v1.y - v0.y, v1.z - v0.z };
-            const Vec3 ac{ v2.x - v0.x, v2.y - v0.y, v2.z - v0.z };
-            const Vec3 normal{
-                ab.y * ac.z - ab.z * ac.y,
-                ab.z * ac.x - ab.x * ac.z,
-                ab.x * ac.y - ab.y * ac.x
-            };
-            const Vec3 viewDir{ -v0.x, -v0.y, -v0.z }; // camera at origin
-            const float dot = normal.x * viewDir.x + normal.y * viewDir.y + normal.z * viewDir.z;
-            if (dot >= 0.0f) return;
-
-            const Vec3 p0 = project(v0);
-            const Vec3 p1 = project(v1);
-            const Vec3 p2 = project(v2);
-
-            const int minX = (std::max)(0, int(std::floor((std::min)({ p0.x, p1.x, p2.x }))));
-            const int maxX = (std::min)(fb.width - 1, int(std::ceil((std::max)({ p0.x, p1.x, p2.x }))));
-            const int minY = (std::max)(0, int(std::floor((std::min)({ p0.y, p1.y, p2.y }))));
-            const int maxY = (std::min)(fb.height - 1, int(std::ceil((std::max)({ p0.y, p1.y, p2.y }))));
 
-            auto edge = [](const Vec3& a, const Vec3& b, float x, float y)
-                {
-                    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
-                };
+        // Transforms `mesh` by `modelView` (object -> view space), clips, culls
+        // and rasterizes it into fb. Depth is tested against fb.depth (1/w,
+        // nearer is larger) and not reset here; callers start a new depth pass
+        // with invalidate_depth().
+        static void draw_mesh(
+            SoftFrameResources& fb,
+            const Mat4& modelView,
+            const MeshView& mesh,
+            vertex::CullMode cull = vertex::CullMode::Back)
+        {
+            const std::size_t pixelCount = fb.pixel_count();
+            if (pixelCount == 0 || fb.color.size() < pixelCount || mesh.indices.size() < 3)
+                return;
+            if (fb.depth.size() != pixelCount)
+                fb.ensure_depth();
 
-            const float area = edge(p0, p1, p2.x, p2.y);
-            if (std::fabs(area) < 1e-6f) return;
+            thread_local vertex::ClipStream clip{};
+            vertex::transform(mul(vertex::pixel_projection(fb.width, fb.height), modelView), mesh.vertices, clip);
 
-            const float iz0 = 1.0f / v0.z;
-            const float iz1 = 1.0f / v1.z;
-            const float iz2 = 1.0f / v2.z;
+            thread_local raster::TileRasterizer tiles{};
+            tiles.begin(raster::RasterTarget::from(fb));
 
-            const float u0o = tri.v0.uv.u * iz0, v0o = tri.v0.uv.v * iz0;
-            const float u1o = tri.v1.uv.u * iz1, v1o = tri.v1.uv.v * iz1;
-            const float u2o = tri.v2.uv.u * iz2, v2o = tri.v2.uv.v * iz2;
+            const auto emit = [&](const raster::ScreenTriangle& tri) { tiles.submit(tri); };
+            const std::size_t vertexCount = clip.size();
+            const std::size_t triCount = mesh.indices.size() / 3;
 
-            for (int y = minY; y <= maxY; ++y)
+            for (std::size_t t = 0; t < triCount; ++t)
             {
-                for (int x = minX; x <= maxX; ++x)
-                {
-                    const float px = float(x) + 0.5f;
-                    const float py = float(y) + 0.5f;
-
-                    const float w0 = edge(p1, p2, px, py) / area;
-                    const float w1 = edge(p2, p0, px, py) / area;
-                    const float w2 = 1.0f - w0 - w1;
-
-                    if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
-
-                    const float invZ = w0 * iz0 + w1 * iz1 + w2 * iz2;
-                    if (invZ <= 0.0f) continue;
-
-                    const float depth = 1.0f / invZ;
-                    const int idx = y * fb.width + x;
-                    if (depth >= zbuf[std::size_t(idx)]) continue;
-
-                    zbuf[std::size_t(idx)] = depth;
-
-                    const float u = (w0 * u0o + w1 * u1o + w2 * u2o) / invZ;
-                    const float v = (w0 * v0o + w1 * v1o + w2 * v2o) / invZ;
-
-                    if (tri.tex)
-                    {
-                        fb.put_pixel(
-                            x, y,
-                            tri.tex->sample(int(u * float(tri.tex->width)), int(v * float(tri.tex->height)))
-                        );
-                    }
-                    else
-                    {
-                        fb.put_pixel(x, y, tri.color);
-                    }
-                }
+                const std::uint32_t* idx = mesh.indices.data() + t * 3;
+                if (idx[0] >= vertexCount || idx[1] >= vertexCount || idx[2] >= vertexCount)
+                    continue;
+
+                const vertex::ClipVertex tri[3] = { clip.at(idx[0]), clip.at(idx[1]), clip.at(idx[2]) };
+                const std::uint32_t color = t < mesh.triangleColors.size() ? mesh.triangleColors[t] : mesh.color;
+                vertex::assemble_triangle(tri, fb.width, fb.height, cull, mesh.texture, color, emit);
             }
+
+            tiles.flush();
         }
 
-        static void render_cube(Framebuffer& fb, TexturePtr tex, float angle, const Camera& cam = Camera())
+        // Draws view-space triangles (no shared vertices) with back-face culling.
+        static void rasterize_triangles(SoftFrameResources& fb, std::span<const Triangle> tris)
         {
-            const Mat4 rx = rotationX(angle * 0.5f);
-            const Mat4 ry = rotationY(angle);
-            const Mat4 model = mul(ry, rx);
+            const std::size_t pixelCount = fb.pixel_count();
+            if (pixelCount == 0 || fb.color.size() < pixelCount)
+                return;
+            if (fb.depth.size() != pixelCount)
+                fb.ensure_depth();
 
-            const Mat4 Rc = mul(rotationZ(cam.roll), mul(rotationX(cam.pitch), rotationY(cam.yaw)));
-            const Mat4 Rview = transpose(Rc);
+            const Mat4 projection = vertex::pixel_projection(fb.width, fb.height);
 
-            struct VertOut { Vec3 viewPos; Vec2 uv; } verts[8]{};
+            thread_local raster::TileRasterizer tiles{};
+            tiles.begin(raster::RasterTarget::from(fb));
 
-            for (int i = 0; i < 8; ++i)
+            const auto emit = [&](const raster::ScreenTriangle& screen) { tiles.submit(screen); };
+            for (const Triangle& tri : tris)
             {
-                const Vec3 mpos = multiply(model, cubeVerts[i].pos);
-                const Vec3 rel{ mpos.x - cam.pos.x, mpos.y - cam.pos.y, mpos.z - cam.pos.z };
-                verts[i].viewPos = multiply(Rview, rel);
-                verts[i].uv = cubeVerts[i].uv;
+                const vertex::ClipVertex clip[3] = {
+                    vertex::transform_one(projection, tri.v0),
+                    vertex::transform_one(projection, tri.v1),
+                    vertex::transform_one(projection, tri.v2) };
+                vertex::assemble_triangle(clip, fb.width, fb.height, vertex::CullMode::Back,
+                    tri.tex.get(), tri.color, emit);
             }
 
-            std::vector<float> zbuf(std::size_t(fb.width) * std::size_t(fb.height),
-                (std::numeric_limits<float>::infinity)());
+            tiles.flush();
+        }
 
-            for (int t = 0; t < 12; ++t)
-            {
-                Triangle tri{};
-                tri.v0.pos = verts[cubeTris[t][0]].viewPos;
-                tri.v1.pos = verts[cubeTris[t][1]].viewPos;
-                tri.v2.pos = verts[cubeTris[t][2]].viewPos;
+        static void rasterize_triangle(SoftFrameResources& fb, const Triangle& tri)
+        {
+            rasterize_triangles(fb, std::span<const Triangle>(&tri, 1));
+        }
 
-                tri.v0.uv = verts[cubeTris[t][0]].uv;
-                tri.v1.uv = verts[cubeTris[t][1]].uv;
-                tri.v2.uv = verts[cubeTris[t][2]].uv;
+        static Mat4 view_matrix(const Camera& cam)
+        {
+            const Mat4 Rc = mul(rotationZ(cam.roll), mul(rotationX(cam.pitch), rotationY(cam.yaw)));
+            return mul(transpose(Rc), translation({ -cam.pos.x, -cam.pos.y, -cam.pos.z }));
+        }
+
+        static void render_cube(SoftFrameResources& fb, TexturePtr tex, float angle, const Camera& cam = Camera())
+        {
+            const Mat4 model = mul(rotationY(angle), rotationX(angle * 0.5f));
 
-                tri.tex = tex;
-                tri.color = faceColors[t / 2];
+            MeshView cube{};
+            cube.vertices = cubeVerts;
+            cube.indices = cubeIndices;
+            cube.texture = tex.get();
+            cube.triangleColors = cubeTriangleColors;
 
-                rasterize_triangle(fb, tri, zbuf);
-            }
+            fb.ensure_depth(); // reuses the frame's depth target; tiles clear lazily
+            draw_mesh(fb, mul(view_matrix(cam), model), cube);
         }
     };
 } // namespace almondnamespace::anativecontext
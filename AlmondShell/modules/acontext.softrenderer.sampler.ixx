@@ -0,0 +1,246 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondEngine - Modular C++ Game Engine                   *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for non-commercial purposes only           *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution allowed with this notice.                 *
+ *   No obligation to disclose modifications.                 *
+ *   See LICENSE file for full terms.                         *
+ **************************************************************/
+ //
+ // acontext.softrenderer.sampler.ixx
+ // SoftRenderer - texture sampler (tiled mip chains, fixed-point bilinear)
+ //
+ // Textures are sampled from a mip chain whose levels are stored in 4x4
+ // texel tiles: one tile is 64 bytes, a single cache line, so a bilinear
+ // footprint almost always touches one line whatever the direction of
+ // travel (rotated or sheared surfaces thrash row-major storage). Filtering
+ // runs in 8.8 fixed point on packed texels, two channels per 32-bit
+ // multiply, and is agnostic to channel order. Level selection follows the
+ // GPU rule: log2 of the larger screen-space texel footprint.
+ //
+
+module;
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+export module acontext.softrenderer.sampler;
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+
+import <algorithm>;
+import <cmath>;
+import <cstdint>;
+import <vector>;
+
+export namespace almondnamespace::anativecontext::sampler
+{
+    enum class Filter : std::uint8_t
+    {
+        Nearest,
+        Bilinear
+    };
+
+    inline constexpr int kTileShift = 2;                // 4x4 texels per tile
+    inline constexpr int kTileDim = 1 << kTileShift;
+    inline constexpr int kTileTexels = kTileDim * kTileDim;
+
+    struct MipLevel
+    {
+        int width = 0;
+        int height = 0;
+        int tilesX = 0;
+        std::vector<std::uint32_t> texels{}; // tile-major, row-major inside each tile
+
+        [[nodiscard]] std::size_t address(int x, int y) const noexcept
+        {
+            const std::size_t tile = std::size_t(y >> kTileShift) * std::size_t(tilesX) + std::size_t(x >> kTileShift);
+            return tile * kTileTexels + std::size_t((y & (kTileDim - 1)) << kTileShift) + std::size_t(x & (kTileDim - 1));
+        }
+
+        // Clamp-to-edge fetch.
+        [[nodiscard]] std::uint32_t fetch(int x, int y) const noexcept
+        {
+            x = x < 0 ? 0 : (x >= width ? width - 1 : x);
+            y = y < 0 ? 0 : (y >= height ? height - 1 : y);
+            return texels[address(x, y)];
+        }
+    };
+
+    struct MipChain
+    {
+        std::vector<MipLevel> levels{};
+
+        [[nodiscard]] bool empty() const noexcept { return levels.empty(); }
+        [[nodiscard]] int width() const noexcept { return levels.empty() ? 0 : levels.front().width; }
+        [[nodiscard]] int height() const noexcept { return levels.empty() ? 0 : levels.front().height; }
+    };
+
+    namespace detail
+    {
+        inline void store_tiled(MipLevel& level, const std::uint32_t* linear)
+        {
+            level.tilesX = (level.width + kTileDim - 1) >> kTileShift;
+            const int tilesY = (level.height + kTileDim - 1) >> kTileShift;
+            level.texels.assign(std::size_t(level.tilesX) * std::size_t(tilesY) * kTileTexels, 0u);
+
+            for (int y = 0; y < level.height; ++y)
+            {
+                const std::uint32_t* row = linear + std::size_t(y) * std::size_t(level.width);
+                for (int x = 0; x < level.width; ++x)
+                    level.texels[level.address(x, y)] = row[x];
+            }
+        }
+
+        // Rounded per-channel average of four packed texels.
+        [[nodiscard]] inline std::uint32_t average4(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) noexcept
+        {
+            constexpr std::uint32_t kMask = 0x00FF00FFu;
+            const std::uint32_t lo = ((a & kMask) + (b & kMask) + (c & kMask) + (d & kMask) + 0x00020002u) >> 2;
+            const std::uint32_t hi = (((a >> 8) & kMask) + ((b >> 8) & kMask) + ((c >> 8) & kMask) + ((d >> 8) & kMask) + 0x00020002u) >> 2;
+            return (lo & kMask) | ((hi & kMask) << 8);
+        }
+
+        // a + (b - a) * w / 256 per channel, w in [0, 256].
+        [[nodiscard]] inline std::uint32_t lerp(std::uint32_t a, std::uint32_t b, std::uint32_t w) noexcept
+        {
+            constexpr std::uint32_t kMask = 0x00FF00FFu;
+            const std::uint32_t iw = 256u - w;
+            const std::uint32_t lo = ((a & kMask) * iw + (b & kMask) * w) >> 8;
+            const std::uint32_t hi = ((a >> 8) & kMask) * iw + ((b >> 8) & kMask) * w;
+            return (lo & kMask) | (hi & ~kMask);
+        }
+
+        [[nodiscard]] inline std::uint32_t bilinear(
+            std::uint32_t t00, std::uint32_t t10, std::uint32_t t01, std::uint32_t t11,
+            std::uint32_t fx, std::uint32_t fy) noexcept
+        {
+            return lerp(lerp(t00, t10, fx), lerp(t01, t11, fx), fy);
+        }
+    } // namespace detail
+
+    // Builds a tiled chain from linear pixels (stride == width). With
+    // `generateMips`, levels are box-filtered down to 1x1.
+    [[nodiscard]] inline MipChain build_mip_chain(const std::uint32_t* pixels, int width, int height, bool generateMips = true)
+    {
+        MipChain chain{};
+        if (!pixels || width <= 0 || height <= 0)
+            return chain;
+
+        std::vector<std::uint32_t> current(pixels, pixels + std::size_t(width) * std::size_t(height));
+        std::vector<std::uint32_t> next{};
+
+        for (;;)
+        {
+            MipLevel& level = chain.levels.emplace_back();
+            level.width = width;
+            level.height = height;
+            detail::store_tiled(level, current.data());
+
+            if (!generateMips || (width == 1 && height == 1))
+                break;
+
+            const int nextW = (std::max)(1, width / 2);
+            const int nextH = (std::max)(1, height / 2);
+            next.resize(std::size_t(nextW) * std::size_t(nextH));
+
+            for (int y = 0; y < nextH; ++y)
+            {
+                const int y0 = (std::min)(y * 2, height - 1);
+                const int y1 = (std::min)(y * 2 + 1, height - 1);
+                for (int x = 0; x < nextW; ++x)
+                {
+                    const int x0 = (std::min)(x * 2, width - 1);
+                    const int x1 = (std::min)(x * 2 + 1, width - 1);
+                    next[std::size_t(y) * std::size_t(nextW) + std::size_t(x)] = detail::average4(
+                        current[std::size_t(y0) * std::size_t(width) + std::size_t(x0)],
+                        current[std::size_t(y0) * std::size_t(width) + std::size_t(x1)],
+                        current[std::size_t(y1) * std::size_t(width) + std::size_t(x0)],
+                        current[std::size_t(y1) * std::size_t(width) + std::size_t(x1)]);
+                }
+            }
+
+            current.swap(next);
+            width = nextW;
+            height = nextH;
+        }
+
+        return chain;
+    }
+
+    // Level of detail for a pixel whose UV changes by (dudx, dvdx) along x and
+    // (dudy, dvdy) along y, in normalized coordinates.
+    [[nodiscard]] inline float compute_lod(float dudx, float dvdx, float dudy, float dvdy, int width, int height) noexcept
+    {
+        const float w = float(width);
+        const float h = float(height);
+        const float lenX = dudx * dudx * w * w + dvdx * dvdx * h * h;
+        const float lenY = dudy * dudy * w * w + dvdy * dvdy * h * h;
+        const float rho2 = (std::max)(lenX, lenY);
+        return rho2 > 0.0f ? 0.5f * std::log2(rho2) : 0.0f;
+    }
+
+    // Nearest mip level for `lod` (magnification uses level 0).
+    [[nodiscard]] inline const MipLevel& select_level(const MipChain& chain, float lod) noexcept
+    {
+        const int last = int(chain.levels.size()) - 1;
+        const int index = lod <= 0.5f ? 0 : (std::min)(last, int(lod + 0.5f));
+        return chain.levels[std::size_t(index)];
+    }
+
+    [[nodiscard]] inline std::uint32_t sample_nearest(const MipLevel& level, float u, float v) noexcept
+    {
+        return level.fetch(int(std::floor(u * float(level.width))), int(std::floor(v * float(level.height))));
+    }
+
+    // Texel centres sit at (i + 0.5) / size, as on the GPU.
+    [[nodiscard]] inline std::uint32_t sample_bilinear(const MipLevel& level, float u, float v) noexcept
+    {
+        // Rounded to 1/256 texel so centres land exactly despite float error.
+        const int fu = int(std::floor(u * float(level.width) * 256.0f + 0.5f)) - 128;
+        const int fv = int(std::floor(v * float(level.height) * 256.0f + 0.5f)) - 128;
+        const int x0 = fu >> 8;
+        const int y0 = fv >> 8;
+        const auto fx = std::uint32_t(fu & 0xFF);
+        const auto fy = std::uint32_t(fv & 0xFF);
+
+        // Interior footprints read straight from the tile(s) without clamping.
+        if (x0 >= 0 && y0 >= 0 && x0 + 1 < level.width && y0 + 1 < level.height)
+        {
+            const std::uint32_t* t = level.texels.data();
+            return detail::bilinear(
+                t[level.address(x0, y0)], t[level.address(x0 + 1, y0)],
+                t[level.address(x0, y0 + 1)], t[level.address(x0 + 1, y0 + 1)], fx, fy);
+        }
+
+        return detail::bilinear(
+            level.fetch(x0, y0), level.fetch(x0 + 1, y0),
+            level.fetch(x0, y0 + 1), level.fetch(x0 + 1, y0 + 1), fx, fy);
+    }
+
+    [[nodiscard]] inline std::uint32_t sample(const MipLevel& level, float u, float v, Filter filter) noexcept
+    {
+        return filter == Filter::Bilinear ? sample_bilinear(level, u, v) : sample_nearest(level, u, v);
+    }
+
+    [[nodiscard]] inline std::uint32_t sample(const MipChain& chain, float u, float v, float lod, Filter filter) noexcept
+    {
+        return sample(select_level(chain, lod), u, v, filter);
+    }
+} // namespace almondnamespace::anativecontext::sampler
+
+#else
+export namespace almondnamespace::anativecontext::sampler {}
+#endif // ALMOND_USING_SOFTWARE_RENDERER
@@ -40,6 +40,7 @@ module;
 
 export module acontext.softrenderer.state;
 
+import <algorithm>;
 import <array>;
 import <bitset>;
 import <cstdint>;
@@ -54,6 +55,117 @@ import aengine.core.time;
 
 export namespace almondnamespace::anativecontext
 {
+    // Screen tile edge shared by the tile rasterizer and lazy depth clears.
+    inline constexpr int kFrameTileSize = 64;
+
+    // Colour/depth targets reused across frames. Storage grows with 25% slack
+    // and only shrinks once the frame drops below a quarter of it, so drag
+    // resizes and per-frame clears do not hit the allocator. Depth is only
+    // allocated once a 3D path asks for it and is cleared lazily per tile.
+    struct SoftFrameResources
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<std::uint32_t> color{};   // packed 0xAARRGGBB, row stride == width
+        std::vector<float>         depth{};   // 1/z per pixel, 0 = far
+        std::vector<std::uint8_t>  depthTileStale{};
+        int tilesX = 0;
+        int tilesY = 0;
+        std::size_t reallocations = 0;
+
+        // Returns true when the frame dimensions changed.
+        bool resize(int w, int h, std::uint32_t fill = 0xFF000000u)
+        {
+            w = (std::max)(1, w);
+            h = (std::max)(1, h);
+            if (w == width && h == height && !color.empty())
+                return false;
+
+            width = w;
+            height = h;
+            tilesX = (w + kFrameTileSize - 1) / kFrameTileSize;
+            tilesY = (h + kFrameTileSize - 1) / kFrameTileSize;
+
+            fit(color, pixel_count(), fill);
+            if (!depth.empty())
+            {
+                fit(depth, pixel_count(), 0.0f);
+                fit(depthTileStale, std::size_t(tilesX) * std::size_t(tilesY), std::uint8_t{ 0 });
+            }
+            return true;
+        }
+
+        [[nodiscard]] std::size_t pixel_count() const noexcept
+        {
+            return std::size_t(width) * std::size_t(height);
+        }
+
+        void clear_color(std::uint32_t value) noexcept
+        {
+            std::fill_n(color.data(), color.size(), value);
+        }
+
+        // Allocates depth on first use and marks every tile stale.
+        void ensure_depth()
+        {
+            if (depth.size() != pixel_count())
+            {
+                fit(depth, pixel_count(), 0.0f);
+                fit(depthTileStale, std::size_t(tilesX) * std::size_t(tilesY), std::uint8_t{ 0 });
+            }
+            invalidate_depth();
+        }
+
+        // O(tiles): the pixels are cleared by whoever touches the tile first.
+        void invalidate_depth() noexcept
+        {
+            std::fill(depthTileStale.begin(), depthTileStale.end(), std::uint8_t{ 1 });
+        }
+
+        // Clears tile (tx, ty) if it is still stale. Tiles are disjoint, so
+        // concurrent calls for different tiles are safe.
+        void clear_depth_tile(int tx, int ty) noexcept
+        {
+            auto& stale = depthTileStale[std::size_t(ty) * std::size_t(tilesX) + std::size_t(tx)];
+            if (!stale)
+                return;
+
+            const int x0 = tx * kFrameTileSize;
+            const int y0 = ty * kFrameTileSize;
+            const int x1 = (std::min)(x0 + kFrameTileSize, width);
+            const int y1 = (std::min)(y0 + kFrameTileSize, height);
+            for (int y = y0; y < y1; ++y)
+                std::fill_n(depth.data() + std::size_t(y) * std::size_t(width) + std::size_t(x0), x1 - x0, 0.0f);
+            stale = 0;
+        }
+
+        void release() noexcept
+        {
+            color = {};
+            depth = {};
+            depthTileStale = {};
+            width = height = tilesX = tilesY = 0;
+        }
+
+    private:
+        template <typename T>
+        void fit(std::vector<T>& v, std::size_t n, T fill)
+        {
+            if (n > v.capacity() || n < v.capacity() / 4)
+            {
+                std::vector<T> fresh{};
+                fresh.reserve(n + n / 4);
+                fresh.assign(n, fill);
+                v.swap(fresh);
+                ++reallocations;
+            }
+            else
+            {
+                v.assign(n, fill); // within capacity: no allocation
+            }
+        }
+    };
+
     struct SoftRendState
     {
 #ifdef ALMOND_USING_WINMAIN
@@ -68,7 +180,9 @@ export namespace almondnamespace::anativecontext
         int width{ 400 };
         int height{ 300 };
         bool running{ false };
-        std::vector<std::uint32_t> framebuffer{};
+        bool headless{ false };          // offscreen: frames go to capture only
+        std::uint64_t presentedFrames{ 0 };
+        SoftFrameResources frame{};
 
         struct MouseState
         {
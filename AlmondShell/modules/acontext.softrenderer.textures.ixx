@@ -12,11 +12,14 @@ export module acontext.softrenderer.textures;
 import <algorithm>;
 import <cstdint>;
 import <memory>;
+import <mutex>;
 import <unordered_map>;
 import <vector>;
 
 import aatlas.texture;        // TextureAtlas
 import acontext.softrenderer.state;   // SoftRendState
+import acontext.softrenderer.sampler; // sampler::MipChain, sampler::Filter
+import apixel.convert;                // pixel::rgba8_to_argb32
 import aengine.platform;    // almondnamespace
 import aengine.input;       // almondnamespace::input
 //import aengine.config; // almondnamespace::input
@@ -33,6 +36,10 @@ export namespace almondnamespace::anativecontext
         int height = 0;
         std::vector<uint32_t> pixels; // RGBA8
 
+        sampler::Filter filter = sampler::Filter::Bilinear;
+        bool mipmaps = true;
+        std::uint64_t version = 0; // bump via mark_dirty() after editing pixels
+
         Texture() = default;
         Texture(int w, int h, uint32_t fill = 0xFFFFFFFF)
             : width(w), height(h), pixels(w * h, fill) {
@@ -44,6 +51,29 @@ export namespace almondnamespace::anativecontext
             y = std::clamp(y, 0, height - 1);
             return pixels[static_cast<size_t>(y) * width + x];
         }
+
+        void mark_dirty() noexcept { ++version; }
+
+        // Tiled mip chain for the rasterizer, rebuilt lazily when `version`
+        // moves. A rebuild swaps in a new chain, so callers keep sampling the
+        // one they were handed for as long as they hold it.
+        std::shared_ptr<const sampler::MipChain> mip_chain() const
+        {
+            std::scoped_lock lock(mipsMutex_);
+
+            if (!mips_ || mipsVersion_ != version || mips_->width() != width || mips_->height() != height)
+            {
+                mips_ = std::make_shared<const sampler::MipChain>(
+                    sampler::build_mip_chain(pixels.data(), width, height, mipmaps));
+                mipsVersion_ = version;
+            }
+            return mips_;
+        }
+
+    private:
+        mutable std::mutex mipsMutex_{};
+        mutable std::shared_ptr<const sampler::MipChain> mips_{};
+        mutable std::uint64_t mipsVersion_ = 0;
     };
 
     using TexturePtr = std::shared_ptr<Texture>;
@@ -53,11 +83,89 @@ export namespace almondnamespace::anativecontext
         return std::make_shared<Texture>(w, h, fill);
     }
 
+    // ─── Atlas mirrors ──────────────────────────────────────────
+    // Packed 0xAARRGGBB copies of atlases, keyed by atlas and refreshed when
+    // TextureAtlas::version moves (same rule as the GPU backends' uploads).
+    // Only the rectangles the atlas reports dirty are re-swizzled; a full
+    // conversion happens on first use, on resize, or when the atlas's dirty
+    // log no longer covers the cached version.
+    class AtlasTextureCache
+    {
+    public:
+        // Current mirror of `atlas`, or nullptr when its pixels are missing.
+        const Texture* acquire(const TextureAtlas& atlas)
+        {
+            const int w = static_cast<int>(atlas.width);
+            const int h = static_cast<int>(atlas.height);
+            const std::size_t pixelCount = std::size_t(w) * std::size_t(h);
+            if (pixelCount == 0 || atlas.pixel_data.size() < pixelCount * 4u)
+                return nullptr;
+
+            Entry& entry = entries_[&atlas];
+            const std::uint64_t version = atlas.version;
+            const bool sized = entry.texture && entry.texture->width == w && entry.texture->height == h;
+            if (sized && entry.version == version)
+                return entry.texture.get();
+
+            if (!sized)
+                entry.texture = create_texture(w, h);
+
+            const auto* src = reinterpret_cast<const std::uint8_t*>(atlas.pixel_data.data());
+            auto* dst = entry.texture->pixels.data();
+
+            rects_.clear();
+            if (!sized || !atlas.dirty_regions_since(entry.version, rects_))
+            {
+                pixel::rgba8_to_argb32(src, dst, pixelCount);
+                ++fullRefreshes_;
+            }
+            else
+            {
+                for (const auto& rect : rects_)
+                {
+                    const std::uint32_t x1 = (std::min)(rect.x + rect.width, atlas.width);
+                    const std::uint32_t y1 = (std::min)(rect.y + rect.height, atlas.height);
+                    if (rect.x >= x1)
+                        continue;
+
+                    for (std::uint32_t y = rect.y; y < y1; ++y)
+                    {
+                        const std::size_t offset = std::size_t(y) * std::size_t(w) + rect.x;
+                        pixel::rgba8_to_argb32(src + offset * 4u, dst + offset, x1 - rect.x);
+                    }
+                }
+                ++partialRefreshes_;
+            }
+
+            entry.version = version;
+            entry.texture->mark_dirty();
+            return entry.texture.get();
+        }
+
+        void erase(const TextureAtlas& atlas) { entries_.erase(&atlas); }
+        void clear() { entries_.clear(); }
+
+        [[nodiscard]] std::uint64_t full_refreshes() const noexcept { return fullRefreshes_; }
+        [[nodiscard]] std::uint64_t partial_refreshes() const noexcept { return partialRefreshes_; }
+
+    private:
+        struct Entry
+        {
+            TexturePtr texture{};
+            std::uint64_t version = 0;
+        };
+
+        std::unordered_map<const TextureAtlas*, Entry> entries_{};
+        std::vector<AtlasDirtyRect> rects_{};
+        std::uint64_t fullRefreshes_ = 0;
+        std::uint64_t partialRefreshes_ = 0;
+    };
+
     // ─── BackendData for Software Renderer ─────────────────────
     struct BackendData
     {
-        // Map atlas → texture for caching
-        std::unordered_map<const TextureAtlas*, TexturePtr> textures;
+        // Atlas -> packed software texture, refreshed by atlas version
+        AtlasTextureCache textures;
 
 #if defined(ALMOND_USING_SOFTWARE_RENDERER)
 
@@ -0,0 +1,276 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondEngine - Modular C++ Game Engine                   *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for non-commercial purposes only           *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution allowed with this notice.                 *
+ *   No obligation to disclose modifications.                 *
+ *   See LICENSE file for full terms.                         *
+ **************************************************************/
+ //
+ // acontext.softrenderer.vertex.ixx
+ // SoftRenderer - vertex transform, clipping and primitive assembly
+ //
+ // Vertices are transformed once per draw into a structure-of-arrays clip
+ // stream (four at a time with SSE2), so indexed meshes share transformed
+ // vertices between triangles. Triangles are then trivially rejected against
+ // the viewport, clipped against the homogeneous near plane (w >= kNearW),
+ // projected to pixels and back-face culled by their screen-space winding
+ // before they reach the tile rasterizer.
+ //
+
+module;
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ALMOND_VERTEX_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+export module acontext.softrenderer.vertex;
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+
+import <cmath>;
+import <cstddef>;
+import <cstdint>;
+import <span>;
+import <vector>;
+
+import acontext.softrenderer.textures;   // Texture
+import acontext.softrenderer.raster;     // raster::ScreenTriangle
+
+export namespace almondnamespace::anativecontext
+{
+    struct Vec3 { float x = 0.0f, y = 0.0f, z = 0.0f; };
+    struct Vec2 { float u = 0.0f, v = 0.0f; };
+    struct Mat4 { float m[4][4] = {}; };
+    struct Vertex { Vec3 pos; Vec2 uv; };
+}
+
+export namespace almondnamespace::anativecontext::vertex
+{
+    // Vertices closer than this (in clip w) are clipped away.
+    inline constexpr float kNearW = 1e-3f;
+
+    enum class CullMode : std::uint8_t
+    {
+        None,
+        Back,   // drop triangles wound clockwise on screen (counter-clockwise in view space)
+        Front,
+    };
+
+    struct ClipVertex
+    {
+        float x = 0.0f, y = 0.0f, z = 0.0f, w = 0.0f;
+        float u = 0.0f, v = 0.0f;
+    };
+
+    // Transformed vertices, one array per component. Capacity is kept across
+    // draws so steady-state frames do not allocate.
+    struct ClipStream
+    {
+        std::vector<float> x{}, y{}, z{}, w{}, u{}, v{};
+
+        void resize(std::size_t count)
+        {
+            x.resize(count); y.resize(count); z.resize(count); w.resize(count);
+            u.resize(count); v.resize(count);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return x.size(); }
+
+        [[nodiscard]] ClipVertex at(std::size_t i) const noexcept
+        {
+            return { x[i], y[i], z[i], w[i], u[i], v[i] };
+        }
+    };
+
+    // View space -> clip space with the viewport folded in, so x/w and y/w
+    // are already pixel coordinates. Matches the renderer's fixed pinhole:
+    // `focal` pixels per unit at distance 1, eye `zOffset` units behind the
+    // view origin, +y up.
+    [[nodiscard]] inline Mat4 pixel_projection(int width, int height, float focal = 200.0f, float zOffset = 3.0f) noexcept
+    {
+        const float cx = float(width) * 0.5f;
+        const float cy = float(height) * 0.5f;
+
+        Mat4 p{};
+        p.m[0][0] = focal;  p.m[0][2] = cx; p.m[0][3] = cx * zOffset;
+        p.m[1][1] = -focal; p.m[1][2] = cy; p.m[1][3] = cy * zOffset;
+        p.m[2][2] = 1.0f;   p.m[2][3] = zOffset;
+        p.m[3][2] = 1.0f;   p.m[3][3] = zOffset;
+        return p;
+    }
+
+    [[nodiscard]] inline ClipVertex transform_one(const Mat4& m, const Vertex& in) noexcept
+    {
+        const Vec3& p = in.pos;
+        return {
+            m.m[0][0] * p.x + m.m[0][1] * p.y + m.m[0][2] * p.z + m.m[0][3],
+            m.m[1][0] * p.x + m.m[1][1] * p.y + m.m[1][2] * p.z + m.m[1][3],
+            m.m[2][0] * p.x + m.m[2][1] * p.y + m.m[2][2] * p.z + m.m[2][3],
+            m.m[3][0] * p.x + m.m[3][1] * p.y + m.m[3][2] * p.z + m.m[3][3],
+            in.uv.u, in.uv.v
+        };
+    }
+
+    // Transforms every vertex by `m` into `out` (resized to match).
+    inline void transform(const Mat4& m, std::span<const Vertex> in, ClipStream& out)
+    {
+        const std::size_t count = in.size();
+        out.resize(count);
+
+        std::size_t i = 0;
+#if defined(ALMOND_VERTEX_SSE2)
+        __m128 row[4][4];
+        for (int r = 0; r < 4; ++r)
+            for (int c = 0; c < 4; ++c)
+                row[r][c] = _mm_set1_ps(m.m[r][c]);
+
+        float* const dst[4] = { out.x.data(), out.y.data(), out.z.data(), out.w.data() };
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const Vertex* v = in.data() + i;
+            const __m128 px = _mm_setr_ps(v[0].pos.x, v[1].pos.x, v[2].pos.x, v[3].pos.x);
+            const __m128 py = _mm_setr_ps(v[0].pos.y, v[1].pos.y, v[2].pos.y, v[3].pos.y);
+            const __m128 pz = _mm_setr_ps(v[0].pos.z, v[1].pos.z, v[2].pos.z, v[3].pos.z);
+
+            for (int r = 0; r < 4; ++r)
+            {
+                const __m128 acc = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(row[r][0], px), _mm_mul_ps(row[r][1], py)),
+                    _mm_add_ps(_mm_mul_ps(row[r][2], pz), row[r][3]));
+                _mm_storeu_ps(dst[r] + i, acc);
+            }
+
+            for (int k = 0; k < 4; ++k)
+            {
+                out.u[i + k] = v[k].uv.u;
+                out.v[i + k] = v[k].uv.v;
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            const ClipVertex c = transform_one(m, in[i]);
+            out.x[i] = c.x; out.y[i] = c.y; out.z[i] = c.z; out.w[i] = c.w;
+            out.u[i] = c.u; out.v[i] = c.v;
+        }
+    }
+
+    // Sutherland-Hodgman against w >= kNearW. Attributes interpolate linearly
+    // in clip space. Returns the vertex count of the clipped polygon (0, 3 or 4).
+    [[nodiscard]] inline int clip_near(const ClipVertex (&in)[3], ClipVertex (&out)[4]) noexcept
+    {
+        int count = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            const ClipVertex& a = in[i];
+            const ClipVertex& b = in[(i + 1) % 3];
+            const float da = a.w - kNearW;
+            const float db = b.w - kNearW;
+
+            if (da >= 0.0f)
+                out[count++] = a;
+
+            if ((da >= 0.0f) != (db >= 0.0f))
+            {
+                const float t = da / (da - db);
+                out[count++] = {
+                    a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                    a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t,
+                    a.u + (b.u - a.u) * t, a.v + (b.v - a.v) * t };
+            }
+        }
+        return count;
+    }
+
+    namespace detail
+    {
+        [[nodiscard]] inline bool outside_viewport(const ClipVertex (&t)[3], float width, float height) noexcept
+        {
+            auto all = [&](auto&& pred) { return pred(t[0]) && pred(t[1]) && pred(t[2]); };
+
+            // Vertices behind the eye (w < 0) flip sign after division, so only
+            // reject when every vertex is in front of the near plane.
+            if (!all([](const ClipVertex& c) { return c.w >= kNearW; }))
+                return all([](const ClipVertex& c) { return c.w < kNearW; });
+
+            return all([](const ClipVertex& c) { return c.x < 0.0f; })
+                || all([](const ClipVertex& c) { return c.y < 0.0f; })
+                || all([&](const ClipVertex& c) { return c.x > width * c.w; })
+                || all([&](const ClipVertex& c) { return c.y > height * c.w; });
+        }
+
+        inline void project(const ClipVertex& c, raster::ScreenTriangle& out, int i) noexcept
+        {
+            const float iw = 1.0f / c.w;
+            out.x[i] = c.x * iw;
+            out.y[i] = c.y * iw;
+            out.invZ[i] = iw;          // depth and perspective-correct UVs use 1/w
+            out.uOverZ[i] = c.u * iw;
+            out.vOverZ[i] = c.v * iw;
+        }
+
+        [[nodiscard]] inline bool culled(const raster::ScreenTriangle& s, CullMode cull) noexcept
+        {
+            if (cull == CullMode::None)
+                return false;
+
+            // Pixel space is y-down: view-space counter-clockwise faces come out negative.
+            const float area = (s.x[1] - s.x[0]) * (s.y[2] - s.y[0]) - (s.y[1] - s.y[0]) * (s.x[2] - s.x[0]);
+            return cull == CullMode::Back ? area >= 0.0f : area <= 0.0f;
+        }
+    } // namespace detail
+
+    // Clips, projects and culls one clip-space triangle, calling emit() with
+    // each surviving pixel-space triangle (at most two).
+    template <typename Emit>
+    inline void assemble_triangle(
+        const ClipVertex (&tri)[3],
+        int width, int height,
+        CullMode cull,
+        const Texture* tex, std::uint32_t color,
+        Emit&& emit)
+    {
+        if (detail::outside_viewport(tri, float(width), float(height)))
+            return;
+
+        ClipVertex poly[4]{};
+        const int count = clip_near(tri, poly);
+
+        raster::ScreenTriangle screen{};
+        screen.tex = tex;
+        screen.color = color;
+
+        // Fan out the clipped polygon; every piece shares the original plane,
+        // so the winding test gives the same answer for each.
+        for (int k = 1; k + 1 < count; ++k)
+        {
+            detail::project(poly[0], screen, 0);
+            detail::project(poly[k], screen, 1);
+            detail::project(poly[k + 1], screen, 2);
+            if (!detail::culled(screen, cull))
+                emit(screen);
+        }
+    }
+} // namespace almondnamespace::anativecontext::vertex
+
+#else
+export namespace almondnamespace::anativecontext::vertex {}
+#endif // ALMOND_USING_SOFTWARE_RENDERER
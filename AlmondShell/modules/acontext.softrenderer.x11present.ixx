@@ -0,0 +1,457 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondEngine - Modular C++ Game Engine                   *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for non-commercial purposes only           *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution allowed with this notice.                 *
+ *   No obligation to disclose modifications.                 *
+ *   See LICENSE file for full terms.                         *
+ **************************************************************/
+ //
+ // acontext.softrenderer.x11present.ixx
+ // SoftRenderer - X11 presentation (MIT-SHM with XPutImage fallback)
+ //
+ // The presenter opens its own connection to the application's display so
+ // ShmCompletion events never reach the multiplexer's event pump. With
+ // MIT-SHM it keeps two shared images: each present copies the finished
+ // framebuffer into the idle image and queues XShmPutImage, so the server
+ // reads one image while the renderer is free to build the next frame.
+ // Without MIT-SHM (remote displays, missing extension) frames go through
+ // XPutImage straight from the framebuffer. Waiting for a completion is
+ // bounded, so a server that stops answering costs a torn frame at worst
+ // instead of hanging the render thread.
+ //
+
+module;
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+#if defined(__linux__) && defined(ALMOND_USING_SOFTWARE_RENDERER)
+#   include <X11/Xlib.h>
+#   include <X11/Xutil.h>
+#   if defined(ALMOND_SOFT_XSHM)
+#       include <X11/extensions/XShm.h>
+#       include <cerrno>
+#       include <poll.h>
+#       include <sys/ipc.h>
+#       include <sys/shm.h>
+#   endif
+#endif
+
+export module acontext.softrenderer.x11present;
+
+#if defined(__linux__) && defined(ALMOND_USING_SOFTWARE_RENDERER)
+
+import <chrono>;
+import <cstdint>;
+import <cstring>;
+import <iostream>;
+import <mutex>;
+import <vector>;
+
+import apixel.convert;                   // pixel::swap_red_blue
+
+export namespace almondnamespace::anativecontext::x11present
+{
+#if defined(ALMOND_SOFT_XSHM)
+    // Catches X errors raised by one display connection for the lifetime of
+    // the trap. Xlib has a single process-wide error handler, so traps are
+    // serialised by a lock, the display is synced on entry and exit so only
+    // requests issued inside the trap are attributed to it, and errors from
+    // every other connection are forwarded to the handler that was replaced.
+    class ScopedErrorTrap
+    {
+    public:
+        explicit ScopedErrorTrap(Display* display)
+            : lock_(state_mutex())
+            , display_(display)
+        {
+            XSync(display_, False);
+            auto& state = trap_state();
+            state.display = display_;
+            state.errorCode = 0;
+            state.previous = XSetErrorHandler(&ScopedErrorTrap::on_error);
+        }
+
+        ~ScopedErrorTrap()
+        {
+            XSync(display_, False);
+            auto& state = trap_state();
+            XSetErrorHandler(state.previous);
+            state = {};
+        }
+
+        ScopedErrorTrap(const ScopedErrorTrap&) = delete;
+        ScopedErrorTrap& operator=(const ScopedErrorTrap&) = delete;
+
+        // Round-trips to the server, then reports the first trapped error (0 = none).
+        [[nodiscard]] int sync() const
+        {
+            XSync(display_, False);
+            return trap_state().errorCode;
+        }
+
+    private:
+        struct TrapState
+        {
+            Display* display = nullptr;
+            int errorCode = 0;
+            XErrorHandler previous = nullptr;
+        };
+
+        static std::mutex& state_mutex() noexcept
+        {
+            static std::mutex mutex{};
+            return mutex;
+        }
+
+        static TrapState& trap_state() noexcept
+        {
+            static TrapState state{};
+            return state;
+        }
+
+        // Runs on whichever thread reads the error off its connection.
+        static int on_error(Display* display, XErrorEvent* event)
+        {
+            auto& state = trap_state();
+            if (display == state.display)
+            {
+                if (state.errorCode == 0)
+                    state.errorCode = event->error_code;
+                return 0;
+            }
+            return state.previous ? state.previous(display, event) : 0;
+        }
+
+        std::unique_lock<std::mutex> lock_;
+        Display* display_ = nullptr;
+    };
+#endif
+
+    class X11Presenter
+    {
+    public:
+        X11Presenter() = default;
+        X11Presenter(const X11Presenter&) = delete;
+        X11Presenter& operator=(const X11Presenter&) = delete;
+        ~X11Presenter() { detach(); }
+
+        // Presents a packed 0xAARRGGBB frame to `window` on `appDisplay`.
+        // Returns false when the window cannot be presented to.
+        bool present(Display* appDisplay, ::Window window, const std::uint32_t* pixels, int width, int height)
+        {
+            if (!appDisplay || !window || !pixels || width <= 0 || height <= 0)
+                return false;
+
+            if (window != window_ && !attach(appDisplay, window))
+                return false;
+
+#if defined(ALMOND_SOFT_XSHM)
+            if (useShm_)
+                return present_shm(pixels, width, height);
+#endif
+            return present_put_image(pixels, width, height);
+        }
+
+        void detach() noexcept
+        {
+            if (!display_)
+                return;
+
+#if defined(ALMOND_SOFT_XSHM)
+            for (auto& buffer : shm_)
+            {
+                wait_for_completion(buffer);
+                release_shm(buffer);
+            }
+#endif
+            if (gc_)
+                XFreeGC(display_, gc_);
+            XCloseDisplay(display_);
+
+            display_ = nullptr;
+            gc_ = nullptr;
+            window_ = 0;
+            visual_ = nullptr;
+            useShm_ = false;
+        }
+
+        [[nodiscard]] bool using_shm() const noexcept { return useShm_; }
+
+        // Disabling MIT-SHM forces XPutImage from the next present on; the
+        // current connection is dropped so the choice is made again on attach.
+        void set_shm_enabled(bool enabled) noexcept
+        {
+            shmAllowed_ = enabled;
+            detach();
+        }
+
+        // Completions that never arrived within kCompletionTimeoutMs.
+        [[nodiscard]] std::uint64_t completion_timeouts() const noexcept { return completionTimeouts_; }
+
+    private:
+        bool attach(Display* appDisplay, ::Window window)
+        {
+            detach();
+
+            display_ = XOpenDisplay(DisplayString(appDisplay));
+            if (!display_)
+            {
+                std::cerr << "[SoftRenderer] X11 present: cannot open display connection\n";
+                return false;
+            }
+
+            XWindowAttributes attrs{};
+            if (!XGetWindowAttributes(display_, window, &attrs))
+            {
+                std::cerr << "[SoftRenderer] X11 present: window attributes unavailable\n";
+                detach();
+                return false;
+            }
+
+            window_ = window;
+            visual_ = attrs.visual;
+            depth_ = attrs.depth;
+            gc_ = XCreateGC(display_, window_, 0, nullptr);
+
+            // The framebuffer is 0xAARRGGBB; BGR visuals need a swizzle on copy.
+            swapRedBlue_ = visual_ && visual_->red_mask == 0xFFu && visual_->blue_mask == 0xFF0000u;
+
+#if defined(ALMOND_SOFT_XSHM)
+            useShm_ = shmAllowed_ && XShmQueryExtension(display_) == True;
+            completionEvent_ = useShm_ ? XShmGetEventBase(display_) + ShmCompletion : 0;
+#endif
+            std::cout << "[SoftRenderer] X11 present attached (" << (useShm_ ? "MIT-SHM" : "XPutImage") << ")\n";
+            return true;
+        }
+
+        bool present_put_image(const std::uint32_t* pixels, int width, int height)
+        {
+            const std::uint32_t* source = pixels;
+            if (swapRedBlue_)
+            {
+                const std::size_t count = std::size_t(width) * std::size_t(height);
+                if (staging_.size() < count)
+                    staging_.resize(count);
+                pixel::swap_red_blue(reinterpret_cast<const std::uint8_t*>(pixels),
+                    reinterpret_cast<std::uint8_t*>(staging_.data()), count);
+                source = staging_.data();
+            }
+
+            // Wraps the caller's memory; XPutImage copies it into the request buffer.
+            XImage* image = XCreateImage(display_, visual_, static_cast<unsigned>(depth_), ZPixmap, 0,
+                reinterpret_cast<char*>(const_cast<std::uint32_t*>(source)),
+                static_cast<unsigned>(width), static_cast<unsigned>(height), 32, width * 4);
+            if (!image)
+                return false;
+
+            XPutImage(display_, window_, gc_, image, 0, 0, 0, 0,
+                static_cast<unsigned>(width), static_cast<unsigned>(height));
+            XFlush(display_);
+
+            image->data = nullptr; // not ours to free
+            XDestroyImage(image);
+            return true;
+        }
+
+#if defined(ALMOND_SOFT_XSHM)
+        struct ShmBuffer
+        {
+            XImage* image = nullptr;
+            XShmSegmentInfo info{};
+            int width = 0;
+            int height = 0;
+            bool inFlight = false;
+        };
+
+        bool create_shm(ShmBuffer& buffer, int width, int height)
+        {
+            buffer.image = XShmCreateImage(display_, visual_, static_cast<unsigned>(depth_), ZPixmap,
+                nullptr, &buffer.info, static_cast<unsigned>(width), static_cast<unsigned>(height));
+            if (!buffer.image)
+                return false;
+
+            const std::size_t bytes = std::size_t(buffer.image->bytes_per_line) * std::size_t(height);
+            buffer.info.shmid = shmget(IPC_PRIVATE, bytes, IPC_CREAT | 0600);
+            if (buffer.info.shmid < 0)
+            {
+                XDestroyImage(buffer.image);
+                buffer.image = nullptr;
+                return false;
+            }
+
+            buffer.info.shmaddr = buffer.image->data = static_cast<char*>(shmat(buffer.info.shmid, nullptr, 0));
+            buffer.info.readOnly = False;
+
+            // Attach failures (e.g. a remote server) arrive as async X errors.
+            bool attached = false;
+            if (buffer.image->data != reinterpret_cast<char*>(-1))
+            {
+                const ScopedErrorTrap trap(display_);
+                attached = XShmAttach(display_, &buffer.info) && trap.sync() == 0;
+            }
+
+            // Marked for removal now; the kernel frees it once both sides detach.
+            shmctl(buffer.info.shmid, IPC_RMID, nullptr);
+
+            if (!attached)
+            {
+                if (buffer.image->data != reinterpret_cast<char*>(-1))
+                    shmdt(buffer.info.shmaddr);
+                buffer.image->data = nullptr;
+                XDestroyImage(buffer.image);
+                buffer.image = nullptr;
+                return false;
+            }
+
+            buffer.width = width;
+            buffer.height = height;
+            return true;
+        }
+
+        void release_shm(ShmBuffer& buffer) noexcept
+        {
+            if (!buffer.image)
+                return;
+
+            XShmDetach(display_, &buffer.info);
+            XSync(display_, False);
+            shmdt(buffer.info.shmaddr);
+            buffer.image->data = nullptr;
+            XDestroyImage(buffer.image);
+            buffer = {};
+        }
+
+        static constexpr int kCompletionTimeoutMs = 100;
+
+        // Blocks until the server has read `buffer`, or until the timeout,
+        // after which the buffer is reused anyway.
+        void wait_for_completion(ShmBuffer& buffer) noexcept
+        {
+            using Clock = std::chrono::steady_clock;
+            const auto deadline = Clock::now() + std::chrono::milliseconds(kCompletionTimeoutMs);
+
+            while (buffer.inFlight)
+            {
+                if (XPending(display_) == 0)
+                {
+                    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+                    pollfd fd{ ConnectionNumber(display_), POLLIN, 0 };
+                    const int ready = remaining > 0 ? poll(&fd, 1, static_cast<int>(remaining)) : 0;
+                    if (ready < 0 && errno == EINTR)
+                        continue;
+                    if (ready <= 0)
+                    {
+                        buffer.inFlight = false;
+                        ++completionTimeouts_;
+                        break;
+                    }
+                    continue; // XPending reads what arrived
+                }
+
+                XEvent event{};
+                XNextEvent(display_, &event); // only completions are selected on this connection
+                if (event.type == completionEvent_)
+                {
+                    const auto& done = reinterpret_cast<const XShmCompletionEvent&>(event);
+                    for (auto& b : shm_)
+                    {
+                        if (b.image && b.info.shmseg == done.shmseg)
+                            b.inFlight = false;
+                    }
+                }
+            }
+        }
+
+        bool present_shm(const std::uint32_t* pixels, int width, int height)
+        {
+            ShmBuffer& buffer = shm_[next_];
+            wait_for_completion(buffer);
+
+            if (buffer.width != width || buffer.height != height)
+            {
+                release_shm(buffer);
+                if (!create_shm(buffer, width, height))
+                {
+                    std::cerr << "[SoftRenderer] MIT-SHM unavailable; falling back to XPutImage\n";
+                    for (auto& b : shm_)
+                    {
+                        wait_for_completion(b);
+                        release_shm(b);
+                    }
+                    useShm_ = false;
+                    return present_put_image(pixels, width, height);
+                }
+            }
+
+            const std::size_t rowPixels = std::size_t(width);
+            for (int y = 0; y < height; ++y)
+            {
+                auto* dst = reinterpret_cast<std::uint8_t*>(buffer.image->data + std::size_t(y) * buffer.image->bytes_per_line);
+                const auto* src = reinterpret_cast<const std::uint8_t*>(pixels + std::size_t(y) * rowPixels);
+                if (swapRedBlue_)
+                    pixel::swap_red_blue(src, dst, rowPixels);
+                else
+                    std::memcpy(dst, src, rowPixels * 4u);
+            }
+
+            XShmPutImage(display_, window_, gc_, buffer.image, 0, 0, 0, 0,
+                static_cast<unsigned>(width), static_cast<unsigned>(height), True);
+            XFlush(display_);
+            buffer.inFlight = true;
+            next_ = (next_ + 1) % 2;
+            return true;
+        }
+
+        ShmBuffer shm_[2]{};
+        int next_ = 0;
+        int completionEvent_ = 0;
+#endif
+
+        Display* display_ = nullptr;
+        ::Window window_ = 0;
+        Visual* visual_ = nullptr;
+        int depth_ = 24;
+        GC gc_ = nullptr;
+        bool useShm_ = false;
+        bool shmAllowed_ = true;
+        bool swapRedBlue_ = false;
+        std::uint64_t completionTimeouts_ = 0;
+        std::vector<std::uint32_t> staging_{};
+    };
+
+    // One presenter per software backend (the backend state is global).
+    inline X11Presenter& presenter()
+    {
+        static X11Presenter instance{};
+        return instance;
+    }
+
+    // `display` / `window` come from WindowData::hdc / hwnd on Linux.
+    inline bool present(void* display, std::uintptr_t window, const std::uint32_t* pixels, int width, int height)
+    {
+        return presenter().present(static_cast<Display*>(display), static_cast<::Window>(window), pixels, width, height);
+    }
+
+    inline void shutdown() noexcept
+    {
+        presenter().detach();
+    }
+} // namespace almondnamespace::anativecontext::x11present
+
+#else
+export namespace almondnamespace::anativecontext::x11present {}
+#endif
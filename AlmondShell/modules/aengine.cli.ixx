@@ -18,4 +18,16 @@ export namespace almondnamespace::core::cli
     export using ::almondnamespace::core::cli::exe_path;
     export using ::almondnamespace::core::cli::print_engine_info;
     export using ::almondnamespace::core::cli::backend_filter;
+    export using ::almondnamespace::core::cli::target_fps;
+    export using ::almondnamespace::core::cli::idle_fps;
+    export using ::almondnamespace::core::cli::vsync;
+    export using ::almondnamespace::core::cli::drain_budget_us;
+    export using ::almondnamespace::core::cli::render_workers;
+    export using ::almondnamespace::core::cli::headless_stress_windows;
+    export using ::almondnamespace::core::cli::stress_scene;
+    export using ::almondnamespace::core::cli::stress_seconds;
+    export using ::almondnamespace::core::cli::software_headless;
+    export using ::almondnamespace::core::cli::capture_directory;
+    export using ::almondnamespace::core::cli::capture_every;
+    export using ::almondnamespace::core::cli::pacing_config;
 }
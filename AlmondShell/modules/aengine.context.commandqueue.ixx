@@ -10,6 +10,7 @@ export module aengine.context.commandqueue;
 // Standard library
 // ------------------------------------------------------------
 import <atomic>;
+import <chrono>;
 import <cstddef>;
 import <cstdint>;
 import <functional>;
@@ -34,6 +35,31 @@ export namespace almondnamespace::core
         Vulkan = 4
     };
 
+    // Priority class of a queued command. Each class has its own FIFO lane;
+    // a drain runs the lanes in this order:
+    //   PresentCritical  all of it  (resize callbacks, state the frame needs)
+    //   Upload           budgeted   (atlas/texture uploads)
+    //   Draw             all of it  (clear, draws and present, in FIFO order)
+    //   Background       budgeted   (whatever time the budget has left)
+    // Uploads run before draws so a draw queued after its upload still sees
+    // the texture when the budget allows. Leftover budgeted work carries over
+    // to the next drain.
+    enum class CommandPriority : std::uint8_t
+    {
+        PresentCritical = 0,
+        Draw = 1,
+        Upload = 2,
+        Background = 3
+    };
+
+    // Running totals over a queue's lifetime, for benchmarks and reports.
+    struct CommandQueueTotals
+    {
+        std::uint64_t drains = 0;   // drain() calls that ran at least one command
+        std::uint64_t commands = 0; // commands executed
+        std::uint64_t drainNs = 0;  // time spent in those drains
+    };
+
     struct CommandQueue
     {
         using RenderCommand = std::function<void()>;
@@ -41,14 +67,24 @@ export namespace almondnamespace::core
         // Push a command (thread-safe)
         void enqueue(RenderCommand cmd)
         {
-            enqueue(std::move(cmd), RenderPath::Unknown);
+            enqueue(std::move(cmd), RenderPath::Unknown, CommandPriority::Draw);
         }
 
         void enqueue(RenderCommand cmd, RenderPath path)
+        {
+            enqueue(std::move(cmd), path, CommandPriority::Draw);
+        }
+
+        void enqueue(RenderCommand cmd, CommandPriority priority)
+        {
+            enqueue(std::move(cmd), RenderPath::Unknown, priority);
+        }
+
+        void enqueue(RenderCommand cmd, RenderPath path, CommandPriority priority)
         {
             if (!cmd) return;
             std::lock_guard<std::mutex> lock(mutex_);
-            commands_.push(std::move(cmd));
+            lanes_[static_cast<std::size_t>(priority)].push(std::move(cmd));
             depth_.fetch_add(1, std::memory_order_relaxed);
             if (path != RenderPath::Unknown)
             {
@@ -60,32 +96,38 @@ export namespace almondnamespace::core
         void clear() noexcept
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            std::queue<RenderCommand> empty;
-            commands_.swap(empty);
+            for (auto& lane : lanes_)
+            {
+                std::queue<RenderCommand> empty;
+                lane.swap(empty);
+            }
             depth_.store(0, std::memory_order_relaxed);
             render_flags_ = 0;
         }
 
-        // Execute all queued commands. Returns true if anything ran.
+        // Per-drain time budget for the Upload and Background lanes.
+        // Zero (the default) means unlimited.
+        void set_drain_budget(std::chrono::microseconds budget) noexcept
+        {
+            budget_us_.store(budget.count() > 0 ? budget.count() : 0, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::chrono::microseconds drain_budget() const noexcept
+        {
+            return std::chrono::microseconds(budget_us_.load(std::memory_order_relaxed));
+        }
+
+        // Execute queued commands within the drain budget. Returns true if
+        // anything ran.
         bool drain()
         {
-            std::queue<RenderCommand> local;
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                if (commands_.empty())
-                    return false;
-                local.swap(commands_);
-                depth_.store(0, std::memory_order_relaxed);
-                render_flags_ = 0;
-            }
+            return drain_for(drain_budget());
+        }
 
-            while (!local.empty())
-            {
-                auto cmd = std::move(local.front());
-                local.pop();
-                cmd(); // cmd is guaranteed non-empty from enqueue(), but safe anyway.
-            }
-            return true;
+        // Execute everything, ignoring the budget (shutdown, teardown).
+        bool drain_all()
+        {
+            return drain_for(std::chrono::microseconds::zero());
         }
 
         // Depth snapshot for telemetry (thread-safe)
@@ -94,6 +136,23 @@ export namespace almondnamespace::core
             return depth_.load(std::memory_order_relaxed);
         }
 
+        // Time spent in drain() calls that ran commands since the last take
+        // (thread-safe). Returns 0 when nothing was drained.
+        [[nodiscard]] double take_drain_us() noexcept
+        {
+            return static_cast<double>(last_drain_ns_.exchange(0, std::memory_order_relaxed)) / 1000.0;
+        }
+
+        // Lifetime totals (thread-safe). Unlike take_drain_us() this does not
+        // reset, so a reader can diff two snapshots.
+        [[nodiscard]] CommandQueueTotals totals() const noexcept
+        {
+            return CommandQueueTotals{
+                total_drains_.load(std::memory_order_relaxed),
+                total_commands_.load(std::memory_order_relaxed),
+                total_drain_ns_.load(std::memory_order_relaxed) };
+        }
+
         [[nodiscard]] std::uint8_t render_flags_snapshot() const noexcept
         {
             std::lock_guard<std::mutex> lock(mutex_);
@@ -115,26 +174,122 @@ export namespace almondnamespace::core
             return (render_flags_snapshot() & static_cast<std::uint8_t>(RenderPath::Vulkan)) != 0u;
         }
 
-        // Optional: run at most one command (useful for budgeted pumping)
+        // Optional: run at most one command, taking lanes in drain order
         bool try_run_one()
+        {
+            for (const CommandPriority priority : kDrainOrder)
+            {
+                if (run_one(priority)) return true;
+            }
+            return false;
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t kLaneCount = 4;
+
+        // Lane order of a drain (see CommandPriority); not the enum order.
+        static constexpr CommandPriority kDrainOrder[kLaneCount] = {
+            CommandPriority::PresentCritical,
+            CommandPriority::Upload,
+            CommandPriority::Draw,
+            CommandPriority::Background,
+        };
+
+        std::queue<RenderCommand>& lane(CommandPriority priority) noexcept
+        {
+            return lanes_[static_cast<std::size_t>(priority)];
+        }
+
+        // Runs the whole lane as it stands; commands queued meanwhile wait
+        // for the next drain.
+        std::size_t run_lane(CommandPriority priority)
+        {
+            std::queue<RenderCommand> local;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (lane(priority).empty())
+                    return 0;
+                local.swap(lane(priority));
+                depth_.fetch_sub(local.size(), std::memory_order_relaxed);
+                if (priority == CommandPriority::Draw)
+                    render_flags_ = 0;
+            }
+
+            const std::size_t ran = local.size();
+            while (!local.empty())
+            {
+                auto cmd = std::move(local.front());
+                local.pop();
+                cmd(); // cmd is guaranteed non-empty from enqueue(), but safe anyway.
+            }
+            return ran;
+        }
+
+        bool run_one(CommandPriority priority)
         {
             RenderCommand cmd;
             {
                 std::lock_guard<std::mutex> lock(mutex_);
-                if (commands_.empty())
+                if (lane(priority).empty())
                     return false;
-                cmd = std::move(commands_.front());
-                commands_.pop();
+                cmd = std::move(lane(priority).front());
+                lane(priority).pop();
                 depth_.fetch_sub(1, std::memory_order_relaxed);
             }
             if (cmd) cmd();
             return true;
         }
 
-    private:
+        // Runs a budgeted lane until the deadline. The first command always
+        // runs so a lane cannot starve behind a tiny budget.
+        std::size_t run_lane_until(CommandPriority priority, Clock::time_point deadline, bool unlimited)
+        {
+            if (unlimited)
+                return run_lane(priority);
+
+            std::size_t ran = 0;
+            while ((ran == 0 || Clock::now() < deadline) && run_one(priority))
+                ++ran;
+            return ran;
+        }
+
+        bool drain_for(std::chrono::microseconds budget)
+        {
+            if (depth_.load(std::memory_order_relaxed) == 0)
+                return false;
+
+            const auto start = Clock::now();
+            const bool unlimited = budget.count() <= 0;
+            const auto deadline = start + budget;
+
+            std::size_t ran = run_lane(CommandPriority::PresentCritical);
+            ran += run_lane_until(CommandPriority::Upload, deadline, unlimited);
+            ran += run_lane(CommandPriority::Draw);
+            if (unlimited || Clock::now() < deadline)
+                ran += run_lane_until(CommandPriority::Background, deadline, unlimited);
+
+            if (ran == 0)
+                return false;
+
+            const auto elapsedNs = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+            last_drain_ns_.fetch_add(elapsedNs, std::memory_order_relaxed);
+            total_drain_ns_.fetch_add(elapsedNs, std::memory_order_relaxed);
+            total_commands_.fetch_add(ran, std::memory_order_relaxed);
+            total_drains_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
         mutable std::mutex mutex_;
-        std::queue<RenderCommand> commands_;
+        std::queue<RenderCommand> lanes_[kLaneCount];
         std::atomic_size_t depth_{ 0 };
+        std::atomic<std::uint64_t> last_drain_ns_{ 0 };
+        std::atomic<std::uint64_t> total_drain_ns_{ 0 };
+        std::atomic<std::uint64_t> total_commands_{ 0 };
+        std::atomic<std::uint64_t> total_drains_{ 0 };
+        std::atomic<std::int64_t> budget_us_{ 0 };
         std::uint8_t render_flags_{ 0 };
     };
 }
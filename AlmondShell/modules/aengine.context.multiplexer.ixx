@@ -19,12 +19,15 @@ module;
 
 export module aengine.context.multiplexer;
 
+import <algorithm>;
 import <atomic>;
+import <cstddef>;
 import <cstdint>;
 import <functional>;
 import <memory>;
 import <mutex>;
 import <queue>;
+import <shared_mutex>;
 import <thread>;
 import <unordered_map>;
 import <vector>;
@@ -35,6 +38,8 @@ import aengine.context.type;         // almondnamespace::core::ContextType
 import aengine.context.commandqueue; // almondnamespace::core::CommandQueue
 import aengine.context.window;       // almondnamespace::core::WindowData
 import aengine.core.context;         // almondnamespace::core::Context + Set/Get current render ctx
+import aengine.core.renderpool;      // almondnamespace::core::RenderWorkerPool
+import aengine.telemetry;            // telemetry::FrameRecord
 
 #if !defined(_WIN32)
 struct POINT { long x{}; long y{}; };
@@ -58,6 +63,124 @@ using HGLRC = void*;
 
 export namespace almondnamespace::core
 {
+    // Backends whose render loop may hop between worker threads. GL, SDL,
+    // SFML and Raylib bind a context to one thread and keep a dedicated one.
+    [[nodiscard]] constexpr bool render_pool_eligible(ContextType type) noexcept
+    {
+        return type == ContextType::Software
+            || type == ContextType::Noop
+            || type == ContextType::Vulkan;
+    }
+
+    // Stand-in native handle for a window with no OS window behind it
+    // (headless noop and software windows). Counts down from the top of the address
+    // space, clear of real HWNDs and X11 ids. Never pass it to the OS.
+    [[nodiscard]] inline HWND headless_window_handle(std::size_t index) noexcept
+    {
+        return reinterpret_cast<HWND>(~std::uintptr_t{ 0 } - index);
+    }
+
+    // Window records for InitializeHeadless on every platform: binds up to
+    // `count` contexts of `type` (the master first, then idle or freshly
+    // cloned duplicates) to synthetic handles. Stops early, possibly at zero,
+    // when that backend is not registered. The caller initializes the
+    // backend if it needs to, adds the windows to its list, republishes and
+    // launches their render loops.
+    [[nodiscard]] inline std::vector<std::shared_ptr<WindowData>> make_headless_windows(
+        int count, ContextType type = ContextType::Noop)
+    {
+        std::vector<std::shared_ptr<WindowData>> created;
+        created.reserve(static_cast<std::size_t>((std::max)(0, count)));
+
+        for (int i = 0; i < count; ++i)
+        {
+            std::shared_ptr<Context> ctx;
+            {
+                std::unique_lock lock(g_backendsMutex);
+                auto it = g_backends.find(type);
+                if (it == g_backends.end() || !it->second.master)
+                    break;
+
+                auto& state = it->second;
+                if (!state.master->windowData)
+                {
+                    ctx = state.master;
+                }
+                else
+                {
+                    auto dupIt = std::find_if(state.duplicates.begin(), state.duplicates.end(),
+                        [](const std::shared_ptr<Context>& dup) { return dup && !dup->windowData; });
+
+                    if (dupIt != state.duplicates.end()) ctx = *dupIt;
+                    else
+                    {
+                        ctx = CloneContext(*state.master);
+                        state.duplicates.push_back(ctx);
+                    }
+                }
+            }
+
+            const HWND hwnd = headless_window_handle(static_cast<std::size_t>(i));
+            ctx->type = type;
+            ctx->hwnd = hwnd;
+            ctx->native_window = hwnd;
+
+            auto win = std::make_shared<WindowData>(hwnd, nullptr, nullptr, false, type);
+            win->running = true;
+            win->context = ctx;
+            ctx->windowData = win.get();
+            created.push_back(std::move(win));
+        }
+        return created;
+    }
+
+    // Read-mostly index from native handle and Context to WindowData. It is
+    // rebuilt under windowsMutex whenever the window list or a context
+    // binding changes. Lookups do a single atomic load and a hash probe, and
+    // never take windowsMutex. The table shares ownership of its windows:
+    // callers that use a window after the lookup (possibly racing
+    // RemoveWindow) take acquire() and keep it alive for as long as they
+    // hold the pointer; find() is for callers already serialised with
+    // removal.
+    class WindowIndex
+    {
+    public:
+        struct Table
+        {
+            std::unordered_map<HWND, std::shared_ptr<WindowData>>          byHandle;
+            std::unordered_map<const Context*, std::shared_ptr<WindowData>> byContext;
+        };
+
+        std::shared_ptr<WindowData> acquire(HWND hwnd) const
+        {
+            if (!hwnd) return nullptr;
+            const auto table = current.load(std::memory_order_acquire);
+            if (!table) return nullptr;
+            auto it = table->byHandle.find(hwnd);
+            return it != table->byHandle.end() ? it->second : nullptr;
+        }
+
+        std::shared_ptr<WindowData> acquire(const Context* ctx) const
+        {
+            if (!ctx) return nullptr;
+            const auto table = current.load(std::memory_order_acquire);
+            if (!table) return nullptr;
+            auto it = table->byContext.find(ctx);
+            return it != table->byContext.end() ? it->second : nullptr;
+        }
+
+        WindowData* find(HWND hwnd) const { return acquire(hwnd).get(); }
+        WindowData* find(const Context* ctx) const { return acquire(ctx).get(); }
+
+        void publish(std::shared_ptr<const Table> next)
+        {
+            current.store(std::move(next), std::memory_order_release);
+        }
+
+    private:
+        std::atomic<std::shared_ptr<const Table>> current{};
+    };
+
 #if defined(_WIN32)
 
     export struct DragState
@@ -88,6 +211,11 @@ export namespace almondnamespace::core
             int SoftwareWinCount = 0,
             bool parented = true);
 
+        // Windows with synthetic handles and no OS window: noop for
+        // --headless-stress, software for --headless. Returns false when
+        // that backend is not built.
+        bool InitializeHeadless(int windowCount, ContextType type = ContextType::Noop);
+
         void StopAll();
         bool IsRunning() const noexcept;
         void StopRunning() noexcept;
@@ -110,7 +238,7 @@ export namespace almondnamespace::core
         void StartRenderThreads();
 
         HWND GetParentWindow() const { return parent; }
-        const std::vector<std::unique_ptr<WindowData>>& GetWindows() const { return windows; }
+        const std::vector<std::shared_ptr<WindowData>>& GetWindows() const { return windows; }
 
         using RenderCommand = std::function<void()>;
         void EnqueueRenderCommand(HWND hwnd, RenderCommand cmd);
@@ -133,7 +261,8 @@ export namespace almondnamespace::core
         const WindowData* findWindowByContext(const std::shared_ptr<core::Context>& ctx) const;
 
     private:
-        std::vector<std::unique_ptr<WindowData>> windows;
+        std::vector<std::shared_ptr<WindowData>> windows;
+        WindowIndex windowIndex;
         std::atomic<bool> running{ false };
         mutable std::recursive_mutex windowsMutex;
 
@@ -141,6 +270,13 @@ export namespace almondnamespace::core
         HWND  parent = nullptr;
 
         void RenderLoop(WindowData& win);
+        // Render loop pieces shared by dedicated threads and the worker pool.
+        bool InitializeRenderContext(WindowData& win);
+        bool RenderFrame(WindowData& win, telemetry::FrameRecord& record);
+        void ShutdownRenderContext(WindowData& win);
+        void LaunchRenderLoop(WindowData& win);
+        RenderWorkerPool::Handle SubmitPooledRenderLoop(WindowData& win);
+        void RebuildWindowIndex(); // caller holds windowsMutex
         void SetupPixelFormat(HDC hdc);
         HGLRC CreateSharedGLContext(HDC hdc);
         int get_title_bar_thickness(const HWND window_handle);
@@ -168,6 +304,8 @@ export namespace almondnamespace::core
             int SoftwareWinCount = 0,
             bool parented = false);
 
+        bool InitializeHeadless(int windowCount, ContextType type = ContextType::Noop);
+
         void StopAll();
         bool IsRunning() const noexcept;
         void StopRunning() noexcept;
@@ -184,7 +322,7 @@ export namespace almondnamespace::core
         void StartRenderThreads();
 
         HWND GetParentWindow() const { return nullptr; }
-        const std::vector<std::unique_ptr<WindowData>>& GetWindows() const { return windows; }
+        const std::vector<std::shared_ptr<WindowData>>& GetWindows() const { return windows; }
 
         void EnqueueRenderCommand(HWND hwnd, RenderCommand cmd);
 
@@ -198,11 +336,21 @@ export namespace almondnamespace::core
 
     private:
         void RenderLoop(WindowData& win);
+        // Render loop pieces shared by dedicated threads and the worker pool.
+        bool InitializeRenderContext(WindowData& win);
+        bool RenderFrame(WindowData& win, telemetry::FrameRecord& record);
+        void ShutdownRenderContext(WindowData& win);
+        void LaunchRenderLoop(WindowData& win);
+        RenderWorkerPool::Handle SubmitPooledRenderLoop(WindowData& win);
+        void RebuildWindowIndex(); // caller holds windowsMutex
         GLXContext CreateGLXContext();
         void DestroyWindowData(WindowData& win);
 
-        std::vector<std::unique_ptr<WindowData>> windows;
+        std::vector<std::shared_ptr<WindowData>> windows;
+        WindowIndex windowIndex;
         std::unordered_map<::Window, std::thread> threads;
+        std::unordered_map<::Window, RenderWorkerPool::Handle> pooledLoops;
+        std::unique_ptr<RenderWorkerPool> renderPool;
         std::atomic<bool> running{ true };
         mutable std::mutex windowsMutex;
 
@@ -233,6 +381,7 @@ export namespace almondnamespace::core
 
         static void ShowConsole() {}
         bool Initialize(HINSTANCE, int, int, int, int, int, bool) { return false; }
+        bool InitializeHeadless(int, ContextType = ContextType::Noop) { return false; }
         void StopAll() {}
         bool IsRunning() const noexcept { return false; }
         void StopRunning() noexcept {}
@@ -245,7 +394,7 @@ export namespace almondnamespace::core
         void HandleResize(HWND, int, int) {}
 
         HWND GetParentWindow() const { return nullptr; }
-        const std::vector<std::unique_ptr<WindowData>>& GetWindows() const { return s_emptyWindows; }
+        const std::vector<std::shared_ptr<WindowData>>& GetWindows() const { return s_emptyWindows; }
 
         void EnqueueRenderCommand(HWND, RenderCommand) {}
 
@@ -262,7 +411,7 @@ export namespace almondnamespace::core
         const WindowData* findWindowByContext(const std::shared_ptr<core::Context>&) const { return nullptr; }
 
     private:
-        inline static const std::vector<std::unique_ptr<WindowData>> s_emptyWindows{};
+        inline static const std::vector<std::shared_ptr<WindowData>> s_emptyWindows{};
     };
 
 #endif
@@ -43,6 +43,8 @@ module;
 
 export module aengine.context.window;
 
+import <atomic>;
+import <cstdint>;
 import <string>;
 import <string_view>;
 import <stdexcept>;
@@ -53,6 +55,7 @@ import <memory>;
 //import aframework;                    // if this imports SFML headers, NOMINMAX is already set
 import aengine.context.type;
 import aengine.context.commandqueue;
+import aengine.core.framepacer;
 
 export namespace almondnamespace::core
 {
@@ -85,6 +88,16 @@ export namespace almondnamespace::core
         std::shared_ptr<core::Context> context{};
         core::CommandQueue            commandQueue{};
 
+        // Paces this window's render thread. Left unconfigured, the render
+        // thread applies cli::pacing_config() when it starts; configure it
+        // before then for a per-window rate limit.
+        core::FramePacer              pacer{};
+
+        // Last present() issued through Context::present_safe on this
+        // window's render thread, in microseconds. Read by the render loop
+        // for frame telemetry.
+        std::atomic<std::uint32_t>    lastPresentUs{ 0 };
+
         bool running = false;
         bool usesSharedContext = false;
 
@@ -111,6 +124,11 @@ export namespace almondnamespace::core
             commandQueue.enqueue(std::move(cmd), path);
         }
 
+        void EnqueueCommand(RenderCommand cmd, core::CommandPriority priority)
+        {
+            commandQueue.enqueue(std::move(cmd), priority);
+        }
+
         inline static WindowData* s_instance = nullptr;
 
         WindowData() = default;
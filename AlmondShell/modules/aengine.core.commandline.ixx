@@ -6,6 +6,7 @@ export module aengine.core.commandline;
 
 import <algorithm>;
 import <cctype>;
+import <cstdint>;
 import <filesystem>;
 import <iostream>;
 import <optional>;
@@ -14,6 +15,7 @@ import <string_view>;
 
 //import aengine;
 import aengine.version;
+import aengine.core.framepacer;
 
 inline constexpr int DEFAULT_WINDOW_WIDTH = 1280;
 inline constexpr int DEFAULT_WINDOW_HEIGHT = 720;
@@ -30,6 +32,28 @@ export namespace almondnamespace::core::cli
     inline bool run_menu_loop = false;
     inline std::filesystem::path exe_path;
     inline std::optional<std::string> backend_filter;
+    inline double target_fps = 60.0;   // 0 = unlimited
+    inline double idle_fps = 0.0;      // 0 = no adaptive idle pacing
+    inline bool vsync = false;
+    inline int  drain_budget_us = 4000; // upload/background work per frame; 0 = unlimited
+    inline int  render_workers = 0;     // 0 = one render thread per window; -1 = pool sized to the CPU
+    inline int  headless_stress_windows = 0; // > 0 runs the noop stress mode instead of the normal loops
+    inline std::string stress_scene = "snake";
+    inline double stress_seconds = 10.0;
+    inline bool software_headless = false;        // software renderer draws offscreen, no window present
+    inline std::filesystem::path capture_directory; // non-empty streams software frames here as PPM
+    inline std::uint32_t capture_every = 1;
+
+    // Default pacing for the main loop and every render thread.
+    inline PacingConfig pacing_config() {
+        PacingConfig config{};
+        config.mode = target_fps <= 0.0 ? PacingMode::Unlimited
+            : vsync ? PacingMode::VSync
+            : PacingMode::TargetRate;
+        config.targetHz = target_fps;
+        config.idleHz = idle_fps;
+        return config;
+    }
 
     struct ParseResult {
         bool update_requested = false;
@@ -50,6 +74,8 @@ export namespace almondnamespace::core::cli
         window_width_overridden = false;
         window_height_overridden = false;
         backend_filter.reset();
+        software_headless = false;
+        capture_directory.clear();
         if (argc < 1) {
             std::cerr << "No command-line arguments provided.\n";
             return result;
@@ -90,7 +116,20 @@ export namespace almondnamespace::core::cli
                     "  --menu                Start the menu + games loop\n"
                     "  --update, -u          Check for a newer AlmondShell build\n"
                     "  --force               Apply the available update immediately\n"
-                    "  --backend <name>      Run a single backend (opengl|sdl|sfml|vulkan|software|raylib)\n";
+                    "  --backend <name>      Run a single backend (opengl|sdl|sfml|vulkan|software|raylib)\n"
+                    "  --fps <n>             Target frame rate per loop (0 = unlimited, default 60)\n"
+                    "  --vsync               Let presentation pace frames; --fps only caps runaway loops\n"
+                    "  --idle-fps <n>        Drop render threads to n fps while they have no work\n"
+                    "  --drain-budget <us>   Per-frame time for queued uploads/background work (0 = unlimited, default 4000)\n"
+                    "  --render-pool         Drive software/noop/Vulkan windows from a shared worker pool\n"
+                    "  --render-workers <n>  Same, with n pool workers\n"
+                    "  --headless-stress <n> Run a scene on n noop windows, uncapped, and report engine overhead\n"
+                    "  --stress-scene <name> Scene for --headless-stress (snake|tetris|pacman|frogger|sokoban|match3|\n"
+                    "                        puzzle|minesweeper|2048|sandsim|cellular, default snake)\n"
+                    "  --stress-seconds <s>  Length of the --headless-stress run (default 10)\n"
+                    "  --headless            Render the software backend offscreen (implies --backend software)\n"
+                    "  --capture <dir>       Stream presented software frames to <dir> as PPM files\n"
+                    "  --capture-every <n>   Keep only every nth frame for --capture (default 1)\n";
             }
             else if (arg == "--version"sv || arg == "-v"sv) {
                 print_engine_info();
@@ -124,6 +163,44 @@ export namespace almondnamespace::core::cli
             else if (arg == "--force"sv) {
                 result.force_update = true;
             }
+            else if (arg == "--fps"sv && i + 1 < argc) {
+                target_fps = (std::max)(0.0, std::stod(argv[++i]));
+            }
+            else if (arg == "--vsync"sv) {
+                vsync = true;
+            }
+            else if (arg == "--idle-fps"sv && i + 1 < argc) {
+                idle_fps = (std::max)(0.0, std::stod(argv[++i]));
+            }
+            else if (arg == "--drain-budget"sv && i + 1 < argc) {
+                drain_budget_us = (std::max)(0, std::stoi(argv[++i]));
+            }
+            else if (arg == "--render-pool"sv) {
+                render_workers = -1;
+            }
+            else if (arg == "--render-workers"sv && i + 1 < argc) {
+                render_workers = (std::max)(0, std::stoi(argv[++i]));
+            }
+            else if (arg == "--headless-stress"sv && i + 1 < argc) {
+                headless_stress_windows = (std::max)(0, std::stoi(argv[++i]));
+            }
+            else if (arg == "--stress-scene"sv && i + 1 < argc) {
+                stress_scene = argv[++i];
+            }
+            else if (arg == "--stress-seconds"sv && i + 1 < argc) {
+                stress_seconds = (std::max)(0.1, std::stod(argv[++i]));
+            }
+            else if (arg == "--headless"sv) {
+                software_headless = true;
+                if (!backend_filter)
+                    backend_filter = "software";
+            }
+            else if (arg == "--capture"sv && i + 1 < argc) {
+                capture_directory = argv[++i];
+            }
+            else if (arg == "--capture-every"sv && i + 1 < argc) {
+                capture_every = static_cast<std::uint32_t>((std::max)(1, std::stoi(argv[++i])));
+            }
             else if (arg == "--backend"sv && i + 1 < argc) {
                 const auto normalized = normalize_backend(argv[++i]);
                 if (!is_known_backend(normalized)) {
@@ -25,6 +25,7 @@ export module aengine.core.context;
 import <algorithm>;
 import <array>;
 import <atomic>;
+import <chrono>;
 import <cstdint>;
 import <functional>;
 import <map>;
@@ -206,7 +207,15 @@ export namespace almondnamespace::core
 
             if (auto cur = core::get_current_render_context(); cur && cur.get() == this)
             {
+                const auto start = std::chrono::steady_clock::now();
                 present();
+                if (windowData)
+                {
+                    windowData->lastPresentUs.store(static_cast<std::uint32_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start).count()),
+                        std::memory_order_relaxed);
+                }
                 return;
             }
 
@@ -398,4 +407,27 @@ export namespace almondnamespace::core
     std::shared_ptr<Context> CloneContext(const Context& prototype);
     void AddContextForBackend(core::ContextType type, std::shared_ptr<Context> context);
     bool ProcessAllContexts();
+
+    // ---------------------------------------------------------------------
+    // Context snapshot
+    // ---------------------------------------------------------------------
+    // Immutable copy of g_backends, republished whenever a context or window
+    // is added or removed. Frame loops keep the snapshot they hold and reload
+    // only when context_snapshot_version() moves on, so a steady-state frame
+    // costs one atomic load: no lock, no allocation, no refcount traffic.
+    struct ContextSnapshot
+    {
+        using Group = std::pair<core::ContextType, std::vector<std::shared_ptr<Context>>>;
+
+        std::uint64_t      version = 0;
+        std::vector<Group> groups;
+    };
+
+    void publish_context_snapshot();
+    std::uint64_t context_snapshot_version() noexcept;
+    std::shared_ptr<const ContextSnapshot> context_snapshot();
+
+    // Replaces `held` with the current snapshot if it is missing or stale.
+    // Returns true when `held` changed.
+    bool refresh_context_snapshot(std::shared_ptr<const ContextSnapshot>& held);
 } // namespace almondnamespace::core
@@ -0,0 +1,332 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ //
+ // aengine.core.framepacer.ixx
+ // Frame pacing for the main and render loops
+ //
+ // Frames are scheduled against absolute deadlines (previous deadline plus one
+ // period), so time spent rendering counts toward the period instead of being
+ // added to it. The wait sleeps until shortly before the deadline and spins
+ // the rest of the way; the spin window absorbs OS sleep granularity. A frame
+ // that misses its deadline by more than a period restarts the schedule
+ // rather than bursting to catch up.
+ //
+
+module;
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#   ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#       define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#   endif
+#endif
+
+export module aengine.core.framepacer;
+
+import <algorithm>;
+import <chrono>;
+import <cmath>;
+import <cstdint>;
+import <thread>;
+
+namespace almondnamespace::core::detail
+{
+#if defined(_WIN32)
+    // One high-resolution waitable timer per thread (Windows 10 1803+); plain
+    // Sleep() rounds up to the 15.6 ms system tick.
+    struct PacingTimer
+    {
+        HANDLE handle = ::CreateWaitableTimerExW(nullptr, nullptr,
+            CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+        ~PacingTimer()
+        {
+            if (handle) ::CloseHandle(handle);
+        }
+    };
+#endif
+
+    inline void coarse_sleep_until(std::chrono::steady_clock::time_point until)
+    {
+#if defined(_WIN32)
+        thread_local PacingTimer timer{};
+        const auto remaining = until - std::chrono::steady_clock::now();
+        if (timer.handle && remaining > std::chrono::steady_clock::duration::zero())
+        {
+            LARGE_INTEGER due{};
+            due.QuadPart = -static_cast<LONGLONG>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() / 100);
+            if (::SetWaitableTimerEx(timer.handle, &due, 0, nullptr, nullptr, nullptr, 0))
+            {
+                ::WaitForSingleObject(timer.handle, INFINITE);
+                return;
+            }
+        }
+#endif
+        std::this_thread::sleep_until(until);
+    }
+}
+
+export namespace almondnamespace::core
+{
+    enum class PacingMode : std::uint8_t
+    {
+        Unlimited,  // never wait
+        TargetRate, // sleep-then-spin to targetHz
+        VSync       // present blocks on the display; only cap runaway frames at targetHz
+    };
+
+#if defined(_WIN32)
+    inline constexpr std::chrono::microseconds kDefaultSpinWindow{ 2000 };
+#else
+    inline constexpr std::chrono::microseconds kDefaultSpinWindow{ 500 };
+#endif
+
+    struct PacingConfig
+    {
+        PacingMode mode = PacingMode::TargetRate;
+        double targetHz = 60.0;
+
+        // Adaptive idle: after `idleFrames` consecutive frames reported idle the
+        // loop drops to idleHz until work arrives again. 0 disables.
+        double idleHz = 0.0;
+        std::uint32_t idleFrames = 30;
+
+        // Final stretch before the deadline spent spinning instead of sleeping.
+        std::chrono::microseconds spinWindow = kDefaultSpinWindow;
+    };
+
+    struct PacingStats
+    {
+        std::uint64_t frames = 0;
+        std::uint64_t missedDeadlines = 0; // late by more than a period; schedule restarted
+        double lastErrorUs = 0.0;          // wake time minus deadline (positive = late)
+        double meanAbsErrorUs = 0.0;       // moving average of |lastErrorUs|
+        double maxErrorUs = 0.0;
+        double lastFrameUs = 0.0;          // wake-to-wake interval
+        double lastWorkUs = 0.0;           // wake to the following wait()
+        bool idle = false;
+    };
+
+    // Not thread-safe: configure and wait from the loop that owns it.
+    class FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        FramePacer() = default;
+        explicit FramePacer(const PacingConfig& config) { configure(config); }
+
+        void configure(const PacingConfig& config) noexcept
+        {
+            config_ = config;
+            configured_ = true;
+            reset();
+        }
+
+        void set_target_hz(double hz) noexcept
+        {
+            config_.targetHz = hz;
+            configured_ = true;
+            reset();
+        }
+
+        // Restart the schedule from the next wait (after stalls or mode changes).
+        void reset() noexcept
+        {
+            scheduled_ = false;
+            idleStreak_ = 0;
+            stats_.idle = false;
+        }
+
+        [[nodiscard]] bool is_configured() const noexcept { return configured_; }
+        [[nodiscard]] const PacingConfig& config() const noexcept { return config_; }
+        [[nodiscard]] const PacingStats& stats() const noexcept { return stats_; }
+
+        // Period currently in effect; zero when unpaced.
+        [[nodiscard]] Clock::duration period() const noexcept
+        {
+            double hz = config_.targetHz;
+            if (stats_.idle && config_.idleHz > 0.0)
+                hz = (std::min)(hz, config_.idleHz);
+
+            if (config_.mode == PacingMode::Unlimited || !(hz > 0.0))
+                return Clock::duration::zero();
+
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+        }
+
+        // End-of-frame wait. `idle` reports that the frame had nothing to do
+        // (no queued commands, no input), which feeds adaptive idle pacing.
+        void wait(bool idle = false)
+        {
+            const auto due = plan(idle);
+            if (Clock::now() < due)
+                sleep_until(due);
+            begin_frame();
+        }
+
+        // wait() whose coarse sleep can be cut short by input. `interrupt(until)`
+        // blocks until `until` or until events arrive, returning true for the
+        // latter. An early frame leaves the pending deadline in place, and at
+        // most one early frame is taken per deadline, so input never runs the
+        // loop faster than twice the target rate.
+        template <class Interrupt>
+        void wait(bool idle, Interrupt&& interrupt)
+        {
+            const auto due = plan(idle);
+            if (!earlyFrame_ && period() != Clock::duration::zero())
+            {
+                const auto coarse = due - config_.spinWindow;
+                if (Clock::now() < coarse && interrupt(coarse))
+                {
+                    begin_frame();
+                    return;
+                }
+            }
+
+            if (Clock::now() < due)
+                sleep_until(due);
+            begin_frame();
+        }
+
+        // Non-blocking half of wait() for loops that are scheduled rather
+        // than sleeping (the render worker pool): returns when the next frame
+        // should start. Call begin_frame() when it actually starts.
+        Clock::time_point plan(bool idle = false)
+        {
+            const auto now = Clock::now();
+            if (stats_.frames != 0)
+                stats_.lastWorkUs = to_us(now - lastWake_);
+
+            update_idle(idle, now);
+            planned_ = true;
+
+            const auto step = period();
+            if (step == Clock::duration::zero())
+                return planned_deadline(now);
+
+            if (!scheduled_)
+            {
+                deadline_ = now + step;
+                scheduled_ = true;
+            }
+            else if (!earlyFrame_)
+            {
+                // After an early (input-driven) frame the deadline still stands.
+                deadline_ += step;
+            }
+
+            if (now > deadline_ + step)
+            {
+                // Far behind: start over from now instead of rushing frames out.
+                ++stats_.missedDeadlines;
+                deadline_ = now;
+                return planned_deadline(now);
+            }
+
+            // VSync: present already waited for the display. Only frames
+            // arriving well ahead of schedule (vsync forced off) are held
+            // back; otherwise follow the display's phase.
+            if (config_.mode == PacingMode::VSync && !(now + step / 2 < deadline_))
+                deadline_ = now;
+
+            return planned_deadline(deadline_);
+        }
+
+        // Records the wake-up for the frame planned by the last plan().
+        void begin_frame() noexcept
+        {
+            if (!planned_)
+                return;
+            planned_ = false;
+            const auto wake = Clock::now();
+            earlyFrame_ = wake < plannedFor_;
+            record(wake, plannedFor_);
+        }
+
+    private:
+        static double to_us(Clock::duration d) noexcept
+        {
+            return std::chrono::duration<double, std::micro>(d).count();
+        }
+
+        void sleep_until(Clock::time_point deadline) const
+        {
+            const auto coarse = deadline - config_.spinWindow;
+            if (Clock::now() < coarse)
+                detail::coarse_sleep_until(coarse);
+
+            while (Clock::now() < deadline)
+                std::this_thread::yield();
+        }
+
+        Clock::time_point planned_deadline(Clock::time_point due) noexcept
+        {
+            plannedFor_ = due;
+            return due;
+        }
+
+        void update_idle(bool idle, Clock::time_point now) noexcept
+        {
+            idleStreak_ = idle ? idleStreak_ + 1 : 0;
+            const bool wasIdle = stats_.idle;
+            stats_.idle = config_.idleHz > 0.0 && idleStreak_ >= config_.idleFrames;
+
+            // Leaving idle: drop the long idle deadline so work is not delayed.
+            if (wasIdle && !stats_.idle && scheduled_)
+                deadline_ = now;
+        }
+
+        void record(Clock::time_point wake, Clock::time_point deadline) noexcept
+        {
+            const double error = to_us(wake - deadline);
+            stats_.lastErrorUs = error;
+            stats_.maxErrorUs = (std::max)(stats_.maxErrorUs, std::abs(error));
+            stats_.meanAbsErrorUs = stats_.frames == 0
+                ? std::abs(error)
+                : stats_.meanAbsErrorUs + (std::abs(error) - stats_.meanAbsErrorUs) * 0.05;
+            stats_.lastFrameUs = stats_.frames == 0 ? 0.0 : to_us(wake - lastWake_);
+            lastWake_ = wake;
+            ++stats_.frames;
+        }
+
+        PacingConfig config_{};
+        PacingStats stats_{};
+        Clock::time_point deadline_{};
+        Clock::time_point lastWake_{};
+        Clock::time_point plannedFor_{};
+        std::uint32_t idleStreak_ = 0;
+        bool scheduled_ = false;
+        bool planned_ = false;
+        bool earlyFrame_ = false;
+        bool configured_ = false;
+    };
+}
@@ -0,0 +1,235 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ //
+ // aengine.core.renderpool.ixx
+ // Shared worker pool for render loops that do not need thread affinity
+ //
+ // Each window is a job that renders one frame per step and returns when its
+ // next frame is due. Workers take the job with the earliest deadline, so the
+ // thread count scales with cores instead of windows. A job never runs on two
+ // workers at once, but successive frames may land on different workers.
+ //
+
+module;
+
+export module aengine.core.renderpool;
+
+import <algorithm>;
+import <atomic>;
+import <chrono>;
+import <condition_variable>;
+import <cstddef>;
+import <cstdint>;
+import <exception>;
+import <functional>;
+import <iostream>;
+import <memory>;
+import <mutex>;
+import <optional>;
+import <queue>;
+import <thread>;
+import <vector>;
+
+export namespace almondnamespace::core
+{
+    class RenderWorkerPool
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Renders one frame. Returns when the next frame is due, or nullopt
+        // once the loop has finished and torn down.
+        using FrameStep = std::function<std::optional<Clock::time_point>()>;
+
+        class Job
+        {
+        public:
+            [[nodiscard]] bool finished() const noexcept
+            {
+                return finished_.load(std::memory_order_acquire);
+            }
+
+            void wait()
+            {
+                std::unique_lock lock(mutex_);
+                done_.wait(lock, [this] { return finished(); });
+            }
+
+        private:
+            friend class RenderWorkerPool;
+
+            explicit Job(FrameStep step) : step_(std::move(step)) {}
+
+            void finish()
+            {
+                {
+                    std::scoped_lock lock(mutex_);
+                    finished_.store(true, std::memory_order_release);
+                }
+                done_.notify_all();
+            }
+
+            FrameStep step_;
+            std::atomic<bool> finished_{ false };
+            std::mutex mutex_;
+            std::condition_variable done_;
+        };
+
+        using Handle = std::shared_ptr<Job>;
+
+        // Deadline slack spent spinning rather than sleeping; condition
+        // variable timeouts are only as precise as the OS timer.
+#if defined(_WIN32)
+        static constexpr std::chrono::microseconds kSpinWindow{ 2000 };
+#else
+        static constexpr std::chrono::microseconds kSpinWindow{ 500 };
+#endif
+
+        static std::size_t default_worker_count() noexcept
+        {
+            const std::size_t hw = std::thread::hardware_concurrency();
+            return std::clamp<std::size_t>(hw / 2, 1, 8);
+        }
+
+        explicit RenderWorkerPool(std::size_t workerCount = default_worker_count())
+        {
+            workerCount = (std::max)(std::size_t{ 1 }, workerCount);
+            workers_.reserve(workerCount);
+            for (std::size_t i = 0; i < workerCount; ++i)
+                workers_.emplace_back([this] { worker_loop(); });
+        }
+
+        // Jobs still scheduled are abandoned and marked finished; stop the
+        // windows and wait() on their handles first for an orderly teardown.
+        ~RenderWorkerPool()
+        {
+            {
+                std::scoped_lock lock(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_all();
+
+            for (auto& worker : workers_)
+                if (worker.joinable()) worker.join();
+
+            while (!queue_.empty())
+            {
+                queue_.top().job->finish();
+                queue_.pop();
+            }
+        }
+
+        RenderWorkerPool(const RenderWorkerPool&) = delete;
+        RenderWorkerPool& operator=(const RenderWorkerPool&) = delete;
+
+        // Schedules `step` to run as soon as a worker is free.
+        Handle submit(FrameStep step)
+        {
+            Handle job{ new Job(std::move(step)) };
+            {
+                std::scoped_lock lock(mutex_);
+                queue_.push({ Clock::now(), nextSeq_++, job });
+            }
+            wake_.notify_one();
+            return job;
+        }
+
+        [[nodiscard]] std::size_t worker_count() const noexcept { return workers_.size(); }
+
+    private:
+        struct Entry
+        {
+            Clock::time_point due;
+            std::uint64_t seq = 0; // FIFO among equal deadlines
+            Handle job;
+
+            bool operator>(const Entry& other) const noexcept
+            {
+                return due != other.due ? due > other.due : seq > other.seq;
+            }
+        };
+
+        void worker_loop()
+        {
+            std::unique_lock lock(mutex_);
+            while (!stopping_)
+            {
+                if (queue_.empty())
+                {
+                    wake_.wait(lock);
+                    continue;
+                }
+
+                const auto due = queue_.top().due;
+                const auto now = Clock::now();
+                if (now + kSpinWindow < due)
+                {
+                    // Re-evaluate on wake: an earlier job may have arrived.
+                    wake_.wait_until(lock, due - kSpinWindow);
+                    continue;
+                }
+
+                Entry entry = queue_.top();
+                queue_.pop();
+                lock.unlock();
+
+                while (Clock::now() < entry.due)
+                    std::this_thread::yield();
+
+                std::optional<Clock::time_point> next;
+                try
+                {
+                    next = entry.job->step_();
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[RenderPool] Frame step threw: " << e.what() << '\n';
+                }
+                catch (...)
+                {
+                    std::cerr << "[RenderPool] Frame step threw an unknown exception\n";
+                }
+
+                lock.lock();
+                if (next)
+                {
+                    queue_.push({ *next, nextSeq_++, std::move(entry.job) });
+                    // Another worker may be sleeping towards a later deadline.
+                    wake_.notify_one();
+                }
+                else
+                {
+                    entry.job->finish();
+                }
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue_;
+        std::vector<std::thread> workers_;
+        std::uint64_t nextSeq_ = 0;
+        bool stopping_ = false;
+    };
+}
@@ -25,7 +25,9 @@ module;
 
 export module aengine.core.time;
 
+import <algorithm>;
 import <chrono>;
+import <cstdint>;
 import <format>;
 import <string>;
 import <string_view>;
@@ -133,6 +135,80 @@ export namespace almondnamespace
             t.timeScale = newScale;
         }
 
+        // ---------------------------------------------------------------------
+        // FIXED STEP
+        // ---------------------------------------------------------------------
+        // Simulation clock decoupled from rendering. Real time accumulates and
+        // is consumed in whole steps; alpha is the leftover fraction of a step,
+        // for interpolating between the last two simulated states. At most
+        // maxSteps run per advance: after a stall the excess is dropped rather
+        // than simulated, so slow steps can't snowball into longer frames.
+
+        export struct FixedStep
+        {
+            double step = 1.0 / 60.0;     // seconds per simulation tick
+            int    maxSteps = 5;          // per advance
+            double accumulator = 0.0;     // unsimulated seconds, < step after advance
+            double alpha = 0.0;           // accumulator / step
+            std::uint64_t ticks = 0;      // total steps handed out
+            double droppedSeconds = 0.0;  // time discarded by the maxSteps cap
+            Clock::time_point last{};
+            bool started = false;
+        };
+
+        export inline FixedStep createFixedStep(double hz = 60.0, int maxSteps = 5) noexcept
+        {
+            FixedStep s{};
+            s.step = hz > 0.0 ? 1.0 / hz : s.step;
+            s.maxSteps = (std::max)(1, maxSteps);
+            return s;
+        }
+
+        // Number of steps to simulate for realSeconds of wall time.
+        export inline int advanceFixed(FixedStep& s, double realSeconds) noexcept
+        {
+            s.accumulator += (std::max)(0.0, realSeconds);
+
+            auto steps = static_cast<std::int64_t>(s.accumulator / s.step);
+            if (steps > s.maxSteps)
+            {
+                const double dropped = static_cast<double>(steps - s.maxSteps) * s.step;
+                s.accumulator -= dropped;
+                s.droppedSeconds += dropped;
+                steps = s.maxSteps;
+            }
+
+            s.accumulator = (std::max)(0.0, s.accumulator - static_cast<double>(steps) * s.step);
+            s.alpha = (std::min)(1.0, s.accumulator / s.step);
+            s.ticks += static_cast<std::uint64_t>(steps);
+            return static_cast<int>(steps);
+        }
+
+        // advanceFixed against the wall clock; the first call only starts it.
+        export inline int tickFixed(FixedStep& s) noexcept
+        {
+            const auto now = Clock::now();
+            if (!s.started)
+            {
+                s.last = now;
+                s.started = true;
+                return 0;
+            }
+
+            const double real = std::chrono::duration<double>(now - s.last).count();
+            s.last = now;
+            return advanceFixed(s, real);
+        }
+
+        export inline void resetFixed(FixedStep& s) noexcept
+        {
+            s.accumulator = 0.0;
+            s.alpha = 0.0;
+            s.ticks = 0;
+            s.droppedSeconds = 0.0;
+            s.started = false;
+        }
+
         // ---------------------------------------------------------------------
         // REGISTRY
         // ---------------------------------------------------------------------
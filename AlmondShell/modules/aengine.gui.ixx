@@ -80,6 +80,38 @@ export namespace almondnamespace::gui
         EditBoxResult input{};
     };
 
+    // Per-window GUI state: mouse edges, caret blink and the focused widget.
+    // Frame state is thread-local, so a window updated on whichever worker
+    // thread is free binds its own state with WindowStateScope around
+    // begin_frame()/end_frame().
+    export class WindowState
+    {
+    public:
+        WindowState();
+        ~WindowState();
+        WindowState(WindowState&&) noexcept;
+        WindowState& operator=(WindowState&&) noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+
+        friend class WindowStateScope;
+    };
+
+    export class WindowStateScope
+    {
+    public:
+        explicit WindowStateScope(WindowState& state) noexcept;
+        ~WindowStateScope();
+
+        WindowStateScope(const WindowStateScope&) = delete;
+        WindowStateScope& operator=(const WindowStateScope&) = delete;
+
+    private:
+        WindowState& state_;
+    };
+
     export void push_input(const InputEvent& e) noexcept;
 
     export void begin_frame(const std::shared_ptr<core::Context>& ctx,
@@ -32,6 +32,7 @@ module;
 // -----------------------------------------------------------------------------
 export module aengine.platform;
 
+import <chrono>;
 import <string>;
 
 // -----------------------------------------------------------------------------
@@ -50,7 +51,16 @@ export namespace almondnamespace::platform
 {
 #if defined(__linux__)
     bool pump_events();
+
+    // Blocks until input is pending on the X connection, wake_event_loop()
+    // is called, or `until` passes. Returns false on timeout.
+    bool wait_events(std::chrono::steady_clock::time_point until);
+
+    // Wakes a wait_events() call from any thread.
+    void wake_event_loop() noexcept;
 #else
     inline bool pump_events() { return true; }
+    inline bool wait_events(std::chrono::steady_clock::time_point) { return false; }
+    inline void wake_event_loop() noexcept {}
 #endif
 }
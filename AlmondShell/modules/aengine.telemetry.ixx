@@ -2,11 +2,22 @@ module;
 
 export module aengine.telemetry;
 
+import <algorithm>;
+import <array>;
 import <atomic>;
+import <chrono>;
+import <condition_variable>;
+import <cstddef>;
 import <cstdint>;
+import <memory>;
+import <mutex>;
+import <stop_token>;
 import <string_view>;
+import <thread>;
+import <vector>;
 
 import aengine.context.type;
+import aengine.core.framepacer;
 
 export namespace almondnamespace::telemetry
 {
@@ -69,4 +80,194 @@ export namespace almondnamespace::telemetry
         if (auto* sink = get_renderer_telemetry_sink())
             sink->emit_histogram_ms(name, value_ms, tags);
     }
+
+    // Per-frame pacing metrics for a loop driven by core::FramePacer.
+    inline void emit_frame_pacing(std::string_view loop,
+        const core::PacingStats& stats,
+        const RendererTelemetryTags& tags) noexcept
+    {
+        auto* sink = get_renderer_telemetry_sink();
+        if (!sink || stats.frames == 0)
+            return;
+
+        RendererTelemetryTags tagged = tags;
+        tagged.detail = loop;
+        sink->emit_histogram_ms("frame_pacing.error_ms", stats.lastErrorUs / 1000.0, tagged);
+        sink->emit_histogram_ms("frame_pacing.interval_ms", stats.lastFrameUs / 1000.0, tagged);
+        sink->emit_histogram_ms("frame_pacing.work_ms", stats.lastWorkUs / 1000.0, tagged);
+        sink->emit_gauge("frame_pacing.missed_deadlines", static_cast<std::int64_t>(stats.missedDeadlines), tagged);
+    }
+
+    // ─── Render-loop frame records ──────────────────────────────────────
+    // Render threads describe each frame with a FrameRecord pushed into a
+    // per-window ring. Pushing takes no lock and never calls the sink. A
+    // background thread drains every registered ring in batches and emits
+    // the records to the installed sink.
+    struct FrameRecord
+    {
+        std::uint32_t queueDepth = 0;     // commands waiting when the frame began
+        float drainUs = 0.0f;             // last CommandQueue::drain() that ran work
+        float processUs = 0.0f;           // whole backend process call
+        float presentUs = 0.0f;           // 0 when the backend presents internally
+        float pacingErrorUs = 0.0f;
+        float intervalUs = 0.0f;
+        float workUs = 0.0f;
+        std::uint32_t missedDeadlines = 0;
+    };
+
+    // Single producer (the render thread), single consumer (the emitter).
+    // A full ring drops the new record and counts it rather than stall the
+    // render thread.
+    class FrameRecordRing
+    {
+    public:
+        static constexpr std::size_t kCapacity = 256;
+
+        explicit FrameRecordRing(RendererTelemetryTags tags) noexcept : tags_(tags) {}
+
+        void push(const FrameRecord& record) noexcept
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) >= kCapacity)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            records_[head % kCapacity] = record;
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        template <typename Fn>
+        std::size_t consume(Fn&& fn)
+        {
+            auto tail = tail_.load(std::memory_order_relaxed);
+            const auto head = head_.load(std::memory_order_acquire);
+            const auto count = static_cast<std::size_t>(head - tail);
+            for (; tail != head; ++tail)
+                fn(records_[tail % kCapacity]);
+            tail_.store(head, std::memory_order_release);
+            return count;
+        }
+
+        std::uint64_t take_dropped() noexcept
+        {
+            return dropped_.exchange(0, std::memory_order_relaxed);
+        }
+
+        const RendererTelemetryTags& tags() const noexcept { return tags_; }
+
+    private:
+        RendererTelemetryTags tags_{};
+        std::array<FrameRecord, kCapacity> records_{};
+        alignas(64) std::atomic<std::uint64_t> head_{ 0 };
+        alignas(64) std::atomic<std::uint64_t> tail_{ 0 };
+        std::atomic<std::uint64_t> dropped_{ 0 };
+    };
+
+    namespace detail
+    {
+        inline void emit_frame_record(RendererTelemetrySink& sink,
+            const FrameRecord& r,
+            const RendererTelemetryTags& tags)
+        {
+            sink.emit_gauge("renderer.command_queue.depth", static_cast<std::int64_t>(r.queueDepth), tags);
+            sink.emit_histogram_ms("renderer.frame.process_ms", r.processUs / 1000.0, tags);
+            if (r.drainUs > 0.0f)
+                sink.emit_histogram_ms("renderer.frame.drain_ms", r.drainUs / 1000.0, tags);
+            if (r.presentUs > 0.0f)
+                sink.emit_histogram_ms("renderer.frame.present_ms", r.presentUs / 1000.0, tags);
+
+            if (r.intervalUs > 0.0f)
+            {
+                RendererTelemetryTags pacing = tags;
+                pacing.detail = "render";
+                sink.emit_histogram_ms("frame_pacing.error_ms", r.pacingErrorUs / 1000.0, pacing);
+                sink.emit_histogram_ms("frame_pacing.interval_ms", r.intervalUs / 1000.0, pacing);
+                sink.emit_histogram_ms("frame_pacing.work_ms", r.workUs / 1000.0, pacing);
+                sink.emit_gauge("frame_pacing.missed_deadlines", static_cast<std::int64_t>(r.missedDeadlines), pacing);
+            }
+        }
+
+        class FrameRecordEmitter
+        {
+        public:
+            static constexpr auto kFlushInterval = std::chrono::milliseconds(100);
+
+            void add(std::shared_ptr<FrameRecordRing> ring)
+            {
+                std::scoped_lock lock(mutex_);
+                rings_.push_back(std::move(ring));
+                if (!worker_.joinable())
+                    worker_ = std::jthread([this](std::stop_token stop) { run(stop); });
+            }
+
+            // Flushes what the ring still holds so a closing window's last
+            // frames are not lost.
+            void remove(const std::shared_ptr<FrameRecordRing>& ring)
+            {
+                std::scoped_lock lock(mutex_);
+                flush(*ring);
+                std::erase(rings_, ring);
+            }
+
+        private:
+            void run(std::stop_token stop)
+            {
+                std::unique_lock lock(mutex_);
+                while (!stop.stop_requested())
+                {
+                    wake_.wait_for(lock, stop, kFlushInterval, [] { return false; });
+                    for (auto& ring : rings_)
+                        flush(*ring);
+                }
+            }
+
+            // Caller holds mutex_.
+            static void flush(FrameRecordRing& ring)
+            {
+                auto* sink = get_renderer_telemetry_sink();
+                const auto& tags = ring.tags();
+                ring.consume([&](const FrameRecord& r)
+                    {
+                        if (sink) emit_frame_record(*sink, r, tags);
+                    });
+
+                if (const auto dropped = ring.take_dropped(); dropped && sink)
+                    sink->emit_counter("renderer.frame.records_dropped", static_cast<std::int64_t>(dropped), tags);
+            }
+
+            std::mutex mutex_;
+            std::condition_variable_any wake_;
+            std::vector<std::shared_ptr<FrameRecordRing>> rings_;
+            std::jthread worker_; // last member: stopped and joined first
+        };
+
+        inline FrameRecordEmitter& frame_record_emitter()
+        {
+            static FrameRecordEmitter emitter;
+            return emitter;
+        }
+    }
+
+    // Creates a ring for one render loop and hands it to the emitter.
+    inline std::shared_ptr<FrameRecordRing> register_frame_records(const RendererTelemetryTags& tags)
+    {
+        auto ring = std::make_shared<FrameRecordRing>(tags);
+        detail::frame_record_emitter().add(ring);
+        return ring;
+    }
+
+    inline void unregister_frame_records(const std::shared_ptr<FrameRecordRing>& ring)
+    {
+        if (ring) detail::frame_record_emitter().remove(ring);
+    }
+
+    inline void fill_pacing(FrameRecord& record, const core::PacingStats& stats) noexcept
+    {
+        if (stats.frames == 0) return;
+        record.pacingErrorUs = static_cast<float>(stats.lastErrorUs);
+        record.intervalUs = static_cast<float>(stats.lastFrameUs);
+        record.workUs = static_cast<float>(stats.lastWorkUs);
+        record.missedDeadlines = static_cast<std::uint32_t>(stats.missedDeadlines);
+    }
 }
@@ -12,6 +12,8 @@ import <stdexcept>;
 import <string>;
 import <vector>;
 
+import apixel.convert;
+
 export namespace almondnamespace
 {
     struct ImageData
@@ -25,6 +27,20 @@ export namespace almondnamespace
             : pixels(std::move(p)), width(w), height(h), channels(c) {}
     };
 
+    namespace detail
+    {
+        // BMP/TGA store BGR(A) rows; widen/swizzle one row to RGBA8.
+        inline void bgr_row_to_rgba8(const uint8_t* src, uint8_t* dst, int w, int ch)
+        {
+            if (ch == 4)
+                pixel::swap_red_blue(src, dst, std::size_t(w));
+            else if (ch == 3)
+                pixel::bgr8_to_rgba8(src, dst, std::size_t(w));
+            else
+                throw std::runtime_error("Unsupported BGR pixel size: " + std::to_string(ch));
+        }
+    }
+
     inline void a_listSupportedImageTypes()
     {
         std::cout << "Supported image types: BMP, TGA, PPM\n";
@@ -73,14 +89,8 @@ export namespace almondnamespace
         std::vector<uint8_t> out(size_t(w) * size_t(h) * 4);
         for (int y = 0; y < h; ++y) {
             int srcY = flipVertically ? (h - 1 - y) : y;
-            for (int x = 0; x < w; ++x) {
-                int srcIdx = (srcY * w + x) * ch;
-                int dstIdx = (y * w + x) * 4;
-                out[dstIdx + 0] = raw[srcIdx + 2];
-                out[dstIdx + 1] = raw[srcIdx + 1];
-                out[dstIdx + 2] = raw[srcIdx + 0];
-                out[dstIdx + 3] = (ch == 4) ? raw[srcIdx + 3] : 255;
-            }
+            detail::bgr_row_to_rgba8(raw.data() + size_t(srcY) * w * ch,
+                out.data() + size_t(y) * w * 4, w, ch);
         }
 
         return ImageData(std::move(out), w, h, 4);
@@ -141,14 +151,8 @@ export namespace almondnamespace
             if (originTopLeft)
                 srcY = h - 1 - srcY;
 
-            for (int x = 0; x < w; ++x) {
-                int srcIdx = (srcY * w + x) * ch;
-                int dstIdx = (y * w + x) * 4;
-                out[dstIdx + 0] = raw[srcIdx + 2];
-                out[dstIdx + 1] = raw[srcIdx + 1];
-                out[dstIdx + 2] = raw[srcIdx + 0];
-                out[dstIdx + 3] = (ch == 4) ? raw[srcIdx + 3] : 255;
-            }
+            detail::bgr_row_to_rgba8(raw.data() + size_t(srcY) * w * ch,
+                out.data() + size_t(y) * w * 4, w, ch);
         }
 
         return ImageData(std::move(out), static_cast<int>(w), static_cast<int>(h), 4);
@@ -218,15 +222,8 @@ export namespace almondnamespace
         for (int y = 0; y < h; ++y)
         {
             const int srcY = flipVertically ? (h - 1 - y) : y;
-            for (int x = 0; x < w; ++x)
-            {
-                const int srcIdx = (srcY * w + x) * 3;
-                const int dstIdx = (y * w + x) * 4;
-                out[dstIdx + 0] = raw[srcIdx + 0];
-                out[dstIdx + 1] = raw[srcIdx + 1];
-                out[dstIdx + 2] = raw[srcIdx + 2];
-                out[dstIdx + 3] = 255;
-            }
+            pixel::rgb8_to_rgba8(raw.data() + std::size_t(srcY) * std::size_t(w) * 3,
+                out.data() + std::size_t(y) * std::size_t(w) * 4, std::size_t(w));
         }
 
         return ImageData(std::move(out), w, h, 4);
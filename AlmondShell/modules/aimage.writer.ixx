@@ -10,6 +10,8 @@ import <string>;
 import <vector>;
 import <iostream>;
 
+import apixel.convert;
+
 export namespace almondnamespace
 {
     inline bool a_writeBMP(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height, bool flipVertically)
@@ -100,18 +102,14 @@ export namespace almondnamespace
 
         out.write(reinterpret_cast<const char*>(header), sizeof(header));
 
+        std::vector<uint8_t> row(size_t(width) * channels);
         for (int y = 0; y < height; ++y)
         {
             int srcY = flipVertically ? (height - 1 - y) : y;
             const uint8_t* srcRow = pixels.data() + size_t(srcY) * width * channels;
 
-            for (int x = 0; x < width; ++x)
-            {
-                out.put(static_cast<char>(srcRow[x * channels + 2])); // B
-                out.put(static_cast<char>(srcRow[x * channels + 1])); // G
-                out.put(static_cast<char>(srcRow[x * channels + 0])); // R
-                out.put(static_cast<char>(srcRow[x * channels + 3])); // A
-            }
+            pixel::swap_red_blue(srcRow, row.data(), size_t(width)); // RGBA -> BGRA
+            out.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
         }
         return true;
     }
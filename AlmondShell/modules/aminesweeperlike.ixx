@@ -11,7 +11,7 @@ import aengine.context.window;    // WindowData
 import aengine.input;             // input
 import agamecore;                 // grid helpers
 import aatlas.manager;            // atlas manager
-import aimage.loader;             // a_loadImage / ImageData
+import aatlas.cache;              // atlascache::load_or_bake
 import aspritehandle;             // SpriteHandle
 import asprite.pool;              // spritepool
 import ascene;                    // scene::Scene
@@ -29,6 +29,7 @@ import <algorithm>;
 import <chrono>;
 import <cstddef>;
 import <cstdint>;
+import <optional>;
 import <random>;
 import <span>;
 import <stdexcept>;
@@ -98,23 +99,19 @@ export namespace almondnamespace::minesweeperlike
             state = {};
             gameOver = false;
             mouseWasDown = false;
+            pendingClick.reset();
         }
 
-        bool frame(std::shared_ptr<core::Context> ctx, core::WindowData*) override
+        // One call per engine tick: reveals the cell clicked in whichever
+        // window render() saw the press in.
+        bool update(double) override
         {
-            if (!ctx) return false;
-
-            if (ctx->is_key_down_safe(input::Key::Escape))
-                return false;
+            if (gameOver || state.all_clear()) return false;
 
-            int mx = 0, my = 0;
-            ctx->get_mouse_position_safe(mx, my);
-            const bool mouseDown = ctx->is_mouse_button_down_safe(input::MouseButton::MouseLeft);
-
-            if (mouseDown && !mouseWasDown)
+            if (pendingClick)
             {
-                const int gx = int(mx / (float(ctx->get_width_safe()) / GRID_W));
-                const int gy = int(my / (float(ctx->get_height_safe()) / GRID_H));
+                const auto [gx, gy] = *pendingClick;
+                pendingClick.reset();
 
                 if (gamecore::in_bounds(GRID_W, GRID_H, gx, gy))
                 {
@@ -145,6 +142,28 @@ export namespace almondnamespace::minesweeperlike
                 }
             }
 
+            return !gameOver && !state.all_clear();
+        }
+
+        bool render(std::shared_ptr<core::Context> ctx, core::WindowData*, double) override
+        {
+            if (!ctx) return false;
+
+            if (ctx->is_key_down_safe(input::Key::Escape))
+                return false;
+
+            int mx = 0, my = 0;
+            ctx->get_mouse_position_safe(mx, my);
+            const bool mouseDown = ctx->is_mouse_button_down_safe(input::MouseButton::MouseLeft);
+
+            // Cells are sized per window, so map the click here.
+            if (mouseDown && !mouseWasDown)
+            {
+                pendingClick = std::pair{
+                    int(mx / (float(ctx->get_width_safe()) / GRID_W)),
+                    int(my / (float(ctx->get_height_safe()) / GRID_H)) };
+            }
+
             mouseWasDown = mouseDown;
 
             ctx->clear_safe();
@@ -181,12 +200,19 @@ export namespace almondnamespace::minesweeperlike
             return true;
         }
 
+        // Standalone loop (run_minesweeper): one tick per frame.
+        bool frame(std::shared_ptr<core::Context> ctx, core::WindowData* win) override
+        {
+            return render(ctx, win, 0.0) && update(FRAME_STEP_S);
+        }
+
         void unload() override
         {
             Scene::unload();
             sprites.clear();
             gameOver = false;
             mouseWasDown = false;
+            pendingClick.reset();
         }
 
     private:
@@ -205,43 +231,22 @@ export namespace almondnamespace::minesweeperlike
                 throw std::runtime_error("[Minesweeper] Missing atlas registrar");
 
             TextureAtlas& atlas = registrar->atlas;
-            bool registeredSprite = false;
-
-            auto ensureSprite = [&](std::string_view id)
-            {
-                std::string name(id);
-
-                if (auto existing = atlasmanager::registry.get(name))
-                {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle))
-                    {
-                        sprites[name] = handle;
-                        return;
-                    }
-                }
-
-                auto img = a_loadImage("assets/games/minesweeperlike/" + name + ".ppm", false);
-                if (img.pixels.empty())
-                    throw std::runtime_error("[Minesweeper] Missing image " + name);
-
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    name, img.pixels, img.width, img.height, atlas);
-
-                if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                    throw std::runtime_error("[Minesweeper] Failed to register sprite " + name);
-
-                sprites[name] = *handleOpt;
-                registeredSprite = true;
-            };
 
+            std::vector<atlascache::SpriteSource> sources{};
             for (int i = 0; i <= 8; ++i)
-                ensureSprite(std::to_string(i));
+                sources.push_back({ std::to_string(i), "assets/games/minesweeperlike/" + std::to_string(i) + ".ppm" });
+            for (std::string_view id : { "covered", "mine" })
+                sources.push_back({ std::string(id), "assets/games/minesweeperlike/" + std::string(id) + ".ppm" });
 
-            ensureSprite("covered");
-            ensureSprite("mine");
+            const auto baked = atlascache::load_or_bake(*registrar, sources);
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                if (!baked.handles[i] || !spritepool::is_alive(*baked.handles[i]))
+                    throw std::runtime_error("[Minesweeper] Missing image " + sources[i].name);
+                sprites[sources[i].name] = *baked.handles[i];
+            }
 
-            if (createdAtlas || registeredSprite)
+            if (createdAtlas || baked.changed)
             {
                 atlas.rebuild_pixels();
                 atlasmanager::ensure_uploaded(atlas);
@@ -252,6 +257,11 @@ export namespace almondnamespace::minesweeperlike
         std::unordered_map<std::string, SpriteHandle> sprites{};
         bool gameOver = false;
         bool mouseWasDown = false;
+
+        static constexpr double FRAME_STEP_S = 1.0 / 60.0;
+
+        // Grid cell of a click seen by render() since the last tick.
+        std::optional<std::pair<int, int>> pendingClick{};
     };
 
     export bool run_minesweeper(std::shared_ptr<core::Context> ctx)
@@ -10,7 +10,7 @@ import aengine.context.window;    // core::WindowData
 import aengine.input;             // input::Key
 import agamecore;                 // grid helpers
 import aatlas.manager;            // atlas manager + registry
-import aimage.loader;             // a_loadImage / ImageData
+import aatlas.cache;              // atlascache::load_or_bake
 import aspritehandle;             // SpriteHandle
 import asprite.pool;              // spritepool
 import ascene;                    // scene::Scene
@@ -34,6 +34,7 @@ import <string>;
 import <string_view>;
 import <tuple>;
 import <utility>;
+import <vector>;
 
 export namespace almondnamespace::pacmanlike
 {
@@ -94,20 +95,21 @@ export namespace almondnamespace::pacmanlike
             won = false;
         }
 
-        bool frame(std::shared_ptr<core::Context> ctx, core::WindowData*) override
+        // One call per engine tick: the keys latched by render() move
+        // Pac-Man at most one cell, however many windows show the scene.
+        bool update(double) override
         {
-            if (!ctx) return false;
-
-            if (ctx->is_key_down_safe(input::Key::Escape))
-                return false;
+            if (won) return false;
 
             int nx = state.px;
             int ny = state.py;
 
-            if (ctx->is_key_down_safe(input::Key::Left))  --nx;
-            if (ctx->is_key_down_safe(input::Key::Right)) ++nx;
-            if (ctx->is_key_down_safe(input::Key::Up))    --ny;
-            if (ctx->is_key_down_safe(input::Key::Down))  ++ny;
+            if (intent.left)  --nx;
+            if (intent.right) ++nx;
+            if (intent.up)    --ny;
+            if (intent.down)  ++ny;
+
+            intent = {};
 
             if (gamecore::in_bounds(GRID_W, GRID_H, nx, ny) &&
                 state.map[gamecore::idx(GRID_W, nx, ny)] != WALL)
@@ -123,6 +125,20 @@ export namespace almondnamespace::pacmanlike
                         won = true;
                 }
             }
+            return !won;
+        }
+
+        bool render(std::shared_ptr<core::Context> ctx, core::WindowData*, double) override
+        {
+            if (!ctx) return false;
+
+            if (ctx->is_key_down_safe(input::Key::Escape))
+                return false;
+
+            intent.left = intent.left || ctx->is_key_down_safe(input::Key::Left);
+            intent.right = intent.right || ctx->is_key_down_safe(input::Key::Right);
+            intent.up = intent.up || ctx->is_key_down_safe(input::Key::Up);
+            intent.down = intent.down || ctx->is_key_down_safe(input::Key::Down);
 
             // Your Context::clear_safe() takes no args (per the error log).
             ctx->clear_safe();
@@ -164,10 +180,17 @@ export namespace almondnamespace::pacmanlike
             return !won;
         }
 
+        // Standalone loop (run_pacman): one tick per frame.
+        bool frame(std::shared_ptr<core::Context> ctx, core::WindowData* win) override
+        {
+            return render(ctx, win, 0.0) && update(FRAME_STEP_S);
+        }
+
         void unload() override
         {
             Scene::unload();
             state = {};
+            intent = {};
             won = false;
         }
 
@@ -186,47 +209,38 @@ export namespace almondnamespace::pacmanlike
                 throw std::runtime_error("[Pacman] Failed to get atlas registrar");
 
             TextureAtlas& atlas = registrar->atlas;
-            bool registeredAny = false;
-
-            auto ensureSprite = [&](std::string_view name, SpriteHandle& outHandle)
-                {
-                    // Reuse cached sprite if it already exists and is alive.
-                    if (auto existing = atlasmanager::registry.get(std::string(name)))
-                    {
-                        auto handle = std::get<0>(*existing);
-                        if (spritepool::is_alive(handle))
-                        {
-                            outHandle = handle;
-                            return;
-                        }
-                    }
-
-                    auto img = a_loadImage("assets/games/apacmanlike/" + std::string(name) + ".ppm", false);
-                    if (img.pixels.empty())
-                        throw std::runtime_error("[Pacman] Failed to load image '" + std::string(name) + "'");
-
-                    auto handleOpt = registrar->register_atlas_sprites_by_image(
-                        std::string(name), img.pixels, img.width, img.height, atlas);
 
-                    if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                        throw std::runtime_error("[Pacman] Failed to register sprite '" + std::string(name) + "'");
+            SpriteHandle* const outHandles[]{ &pacmanHandle, &ghostHandle, &pelletHandle, &wallHandle };
+            std::vector<atlascache::SpriteSource> sources{};
+            for (std::string_view name : { "pacman", "ghost", "pellet", "wall" })
+                sources.push_back({ std::string(name), "assets/games/apacmanlike/" + std::string(name) + ".ppm" });
 
-                    outHandle = *handleOpt;
-                    registeredAny = true;
-                };
-
-            ensureSprite("pacman", pacmanHandle);
-            ensureSprite("ghost", ghostHandle);
-            ensureSprite("pellet", pelletHandle);
-            ensureSprite("wall", wallHandle);
+            const auto baked = atlascache::load_or_bake(*registrar, sources);
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                if (!baked.handles[i] || !spritepool::is_alive(*baked.handles[i]))
+                    throw std::runtime_error("[Pacman] Failed to load image '" + sources[i].name + "'");
+                *outHandles[i] = *baked.handles[i];
+            }
 
-            if (createdAtlas || registeredAny)
+            if (createdAtlas || baked.changed)
             {
                 atlas.rebuild_pixels();
                 atlasmanager::ensure_uploaded(atlas);
             }
         }
 
+        static constexpr double FRAME_STEP_S = 1.0 / 60.0;
+
+        // Keys seen by render() since the last tick.
+        struct Intent
+        {
+            bool left = false;
+            bool right = false;
+            bool up = false;
+            bool down = false;
+        } intent;
+
         GameState state{};
         SpriteHandle pacmanHandle{};
         SpriteHandle ghostHandle{};
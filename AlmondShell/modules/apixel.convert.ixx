@@ -0,0 +1,636 @@
+/**************************************************************
+ *   AlmondShell - Modular C++ Framework
+ **************************************************************/
+
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   define ALMOND_PIXEL_X86 1
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#       define ALMOND_PIXEL_TARGET(isa)
+#   else
+#       define ALMOND_PIXEL_TARGET(isa) __attribute__((target(isa)))
+#   endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#   define ALMOND_PIXEL_NEON 1
+#   include <arm_neon.h>
+#endif
+
+export module apixel.convert;
+
+import <atomic>;
+
+// ────────────────────────────────────────────────────────────
+// Pixel format conversion + compositing kernels
+//
+// Shared by atlas uploads, the software renderer and the image loaders/
+// writers. Every kernel processes a run of `count` pixels; callers handle
+// strides and flips row by row. Kernels are picked once at runtime from the
+// best instruction set the CPU supports, with a scalar fallback for the
+// tails and for unsupported targets. Byte orders are memory orders:
+// "ARGB32" is the software framebuffer's packed 0xAARRGGBB, i.e. B,G,R,A
+// bytes on the little-endian targets we ship.
+// ────────────────────────────────────────────────────────────
+
+export namespace almondnamespace::pixel
+{
+    using u8 = std::uint8_t;
+    using u32 = std::uint32_t;
+
+    enum class SimdLevel : int
+    {
+        Scalar = 0,
+        SSE2,
+        SSSE3,
+        AVX2,
+        NEON
+    };
+
+    [[nodiscard]] constexpr const char* to_string(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+        case SimdLevel::SSE2:  return "SSE2";
+        case SimdLevel::SSSE3: return "SSSE3";
+        case SimdLevel::AVX2:  return "AVX2";
+        case SimdLevel::NEON:  return "NEON";
+        default:               return "Scalar";
+        }
+    }
+
+    [[nodiscard]] inline SimdLevel detect_simd_level() noexcept
+    {
+#if defined(ALMOND_PIXEL_X86)
+#   if defined(_MSC_VER) && !defined(__clang__)
+        int info[4]{};
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        const bool sse2 = (info[3] & (1 << 26)) != 0;
+        const bool ssse3 = (info[2] & (1 << 9)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avxOs = osxsave && ((_xgetbv(0) & 0x6) == 0x6);
+
+        bool avx2 = false;
+        if (maxLeaf >= 7 && avxOs)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#   else
+        __builtin_cpu_init();
+        const bool sse2 = __builtin_cpu_supports("sse2");
+        const bool ssse3 = __builtin_cpu_supports("ssse3");
+        const bool avx2 = __builtin_cpu_supports("avx2");
+#   endif
+        if (avx2)  return SimdLevel::AVX2;
+        if (ssse3) return SimdLevel::SSSE3;
+        if (sse2)  return SimdLevel::SSE2;
+        return SimdLevel::Scalar;
+#elif defined(ALMOND_PIXEL_NEON)
+        return SimdLevel::NEON;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    // ────────────────────────────────────────────────────────
+    // Scalar kernels (also used for the tails of the SIMD loops)
+    // ────────────────────────────────────────────────────────
+
+    namespace scalar
+    {
+        // RGBA <-> BGRA (R/B swap, alpha kept). src may equal dst.
+        inline void swap_rb_32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                u32 p;
+                std::memcpy(&p, src + i * 4, 4);
+                p = (p & 0xFF00FF00u) | ((p >> 16) & 0xFFu) | ((p & 0xFFu) << 16);
+                std::memcpy(dst + i * 4, &p, 4);
+            }
+        }
+
+        inline void rgb24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                dst[i * 4 + 0] = src[i * 3 + 0];
+                dst[i * 4 + 1] = src[i * 3 + 1];
+                dst[i * 4 + 2] = src[i * 3 + 2];
+                dst[i * 4 + 3] = 255;
+            }
+        }
+
+        inline void bgr24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                dst[i * 4 + 0] = src[i * 3 + 2];
+                dst[i * 4 + 1] = src[i * 3 + 1];
+                dst[i * 4 + 2] = src[i * 3 + 0];
+                dst[i * 4 + 3] = 255;
+            }
+        }
+
+        // Exact x * a / 255 with rounding.
+        [[nodiscard]] constexpr u8 mul_div255(u32 x, u32 a) noexcept
+        {
+            const u32 t = x * a + 128u;
+            return static_cast<u8>((t + (t >> 8)) >> 8);
+        }
+
+        // Multiplies the three colour channels by alpha (byte 3). Works for
+        // both RGBA and BGRA memory orders.
+        inline void premultiply_alpha32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const u32 a = src[i * 4 + 3];
+                dst[i * 4 + 0] = mul_div255(src[i * 4 + 0], a);
+                dst[i * 4 + 1] = mul_div255(src[i * 4 + 1], a);
+                dst[i * 4 + 2] = mul_div255(src[i * 4 + 2], a);
+                dst[i * 4 + 3] = static_cast<u8>(a);
+            }
+        }
+
+        // Premultiplied "over": dst = src + dst * (255 - src.a) / 255, all four
+        // channels. Alpha is byte 3, so either memory order works. The product
+        // is rounded on its own (after premultiply rounded src), so results can
+        // sit one step off a single-rounded blend. Sums saturate at 255 like
+        // the SIMD kernels, which only matters for non-premultiplied input.
+        inline void blend_over32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const u32 inv = 255u - src[i * 4 + 3];
+                for (int c = 0; c < 4; ++c)
+                {
+                    const u32 sum = src[i * 4 + c] + mul_div255(dst[i * 4 + c], inv);
+                    dst[i * 4 + c] = static_cast<u8>(sum < 255u ? sum : 255u);
+                }
+            }
+        }
+    } // namespace scalar
+
+#if defined(ALMOND_PIXEL_X86)
+    // ────────────────────────────────────────────────────────
+    // x86 kernels
+    // ────────────────────────────────────────────────────────
+
+    namespace sse2
+    {
+        ALMOND_PIXEL_TARGET("sse2")
+        inline void swap_rb_32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                const __m128i rb = _mm_and_si128(v, rbMask);
+                const __m128i ag = _mm_andnot_si128(rbMask, v);
+                const __m128i swapped = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(ag, swapped));
+            }
+            scalar::swap_rb_32(src + i * 4, dst + i * 4, count - i);
+        }
+
+        // Two pixels widened to 16 bits: multiply each channel by its pixel's alpha / 255.
+        ALMOND_PIXEL_TARGET("sse2")
+        inline __m128i mul_alpha16(__m128i px16) noexcept
+        {
+            __m128i a = _mm_shufflelo_epi16(px16, 0xFF);
+            a = _mm_shufflehi_epi16(a, 0xFF);
+            __m128i t = _mm_add_epi16(_mm_mullo_epi16(px16, a), _mm_set1_epi16(128));
+            t = _mm_add_epi16(t, _mm_srli_epi16(t, 8));
+            return _mm_srli_epi16(t, 8);
+        }
+
+        ALMOND_PIXEL_TARGET("sse2")
+        inline void premultiply_alpha32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                const __m128i lo = mul_alpha16(_mm_unpacklo_epi8(v, zero));
+                const __m128i hi = mul_alpha16(_mm_unpackhi_epi8(v, zero));
+                __m128i out = _mm_packus_epi16(lo, hi);
+                out = _mm_or_si128(_mm_andnot_si128(alphaMask, out), _mm_and_si128(alphaMask, v));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+            }
+            scalar::premultiply_alpha32(src + i * 4, dst + i * 4, count - i);
+        }
+
+        // Two pixels widened to 16 bits: src + dst * (255 - src.a) / 255.
+        ALMOND_PIXEL_TARGET("sse2")
+        inline __m128i blend_over16(__m128i src16, __m128i dst16) noexcept
+        {
+            __m128i a = _mm_shufflelo_epi16(src16, 0xFF);
+            a = _mm_shufflehi_epi16(a, 0xFF);
+            const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), a);
+            __m128i t = _mm_add_epi16(_mm_mullo_epi16(dst16, inv), _mm_set1_epi16(128));
+            t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+            return _mm_add_epi16(src16, t);
+        }
+
+        ALMOND_PIXEL_TARGET("sse2")
+        inline void blend_over32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            const __m128i zero = _mm_setzero_si128();
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+                const __m128i lo = blend_over16(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+                const __m128i hi = blend_over16(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+            }
+            scalar::blend_over32(src + i * 4, dst + i * 4, count - i);
+        }
+    } // namespace sse2
+
+    namespace ssse3
+    {
+        ALMOND_PIXEL_TARGET("ssse3")
+        inline void expand24_to_32(const u8* src, u8* dst, std::size_t count, __m128i shuffle, bool bgr) noexcept
+        {
+            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            std::size_t i = 0;
+            // Each step reads 16 bytes but consumes 12, so stop while 16 are still in range.
+            for (; i + 6 <= count; i += 4)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4),
+                    _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha));
+            }
+            if (bgr)
+                scalar::bgr24_to_rgba32(src + i * 3, dst + i * 4, count - i);
+            else
+                scalar::rgb24_to_rgba32(src + i * 3, dst + i * 4, count - i);
+        }
+
+        ALMOND_PIXEL_TARGET("ssse3")
+        inline void rgb24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            expand24_to_32(src, dst, count,
+                _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1), false);
+        }
+
+        ALMOND_PIXEL_TARGET("ssse3")
+        inline void bgr24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            expand24_to_32(src, dst, count,
+                _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1), true);
+        }
+    } // namespace ssse3
+
+    namespace avx2
+    {
+        ALMOND_PIXEL_TARGET("avx2")
+        inline void swap_rb_32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            const __m256i rbMask = _mm256_set1_epi32(0x00FF00FF);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                const __m256i rb = _mm256_and_si256(v, rbMask);
+                const __m256i ag = _mm256_andnot_si256(rbMask, v);
+                const __m256i swapped = _mm256_or_si256(_mm256_slli_epi32(rb, 16), _mm256_srli_epi32(rb, 16));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_or_si256(ag, swapped));
+            }
+            sse2::swap_rb_32(src + i * 4, dst + i * 4, count - i);
+        }
+
+        ALMOND_PIXEL_TARGET("avx2")
+        inline void expand24_to_32(const u8* src, u8* dst, std::size_t count, __m256i shuffle, bool bgr) noexcept
+        {
+            const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+            std::size_t i = 0;
+            // Two 16-byte loads (offsets 0 and 12) per 8 pixels; the second reads 4 bytes past the run.
+            for (; i + 10 <= count; i += 8)
+            {
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3 + 12));
+                const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4),
+                    _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha));
+            }
+            if (bgr)
+                scalar::bgr24_to_rgba32(src + i * 3, dst + i * 4, count - i);
+            else
+                scalar::rgb24_to_rgba32(src + i * 3, dst + i * 4, count - i);
+        }
+
+        ALMOND_PIXEL_TARGET("avx2")
+        inline void rgb24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            expand24_to_32(src, dst, count, _mm256_setr_epi8(
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1), false);
+        }
+
+        ALMOND_PIXEL_TARGET("avx2")
+        inline void bgr24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            expand24_to_32(src, dst, count, _mm256_setr_epi8(
+                2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+                2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1), true);
+        }
+
+        ALMOND_PIXEL_TARGET("avx2")
+        inline void premultiply_alpha32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i bias = _mm256_set1_epi16(128);
+            const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                __m256i lo = _mm256_unpacklo_epi8(v, zero);
+                __m256i hi = _mm256_unpackhi_epi8(v, zero);
+
+                __m256i aLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xFF), 0xFF);
+                __m256i aHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xFF), 0xFF);
+
+                lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, aLo), bias);
+                hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, aHi), bias);
+                lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+                hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+
+                __m256i out = _mm256_packus_epi16(lo, hi);
+                out = _mm256_or_si256(_mm256_andnot_si256(alphaMask, out), _mm256_and_si256(alphaMask, v));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), out);
+            }
+            sse2::premultiply_alpha32(src + i * 4, dst + i * 4, count - i);
+        }
+
+        ALMOND_PIXEL_TARGET("avx2")
+        inline __m256i blend_over16(__m256i src16, __m256i dst16) noexcept
+        {
+            const __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src16, 0xFF), 0xFF);
+            const __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+            __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(dst16, inv), _mm256_set1_epi16(128));
+            t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+            return _mm256_add_epi16(src16, t);
+        }
+
+        ALMOND_PIXEL_TARGET("avx2")
+        inline void blend_over32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            const __m256i zero = _mm256_setzero_si256();
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i * 4));
+                const __m256i lo = blend_over16(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+                const __m256i hi = blend_over16(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(lo, hi));
+            }
+            sse2::blend_over32(src + i * 4, dst + i * 4, count - i);
+        }
+    } // namespace avx2
+#endif // ALMOND_PIXEL_X86
+
+#if defined(ALMOND_PIXEL_NEON)
+    // ────────────────────────────────────────────────────────
+    // NEON kernels
+    // ────────────────────────────────────────────────────────
+
+    namespace neon
+    {
+        inline void swap_rb_32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                uint8x16x4_t v = vld4q_u8(src + i * 4);
+                const uint8x16_t r = v.val[0];
+                v.val[0] = v.val[2];
+                v.val[2] = r;
+                vst4q_u8(dst + i * 4, v);
+            }
+            scalar::swap_rb_32(src + i * 4, dst + i * 4, count - i);
+        }
+
+        inline void rgb24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const uint8x16x3_t v = vld3q_u8(src + i * 3);
+                const uint8x16x4_t out{ { v.val[0], v.val[1], v.val[2], vdupq_n_u8(255) } };
+                vst4q_u8(dst + i * 4, out);
+            }
+            scalar::rgb24_to_rgba32(src + i * 3, dst + i * 4, count - i);
+        }
+
+        inline void bgr24_to_rgba32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const uint8x16x3_t v = vld3q_u8(src + i * 3);
+                const uint8x16x4_t out{ { v.val[2], v.val[1], v.val[0], vdupq_n_u8(255) } };
+                vst4q_u8(dst + i * 4, out);
+            }
+            scalar::bgr24_to_rgba32(src + i * 3, dst + i * 4, count - i);
+        }
+
+        inline uint8x8_t mul_div255(uint8x8_t c, uint8x8_t a) noexcept
+        {
+            const uint16x8_t t = vmull_u8(c, a);
+            return vrshrn_n_u16(vrsraq_n_u16(t, t, 8), 8);
+        }
+
+        inline void premultiply_alpha32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                uint8x8x4_t v = vld4_u8(src + i * 4);
+                v.val[0] = mul_div255(v.val[0], v.val[3]);
+                v.val[1] = mul_div255(v.val[1], v.val[3]);
+                v.val[2] = mul_div255(v.val[2], v.val[3]);
+                vst4_u8(dst + i * 4, v);
+            }
+            scalar::premultiply_alpha32(src + i * 4, dst + i * 4, count - i);
+        }
+
+        inline void blend_over32(const u8* src, u8* dst, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const uint8x8x4_t s = vld4_u8(src + i * 4);
+                uint8x8x4_t d = vld4_u8(dst + i * 4);
+                const uint8x8_t inv = vmvn_u8(s.val[3]);
+                for (int c = 0; c < 4; ++c)
+                    d.val[c] = vqadd_u8(s.val[c], mul_div255(d.val[c], inv));
+                vst4_u8(dst + i * 4, d);
+            }
+            scalar::blend_over32(src + i * 4, dst + i * 4, count - i);
+        }
+    } // namespace neon
+#endif // ALMOND_PIXEL_NEON
+
+    // ────────────────────────────────────────────────────────
+    // Runtime dispatch
+    // ────────────────────────────────────────────────────────
+
+    struct KernelTable
+    {
+        SimdLevel level;
+        void (*swap_rb_32)(const u8*, u8*, std::size_t) noexcept;
+        void (*rgb24_to_rgba32)(const u8*, u8*, std::size_t) noexcept;
+        void (*bgr24_to_rgba32)(const u8*, u8*, std::size_t) noexcept;
+        void (*premultiply_alpha32)(const u8*, u8*, std::size_t) noexcept;
+        void (*blend_over32)(const u8*, u8*, std::size_t) noexcept;
+    };
+
+    namespace detail
+    {
+        inline constexpr KernelTable kScalar{ SimdLevel::Scalar,
+            &scalar::swap_rb_32, &scalar::rgb24_to_rgba32, &scalar::bgr24_to_rgba32, &scalar::premultiply_alpha32, &scalar::blend_over32 };
+#if defined(ALMOND_PIXEL_X86)
+        inline constexpr KernelTable kSse2{ SimdLevel::SSE2,
+            &sse2::swap_rb_32, &scalar::rgb24_to_rgba32, &scalar::bgr24_to_rgba32, &sse2::premultiply_alpha32, &sse2::blend_over32 };
+        inline constexpr KernelTable kSsse3{ SimdLevel::SSSE3,
+            &sse2::swap_rb_32, &ssse3::rgb24_to_rgba32, &ssse3::bgr24_to_rgba32, &sse2::premultiply_alpha32, &sse2::blend_over32 };
+        inline constexpr KernelTable kAvx2{ SimdLevel::AVX2,
+            &avx2::swap_rb_32, &avx2::rgb24_to_rgba32, &avx2::bgr24_to_rgba32, &avx2::premultiply_alpha32, &avx2::blend_over32 };
+#endif
+#if defined(ALMOND_PIXEL_NEON)
+        inline constexpr KernelTable kNeon{ SimdLevel::NEON,
+            &neon::swap_rb_32, &neon::rgb24_to_rgba32, &neon::bgr24_to_rgba32, &neon::premultiply_alpha32, &neon::blend_over32 };
+#endif
+
+        [[nodiscard]] inline const KernelTable* table_for(SimdLevel level) noexcept
+        {
+            switch (level)
+            {
+#if defined(ALMOND_PIXEL_X86)
+            case SimdLevel::AVX2:  return &kAvx2;
+            case SimdLevel::SSSE3: return &kSsse3;
+            case SimdLevel::SSE2:  return &kSse2;
+#endif
+#if defined(ALMOND_PIXEL_NEON)
+            case SimdLevel::NEON:  return &kNeon;
+#endif
+            default:               return &kScalar;
+            }
+        }
+
+        inline std::atomic<const KernelTable*> g_active{ nullptr };
+    } // namespace detail
+
+    [[nodiscard]] inline const KernelTable& kernels() noexcept
+    {
+        const KernelTable* table = detail::g_active.load(std::memory_order_acquire);
+        if (!table)
+        {
+            table = detail::table_for(detect_simd_level());
+            detail::g_active.store(table, std::memory_order_release);
+        }
+        return *table;
+    }
+
+    [[nodiscard]] inline SimdLevel active_simd_level() noexcept { return kernels().level; }
+
+    [[nodiscard]] inline bool is_supported(SimdLevel level) noexcept
+    {
+        const SimdLevel detected = detect_simd_level();
+        if (level == SimdLevel::Scalar || level == detected)
+            return true;
+        if (level == SimdLevel::NEON || detected == SimdLevel::NEON)
+            return false;
+        return static_cast<int>(level) <= static_cast<int>(detected);
+    }
+
+    // Forces a kernel set, e.g. for benchmarks comparing levels. Unsupported
+    // requests fall back to the detected level.
+    inline void set_simd_level(SimdLevel level) noexcept
+    {
+        detail::g_active.store(
+            detail::table_for(is_supported(level) ? level : detect_simd_level()),
+            std::memory_order_release);
+    }
+
+    // ────────────────────────────────────────────────────────
+    // Public entry points
+    // ────────────────────────────────────────────────────────
+
+    // RGBA8 bytes -> packed 0xAARRGGBB (software framebuffer / texture layout).
+    inline void rgba8_to_argb32(const u8* src, u32* dst, std::size_t count) noexcept
+    {
+        kernels().swap_rb_32(src, reinterpret_cast<u8*>(dst), count);
+    }
+
+    // Packed 0xAARRGGBB -> RGBA8 bytes.
+    inline void argb32_to_rgba8(const u32* src, u8* dst, std::size_t count) noexcept
+    {
+        kernels().swap_rb_32(reinterpret_cast<const u8*>(src), dst, count);
+    }
+
+    // RGBA8 <-> BGRA8 (in place allowed).
+    inline void swap_red_blue(const u8* src, u8* dst, std::size_t count) noexcept
+    {
+        kernels().swap_rb_32(src, dst, count);
+    }
+
+    inline void rgb8_to_rgba8(const u8* src, u8* dst, std::size_t count) noexcept
+    {
+        kernels().rgb24_to_rgba32(src, dst, count);
+    }
+
+    inline void bgr8_to_rgba8(const u8* src, u8* dst, std::size_t count) noexcept
+    {
+        kernels().bgr24_to_rgba32(src, dst, count);
+    }
+
+    // Premultiplies colour by alpha for RGBA8 or packed ARGB32 pixels (in place allowed).
+    inline void premultiply_alpha(const u8* src, u8* dst, std::size_t count) noexcept
+    {
+        kernels().premultiply_alpha32(src, dst, count);
+    }
+
+    inline void premultiply_alpha(const u32* src, u32* dst, std::size_t count) noexcept
+    {
+        kernels().premultiply_alpha32(reinterpret_cast<const u8*>(src), reinterpret_cast<u8*>(dst), count);
+    }
+
+    // Composites premultiplied `src` over `dst` (same byte order for both).
+    inline void blend_over(const u32* src, u32* dst, std::size_t count) noexcept
+    {
+        kernels().blend_over32(reinterpret_cast<const u8*>(src), reinterpret_cast<u8*>(dst), count);
+    }
+
+    // True when every pixel's alpha (byte 3) is 255. No early exit so the
+    // AND-reduction vectorizes.
+    [[nodiscard]] inline bool is_opaque(const u32* px, std::size_t count) noexcept
+    {
+        u32 acc = 0xFFFFFFFFu;
+        for (std::size_t i = 0; i < count; ++i)
+            acc &= px[i];
+        return (acc >> 24) == 0xFFu;
+    }
+} // namespace almondnamespace::pixel
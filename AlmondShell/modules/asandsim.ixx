@@ -7,7 +7,7 @@ import aengine.core.context;      // core::Context
 import aengine.context.window;    // core::WindowData
 import aengine.input;             // input::Key
 import aatlas.manager;            // atlasmanager
-import aimage.loader;             // a_loadImage
+import aatlas.cache;              // atlascache::load_or_bake
 import aspritehandle;             // SpriteHandle
 import asprite.pool;              // spritepool
 import ascene;                    // scene::Scene
@@ -113,43 +113,19 @@ export namespace almondnamespace::sandsim
                 throw std::runtime_error("[SandSim] Missing atlas registrar");
 
             TextureAtlas& atlas = registrar->atlas;
-            bool registered = false;
 
-            auto ensureSprite = [&](std::string_view id)
-            {
-                std::string name(id);
-
-                if (auto existing = atlasmanager::registry.get(name))
-                {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle))
-                    {
-                        sprites[name] = handle;
-                        return;
-                    }
-                }
-
-                auto img = a_loadImage("assets/games/asandsim/" + name + ".ppm", false);
-                if (img.pixels.empty())
-                    return; // optional assets
-
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    name, img.pixels, img.width, img.height, atlas);
+            std::vector<atlascache::SpriteSource> sources{};
+            for (std::string_view id : { "bg", "sand", "water", "stone" })
+                sources.push_back({ std::string(id), "assets/games/asandsim/" + std::string(id) + ".ppm" });
 
-                if (handleOpt && spritepool::is_alive(*handleOpt))
-                {
-                    sprites[name] = *handleOpt;
-                    registered = true;
-                }
-            };
-
-            // Always try to load a background sprite if available
-            ensureSprite("bg");
-            ensureSprite("sand");
-            ensureSprite("water");
-            ensureSprite("stone");
+            const auto baked = atlascache::load_or_bake(*registrar, sources);
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                if (baked.handles[i] && spritepool::is_alive(*baked.handles[i]))
+                    sprites[sources[i].name] = *baked.handles[i];
+            }
 
-            if (createdAtlas || registered)
+            if (createdAtlas || baked.changed)
             {
                 atlas.rebuild_pixels();
                 atlasmanager::ensure_uploaded(atlas);
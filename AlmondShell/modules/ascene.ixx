@@ -94,6 +94,25 @@ export namespace almondnamespace::scene
             return true; // default: no-op
         }
 
+        // Fixed-timestep hooks. The engine loop calls update() once per
+        // simulation tick (timing::FixedStep), however many windows show the
+        // scene, then render() once per window with alpha in [0, 1): how far
+        // real time has moved past the last tick. Return false to end the
+        // scene. The default render() calls frame() once per window, so a
+        // scene that only overrides frame() must not advance state there.
+        virtual bool update(double /*fixedDt*/)
+        {
+            return true;
+        }
+
+        virtual bool render(
+            std::shared_ptr<almondnamespace::core::Context> ctx,
+            almondnamespace::core::WindowData* win,
+            double /*alpha*/)
+        {
+            return frame(std::move(ctx), win);
+        }
+
         // --------------------------------------------------------
         // Entity management
         // --------------------------------------------------------
@@ -39,9 +39,24 @@ export namespace almondnamespace::spritepool
 
     inline std::vector<std::uint8_t>  usedFlags;     // 0 = free, 1 = used
     inline std::vector<std::uint32_t> generations;  // generation per slot
-    inline std::atomic<std::size_t>   lastAllocIndex{ 0 };
     inline std::size_t                capacity = 0;
 
+    // Lock-free free list (Treiber stack) threaded through nextFree.
+    // freeHead packs { tag:32 | index:32 }; the tag bumps on every update so a
+    // slot popped and pushed back between a load and a CAS cannot ABA the head.
+    inline constexpr std::uint32_t    kNoFreeSlot = 0xFFFFFFFFu;
+    inline std::vector<std::uint32_t> nextFree;
+    inline std::atomic<std::uint64_t> freeHead{ kNoFreeSlot };
+
+    inline void rebuild_free_list() noexcept
+    {
+        nextFree.resize(capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+            nextFree[i] = (i + 1 < capacity) ? static_cast<std::uint32_t>(i + 1) : kNoFreeSlot;
+
+        freeHead.store(capacity ? 0u : kNoFreeSlot, std::memory_order_release);
+    }
+
     // Optional async task graph
     inline taskgraph::TaskGraph* g_taskGraph = nullptr;
 
@@ -54,7 +69,7 @@ export namespace almondnamespace::spritepool
         capacity = cap;
         usedFlags.assign(capacity, 0);
         generations.assign(capacity, 0);
-        lastAllocIndex.store(0, std::memory_order_relaxed);
+        rebuild_free_list();
 
 #if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
         std::cerr << "[SpritePool] Initialized with capacity " << capacity << "\n";
@@ -65,7 +80,8 @@ export namespace almondnamespace::spritepool
     {
         usedFlags.clear();
         generations.clear();
-        lastAllocIndex.store(0, std::memory_order_relaxed);
+        nextFree.clear();
+        freeHead.store(kNoFreeSlot, std::memory_order_release);
         capacity = 0;
         std::cerr << "[SpritePool] Cleared\n";
     }
@@ -80,7 +96,7 @@ export namespace almondnamespace::spritepool
 
         std::fill(usedFlags.begin(), usedFlags.end(), 0);
         std::fill(generations.begin(), generations.end(), 0);
-        lastAllocIndex.store(0, std::memory_order_relaxed);
+        rebuild_free_list();
 
 #if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
         std::cerr << "[SpritePool] Reset\n";
@@ -107,33 +123,47 @@ export namespace almondnamespace::spritepool
     // Allocation internals
     // ────────────────────────────────────────────────────────
 
-    inline bool try_acquire_flag(std::size_t idx) noexcept
+    inline std::optional<std::size_t> try_pop_free_slot() noexcept
     {
-        std::atomic_ref<std::uint8_t> flag(usedFlags[idx]);
-        std::uint8_t expected = 0;
-        return flag.compare_exchange_strong(
-            expected, 1, std::memory_order_acquire);
+        std::uint64_t head = freeHead.load(std::memory_order_acquire);
+
+        for (;;)
+        {
+            const std::uint32_t idx = static_cast<std::uint32_t>(head);
+            if (idx == kNoFreeSlot || idx >= capacity)
+                return std::nullopt;
+
+            const std::uint32_t next =
+                std::atomic_ref<std::uint32_t>(nextFree[idx]).load(std::memory_order_relaxed);
+            const std::uint64_t tag = (head >> 32) + 1;
+
+            if (freeHead.compare_exchange_weak(
+                head, (tag << 32) | next,
+                std::memory_order_acquire, std::memory_order_acquire))
+            {
+                std::atomic_ref<std::uint8_t>(usedFlags[idx]).store(1, std::memory_order_release);
+                return idx;
+            }
+        }
     }
 
-    inline std::optional<std::size_t>
-        try_allocate_round_robin() noexcept
+    inline void push_free_slot(std::uint32_t idx) noexcept
     {
-        const std::size_t size = capacity;
-        const std::size_t start =
-            lastAllocIndex.load(std::memory_order_relaxed);
+        std::uint64_t head = freeHead.load(std::memory_order_relaxed);
 
-        for (std::size_t offset = 0; offset < size; ++offset)
+        for (;;)
         {
-            const std::size_t idx = (start + offset) % size;
-            if (try_acquire_flag(idx))
+            std::atomic_ref<std::uint32_t>(nextFree[idx]).store(
+                static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+            const std::uint64_t tag = (head >> 32) + 1;
+
+            if (freeHead.compare_exchange_weak(
+                head, (tag << 32) | idx,
+                std::memory_order_release, std::memory_order_relaxed))
             {
-                lastAllocIndex.store(
-                    (idx + 1) % size, std::memory_order_relaxed);
-                return idx;
+                return;
             }
         }
-
-        return std::nullopt;
     }
 
     // ────────────────────────────────────────────────────────
@@ -142,7 +172,7 @@ export namespace almondnamespace::spritepool
 
     export inline SpriteHandle allocate() noexcept
     {
-        auto idx = try_allocate_round_robin();
+        auto idx = try_pop_free_slot();
         if (!idx)
             return SpriteHandle::invalid();
 
@@ -174,7 +204,7 @@ export namespace almondnamespace::spritepool
 
             if (!g_taskGraph)
             {
-                index = try_allocate_round_robin();
+                index = try_pop_free_slot();
                 if (awaiting) awaiting.resume();
                 return;
             }
@@ -205,7 +235,7 @@ export namespace almondnamespace::spritepool
     inline Task spritepool_allocation_coroutine(
         AllocateAwaitable* self)
     {
-        self->index = try_allocate_round_robin();
+        self->index = try_pop_free_slot();
         if (self->awaiting) self->awaiting.resume();
         co_return;
     }
@@ -226,9 +256,15 @@ export namespace almondnamespace::spritepool
 
         if (idx >= capacity) return;
 
+        // Only the caller that flips the slot from used to free may recycle it,
+        // so a double free cannot push the same index onto the list twice.
         std::atomic_ref<std::uint8_t> flag(usedFlags[idx]);
-        flag.store(0, std::memory_order_release);
+        std::uint8_t expected = 1;
+        if (!flag.compare_exchange_strong(expected, 0, std::memory_order_acq_rel))
+            return;
+
         ++generations[idx];
+        push_free_slot(static_cast<std::uint32_t>(idx));
     }
 
     export inline bool is_alive(
@@ -10,6 +10,7 @@ import <atomic>;
 import <iostream>;
 import <optional>;
 import <shared_mutex>;
+import <span>;
 import <string>;
 import <string_view>;
 import <tuple>;
@@ -77,6 +78,15 @@ export namespace almondnamespace
     // SpriteRegistry
     // ────────────────────────────────────────────────────────
 
+    export struct SpriteRegistration
+    {
+        std::string_view name;
+        SpriteHandle     handle;
+        float            u0{}, v0{};
+        float            width{}, height{};
+        float            pivotX{}, pivotY{};
+    };
+
     export struct SpriteRegistry
     {
         using Entry =
@@ -90,6 +100,9 @@ export namespace almondnamespace
             TransparentEqual
         > sprites;
 
+        // Inverse index (handle -> name) so aliasing checks on add() stay O(1).
+        std::unordered_map<SpriteHandle, std::string, SpriteHandleHash> names_by_handle;
+
         mutable std::shared_mutex mutex{};
         std::atomic<const TextureAtlas*> atlas_ptr{ nullptr };
 
@@ -118,25 +131,25 @@ export namespace almondnamespace
             std::unique_lock lock(mutex);
 
             // Prevent handle aliasing
-            for (const auto& [existingName, entry] : sprites)
+            if (auto alias = names_by_handle.find(handle);
+                alias != names_by_handle.end() && alias->second != name)
             {
-                if (std::get<0>(entry) == handle &&
-                    existingName != name)
-                {
-                    std::cerr
-                        << "[SpriteRegistry] Duplicate handle for '"
-                        << name << "'\n";
-                    return;
-                }
+                std::cerr
+                    << "[SpriteRegistry] Duplicate handle for '"
+                    << name << "'\n";
+                return;
             }
 
             const float u1 = u0 + width;
             const float v1 = v0 + height;
 
-            sprites.emplace(
+            auto [it, inserted] = sprites.emplace(
                 std::string{ name },
                 Entry{ handle, u0, v0, u1, v1, pivotX, pivotY });
 
+            if (inserted)
+                names_by_handle.insert_or_assign(handle, it->first);
+
 #if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
             std::cout
                 << "[SpriteRegistry] Added '" << name
@@ -146,6 +159,51 @@ export namespace almondnamespace
 #endif
         }
 
+        // Publishes a whole batch under one lock acquisition. Returns the number
+        // of entries inserted; rejected entries are logged like add().
+        std::size_t add_batch(std::span<const SpriteRegistration> batch)
+        {
+            std::size_t inserted = 0;
+            std::unique_lock lock(mutex);
+
+            sprites.reserve(sprites.size() + batch.size());
+            names_by_handle.reserve(names_by_handle.size() + batch.size());
+
+            for (const auto& reg : batch)
+            {
+                if (!reg.handle.is_valid() || !spritepool::is_alive(reg.handle))
+                {
+                    std::cerr
+                        << "[SpriteRegistry] Rejecting invalid handle for '"
+                        << reg.name << "'\n";
+                    continue;
+                }
+
+                if (auto alias = names_by_handle.find(reg.handle);
+                    alias != names_by_handle.end() && alias->second != reg.name)
+                {
+                    std::cerr
+                        << "[SpriteRegistry] Duplicate handle for '"
+                        << reg.name << "'\n";
+                    continue;
+                }
+
+                auto [it, added] = sprites.emplace(
+                    std::string{ reg.name },
+                    Entry{ reg.handle, reg.u0, reg.v0,
+                        reg.u0 + reg.width, reg.v0 + reg.height,
+                        reg.pivotX, reg.pivotY });
+
+                if (added)
+                {
+                    names_by_handle.insert_or_assign(reg.handle, it->first);
+                    ++inserted;
+                }
+            }
+
+            return inserted;
+        }
+
         // ----------------------------------------------------
         // Lookup
         // ----------------------------------------------------
@@ -168,7 +226,13 @@ export namespace almondnamespace
         bool remove(std::string_view name)
         {
             std::unique_lock lock(mutex);
-            return sprites.erase(name) > 0;
+
+            auto it = sprites.find(name);
+            if (it == sprites.end())
+                return false;
+
+            erase_locked(it);
+            return true;
         }
 
         bool remove_if_invalid(std::string_view name)
@@ -181,7 +245,7 @@ export namespace almondnamespace
 
             if (!spritepool::is_alive(std::get<0>(it->second)))
             {
-                sprites.erase(it);
+                erase_locked(it);
                 return true;
             }
 
@@ -195,7 +259,7 @@ export namespace almondnamespace
             for (auto it = sprites.begin(); it != sprites.end();)
             {
                 if (!spritepool::is_alive(std::get<0>(it->second)))
-                    it = sprites.erase(it);
+                    it = erase_locked(it);
                 else
                     ++it;
             }
@@ -205,6 +269,7 @@ export namespace almondnamespace
         {
             std::unique_lock lock(mutex);
             sprites.clear();
+            names_by_handle.clear();
         }
 
         // ----------------------------------------------------
@@ -221,5 +286,18 @@ export namespace almondnamespace
         {
             return atlas_ptr.load(std::memory_order_acquire);
         }
+
+    private:
+        using SpriteMap = decltype(sprites);
+
+        SpriteMap::iterator erase_locked(SpriteMap::iterator it)
+        {
+            if (auto alias = names_by_handle.find(std::get<0>(it->second));
+                alias != names_by_handle.end() && alias->second == it->first)
+            {
+                names_by_handle.erase(alias);
+            }
+            return sprites.erase(it);
+        }
     };
 }
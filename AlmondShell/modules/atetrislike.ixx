@@ -48,6 +48,7 @@ import atexture;
 import aengine.input;
 import agamecore;
 import aatlas.manager;
+import aatlas.cache;
 import asprite.pool;
 import aplatformpump;
 import aengine.core.context;
@@ -65,39 +66,37 @@ export namespace almondnamespace::tetrislike
             if (!setup_sprites())
                 throw std::runtime_error("Failed to setup Tetris sprites");
             state = {};
-            timer = timing::createTimer(0.25);
-            timing::setScale(timer, 0.25);
+            intent = {};
             acc = 0.0;
             game_over = false;
         }
 
-        bool frame(std::shared_ptr<almondnamespace::core::Context> ctx, contextwindow::WindowData*) override {
+        // One call per engine tick. Input latched by render() is applied here,
+        // so a held key moves the piece once per tick however many windows
+        // show the scene.
+        bool update(double fixedDt) override {
             if (game_over) return false;
 
-            //platformpump::pump_events();
-
-            if (ctx->is_key_down_safe(input::Key::Escape)) return false;
-
             // --- Input ---
-            if (ctx->is_key_down_safe(input::Key::Left) &&
+            if (intent.left &&
                 !collides(state, state.px - 1, state.py, state.rot))
                 --state.px;
 
-            if (ctx->is_key_down_safe(input::Key::Right) &&
+            if (intent.right &&
                 !collides(state, state.px + 1, state.py, state.rot))
                 ++state.px;
 
-            if (ctx->is_key_down_safe(input::Key::Up))
+            if (intent.rotate)
                 state.rot = (state.rot + 1) % 4;
 
-            if (ctx->is_key_down_safe(input::Key::Down) &&
+            if (intent.drop &&
                 !collides(state, state.px, state.py + 1, state.rot))
                 ++state.py;
 
-            // --- Timing ---
-            advance(timer, 0.016);
-            acc += timing::elapsed(timer);
-            reset(timer);
+            intent = {};
+
+            // --- Gravity ---
+            acc += fixedDt * TIME_SCALE;
 
             while (acc >= STEP_S) {
                 acc -= STEP_S;
@@ -117,6 +116,18 @@ export namespace almondnamespace::tetrislike
                     }
                 }
             }
+            return true;
+        }
+
+        bool render(std::shared_ptr<almondnamespace::core::Context> ctx, contextwindow::WindowData*, double) override {
+            if (game_over) return false;
+
+            if (ctx->is_key_down_safe(input::Key::Escape)) return false;
+
+            intent.left = intent.left || ctx->is_key_down_safe(input::Key::Left);
+            intent.right = intent.right || ctx->is_key_down_safe(input::Key::Right);
+            intent.rotate = intent.rotate || ctx->is_key_down_safe(input::Key::Up);
+            intent.drop = intent.drop || ctx->is_key_down_safe(input::Key::Down);
 
             // --- Draw ---
             ctx->clear_safe();
@@ -125,6 +136,11 @@ export namespace almondnamespace::tetrislike
             return true;
         }
 
+        // Standalone loop (run_tetrislike): one tick per frame.
+        bool frame(std::shared_ptr<almondnamespace::core::Context> ctx, contextwindow::WindowData* win) override {
+            return render(ctx, win, 0.0) && update(FRAME_STEP_S);
+        }
+
         void unload() override {
             Scene::unload();
         }
@@ -134,6 +150,8 @@ export namespace almondnamespace::tetrislike
         static constexpr int GRID_W = 40;
         static constexpr int GRID_H = 20;
         static constexpr double STEP_S = 30.0;
+        static constexpr double TIME_SCALE = 0.25;
+        static constexpr double FRAME_STEP_S = 1.0 / 60.0;
 
         // === State ===
         struct State {
@@ -153,7 +171,14 @@ export namespace almondnamespace::tetrislike
             }
         } state;
 
-        timing::Timer timer{};
+        // Keys seen by render() since the last tick.
+        struct Intent {
+            bool left = false;
+            bool right = false;
+            bool rotate = false;
+            bool drop = false;
+        } intent;
+
         double acc = 0.0;
         bool game_over = false;
 
@@ -200,15 +225,6 @@ export namespace almondnamespace::tetrislike
 
         // === Helpers ===
         inline bool setup_sprites() {
-            const auto blockImg = a_loadImage("assets/games/atetrislike/tetrino.ppm", true);
-            if (blockImg.pixels.empty()) return false;
-
-            Texture blockTex{
-                .width = static_cast<u32>(blockImg.width),
-                .height = static_cast<u32>(blockImg.height),
-                .pixels = blockImg.pixels
-            };
-
             if (!atlasmanager::create_atlas({
                 .name = "tetrisatlas",
                 .width = 1024,
@@ -219,11 +235,12 @@ export namespace almondnamespace::tetrislike
             auto& registrar = *atlasmanager::get_registrar("tetrisatlas");
             TextureAtlas& atlas = registrar.atlas;
 
-            auto handleOpt = registrar.register_atlas_sprites_by_image(
-                "tetris_block", blockTex.pixels, blockTex.width, blockTex.height, atlas);
-            if (!handleOpt) return false;
+            const atlascache::SpriteSource sources[]{
+                { "tetris_block", "assets/games/atetrislike/tetrino.ppm", true } };
+            const auto baked = atlascache::load_or_bake(registrar, sources);
+            if (!baked.handles[0]) return false;
 
-            SpriteHandle handle = *handleOpt;
+            SpriteHandle handle = *baked.handles[0];
             if (!spritepool::is_alive(handle)) return false;
 
             atlas.rebuild_pixels();
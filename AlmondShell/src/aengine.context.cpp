@@ -18,6 +18,7 @@
 #include <include/aengine.config.hpp> // macros only — must NOT include windows
 
 import <algorithm>;
+import <atomic>;
 import <cstdint>;
 import <format>;
 import <map>;
@@ -469,6 +470,67 @@ namespace almondnamespace::core
 
         if (!backendState.master) backendState.master = std::move(context);
         else backendState.duplicates.emplace_back(std::move(context));
+        lock.unlock();
+
+        publish_context_snapshot();
+    }
+
+    // ─── Context snapshot ──────────────────────────────────────────────
+    namespace
+    {
+        std::mutex g_snapshotPublishMutex{};
+        std::atomic<std::shared_ptr<const ContextSnapshot>> g_contextSnapshot{ std::make_shared<const ContextSnapshot>() };
+        std::atomic<std::uint64_t> g_contextSnapshotVersion{ 0 };
+    }
+
+    void publish_context_snapshot()
+    {
+        // Publishers serialise so versions are handed out in the order the
+        // snapshots were built.
+        std::scoped_lock publish(g_snapshotPublishMutex);
+
+        auto next = std::make_shared<ContextSnapshot>();
+        {
+            std::shared_lock lock(g_backendsMutex);
+            next->groups.reserve(g_backends.size());
+
+            for (auto& [type, state] : g_backends)
+            {
+                std::vector<std::shared_ptr<Context>> contexts;
+                contexts.reserve(1 + state.duplicates.size());
+
+                if (state.master) contexts.push_back(state.master);
+                for (auto& dup : state.duplicates)
+                    if (dup) contexts.push_back(dup);
+
+                if (!contexts.empty())
+                    next->groups.emplace_back(type, std::move(contexts));
+            }
+        }
+
+        const std::uint64_t version = g_contextSnapshotVersion.load(std::memory_order_relaxed) + 1;
+        next->version = version;
+        g_contextSnapshot.store(std::move(next), std::memory_order_release);
+        g_contextSnapshotVersion.store(version, std::memory_order_release);
+    }
+
+    std::uint64_t context_snapshot_version() noexcept
+    {
+        return g_contextSnapshotVersion.load(std::memory_order_acquire);
+    }
+
+    std::shared_ptr<const ContextSnapshot> context_snapshot()
+    {
+        return g_contextSnapshot.load(std::memory_order_acquire);
+    }
+
+    bool refresh_context_snapshot(std::shared_ptr<const ContextSnapshot>& held)
+    {
+        if (held && held->version == context_snapshot_version())
+            return false;
+
+        held = context_snapshot();
+        return true;
     }
 
     bool core::Context::process_safe(std::shared_ptr<core::Context> ctx, CommandQueue& queue)
@@ -779,7 +841,7 @@ namespace almondnamespace::core
             ctx->get_width = almondnamespace::noopcontext::noop_get_width;
             ctx->get_height = almondnamespace::noopcontext::noop_get_height;
 
-            ctx->draw_sprite = nullptr;
+            ctx->draw_sprite = almondnamespace::noopcontext::noop_draw_sprite;
             ctx->add_texture = &add_texture_default;
             ctx->add_atlas = +[](const TextureAtlas& a) { return add_atlas_default(a, ContextType::Noop); };
 
@@ -792,39 +854,34 @@ namespace almondnamespace::core
     {
         bool anyRunning = false;
 
-        std::vector<std::shared_ptr<Context>> contexts;
-        {
-            std::shared_lock lock(g_backendsMutex);
-            contexts.reserve(g_backends.size());
-            for (auto& [_, state] : g_backends) {
-                if (state.master) contexts.push_back(state.master);
-                for (auto& dup : state.duplicates) contexts.push_back(dup);
-            }
-        }
+        const auto snapshot = context_snapshot();
 
-        for (auto& ctx : contexts)
+        for (auto& [_, contexts] : snapshot->groups)
         {
-            if (!ctx) continue;
-
-            if (auto* window = ctx->windowData)
+            for (auto& ctx : contexts)
             {
-                if (window->running) anyRunning = true;
-                else window->commandQueue.drain();
-                continue;
-            }
+                if (!ctx) continue;
 
-            CommandQueue localQueue;
-            if (!ctx->process) { localQueue.drain(); continue; }
+                if (auto* window = ctx->windowData)
+                {
+                    if (window->running) anyRunning = true;
+                    else window->commandQueue.drain_all();
+                    continue;
+                }
 
-            const auto previous = core::get_current_render_context();
-            core::set_current_render_context(ctx);
-            struct ResetCurrentContext
-            {
-                std::shared_ptr<Context> previousCtx{};
-                ~ResetCurrentContext() { core::set_current_render_context(std::move(previousCtx)); }
-            } reset{ previous };
+                CommandQueue localQueue;
+                if (!ctx->process) { localQueue.drain(); continue; }
 
-            if (ctx->process_safe(ctx, localQueue)) anyRunning = true;
+                const auto previous = core::get_current_render_context();
+                core::set_current_render_context(ctx);
+                struct ResetCurrentContext
+                {
+                    std::shared_ptr<Context> previousCtx{};
+                    ~ResetCurrentContext() { core::set_current_render_context(std::move(previousCtx)); }
+                } reset{ previous };
+
+                if (ctx->process_safe(ctx, localQueue)) anyRunning = true;
+            }
         }
 
         return anyRunning;
@@ -37,9 +37,15 @@
 #   include <glad/glad.h>
 #endif
 
+// ---- POSIX (event-loop wait) ----
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 // ---- std ----
 #include <algorithm>
 #include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
@@ -62,6 +68,7 @@
 import aengine.context.multiplexer;   // MultiContextManager (decls)
 import aengine.core.context;          // Context, InitializeAllContexts(), CloneContext(), g_backends, etc.
 import aengine.core.logger;
+import aengine.core.renderpool;
 import aengine.context.window;        // WindowData
 import aengine.context.type;          // ContextType
 import aengine.core.commandline;
@@ -96,6 +103,25 @@ namespace almondnamespace::platform
     // Keep these as the same globals your other code expects.
     Display* global_display = nullptr;
     ::Window global_window = 0;
+
+    namespace
+    {
+        // Engine-side wakeups for wait_events(); polled next to the X fd.
+        int wake_fd() noexcept
+        {
+            static const int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            return fd;
+        }
+    }
+
+    void wake_event_loop() noexcept
+    {
+        const int fd = wake_fd();
+        if (fd < 0) return;
+
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = ::write(fd, &one, sizeof(one));
+    }
 }
 
 namespace almondnamespace::core
@@ -385,7 +411,7 @@ namespace almondnamespace::core
                         }
                     }
 
-                    auto winPtr = std::make_unique<WindowData>(
+                    auto winPtr = std::make_shared<WindowData>(
                         from_xwindow(win),
                         from_display(display),
                         from_glx(glxCtx),
@@ -402,6 +428,7 @@ namespace almondnamespace::core
                     {
                         std::scoped_lock lock(windowsMutex);
                         windows.emplace_back(std::move(winPtr));
+                        RebuildWindowIndex();
                     }
 
                     (void)raw;
@@ -445,6 +472,7 @@ namespace almondnamespace::core
                     while (contexts.size() < static_cast<size_t>(count))
                         contexts.push_back(ensure_duplicate(contexts.size() - 1));
                 }
+                publish_context_snapshot();
 
                 const size_t limit = (std::min)(created.size(), contexts.size());
                 for (size_t i = 0; i < limit; ++i)
@@ -462,6 +490,10 @@ namespace almondnamespace::core
                     ctx->hglrc = window->glContext;
                     ctx->windowData = window;
                     window->context = ctx;
+                    {
+                        std::scoped_lock lock(windowsMutex);
+                        RebuildWindowIndex();
+                    }
 
                     XWindowAttributes attrs{};
                     if (XGetWindowAttributes(display, xwin, &attrs))
@@ -688,6 +720,76 @@ namespace almondnamespace::core
         return true;
     }
 
+    // Like Initialize(), but every window is a noop or software context keyed
+    // by a synthetic handle; no X display or window is opened.
+    bool MultiContextManager::InitializeHeadless(int windowCount, ContextType type)
+    {
+        if (windowCount <= 0) return false;
+
+#if !defined(ALMOND_USING_NOOP_HEADLESS)
+        if (type == ContextType::Noop)
+        {
+            almondnamespace::logger::get(kLogSys).log(
+                almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                "Headless mode needs the noop backend (configure with ALMOND_ENABLE_NOOP_HEADLESS=ON)",
+                std::source_location::current());
+            return false;
+        }
+#endif
+
+        running.store(true, std::memory_order_release);
+        s_activeInstance = this;
+
+        almondnamespace::core::InitializeAllContexts();
+
+        const auto created = make_headless_windows(windowCount, type);
+        {
+            std::scoped_lock lock(windowsMutex);
+            windows.insert(windows.end(), created.begin(), created.end());
+            RebuildWindowIndex();
+        }
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+        // The software renderer sizes its framebuffer at initialize; with
+        // --headless set it never presents, so the handle is only a key.
+        if (type == ContextType::Software)
+        {
+            for (const auto& win : created)
+            {
+                UpdateContextDimensions(*win->context, *win,
+                    clamp_positive(cli::window_width), clamp_positive(cli::window_height));
+                SetupResizeCallback(*win);
+
+                if (!almondnamespace::anativecontext::softrenderer_initialize(
+                    win->context, nullptr,
+                    static_cast<unsigned>(win->width), static_cast<unsigned>(win->height),
+                    win->onResize))
+                {
+                    almondnamespace::logger::get(kLogSys).logf(
+                        almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                        std::source_location::current(),
+                        "Failed to initialize headless Software renderer for hwnd={}",
+                        win->hwnd);
+                    win->running = false;
+                }
+            }
+        }
+#endif
+        publish_context_snapshot();
+
+        for (const auto& win : created)
+            LaunchRenderLoop(*win);
+
+        if (created.empty())
+        {
+            almondnamespace::logger::get(kLogSys).log(
+                almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                "Headless mode: backend is not registered",
+                std::source_location::current());
+        }
+        return !created.empty();
+    }
+
     void MultiContextManager::StopAll()
     {
         running.store(false, std::memory_order_release);
@@ -702,11 +804,17 @@ namespace almondnamespace::core
             if (thread.joinable()) thread.join();
         threads.clear();
 
+        for (auto& [win, job] : pooledLoops)
+            if (job) job->wait();
+        pooledLoops.clear();
+        renderPool.reset();
+
         {
             std::scoped_lock lock(windowsMutex);
             for (auto& win : windows)
                 if (win) DestroyWindowData(*win);
             windows.clear();
+            RebuildWindowIndex();
         }
 
         if (colormap)
@@ -868,7 +976,7 @@ namespace almondnamespace::core
         ctx->hdc = hdc ? hdc : from_display(localDisplay);
         ctx->hglrc = glContext;
 
-        auto winPtr = std::make_unique<WindowData>(
+        auto winPtr = std::make_shared<WindowData>(
             hwnd,
             hdc ? hdc : from_display(localDisplay),
             glContext,
@@ -1081,24 +1189,23 @@ namespace almondnamespace::core
         {
             std::scoped_lock lock(windowsMutex);
             windows.emplace_back(std::move(winPtr));
+            RebuildWindowIndex();
         }
+        publish_context_snapshot();
 
-        threads[xwin] = std::thread([this, raw]()
-            {
-                RenderLoop(*raw);
-            });
+        LaunchRenderLoop(*raw);
     }
 
     void MultiContextManager::RemoveWindow(HWND hwnd)
     {
         if (!hwnd) return;
 
-        std::unique_ptr<WindowData> removed;
+        std::shared_ptr<WindowData> removed;
 
         {
             std::scoped_lock lock(windowsMutex);
             auto it = std::find_if(windows.begin(), windows.end(),
-                [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
+                [hwnd](const std::shared_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
 
             if (it == windows.end()) return;
 
@@ -1106,6 +1213,7 @@ namespace almondnamespace::core
             // It's a plain bool and would race the render thread -> possible infinite join.
             removed = std::move(*it);
             windows.erase(it);
+            RebuildWindowIndex();
         }
 
         // Ask the render thread to stop itself (no cross-thread data race).
@@ -1115,7 +1223,7 @@ namespace almondnamespace::core
             raw->EnqueueCommand([raw]()
                 {
                     raw->running = false;
-                });
+                }, core::CommandPriority::PresentCritical);
         }
 
         ::Window xwin = to_xwindow(hwnd);
@@ -1125,6 +1233,11 @@ namespace almondnamespace::core
             if (threadIt->second.joinable()) threadIt->second.join();
             threads.erase(threadIt);
         }
+        else if (auto job = pooledLoops.find(xwin); job != pooledLoops.end())
+        {
+            if (job->second) job->second->wait();
+            pooledLoops.erase(job);
+        }
 
         if (removed)
         {
@@ -1145,6 +1258,8 @@ namespace almondnamespace::core
                     }
                 }
             }
+
+            publish_context_snapshot();
         }
     }
 
@@ -1203,40 +1318,35 @@ namespace almondnamespace::core
         std::function<void(int, int)> resizeCallback;
         core::ContextType contextType = core::ContextType::None;
         std::uintptr_t windowId = 0;
-        WindowData* window = nullptr;
-
-        {
-            std::scoped_lock lock(windowsMutex);
 
-            auto it = std::find_if(windows.begin(), windows.end(),
-                [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-
-            if (it == windows.end()) return;
+        // Lock-free lookup: ArrangeDockedWindowsGrid calls in here while
+        // holding windowsMutex.
+        // Held for the whole update so a concurrent RemoveWindow cannot free it.
+        const std::shared_ptr<WindowData> window = windowIndex.acquire(hwnd);
+        if (!window) return;
 
-            window = it->get();
-            window->width = clampedWidth;
-            window->height = clampedHeight;
+        window->width = clampedWidth;
+        window->height = clampedHeight;
 
-            if (window->context)
-            {
-                window->context->width = clampedWidth;
-                window->context->height = clampedHeight;
-                contextType = window->context->type;
+        if (window->context)
+        {
+            window->context->width = clampedWidth;
+            window->context->height = clampedHeight;
+            contextType = window->context->type;
 
-                if (window->context->onResize)
-                    resizeCallback = window->context->onResize;
-            }
-            else
-            {
-                contextType = window->type;
-            }
+            if (window->context->onResize)
+                resizeCallback = window->context->onResize;
+        }
+        else
+        {
+            contextType = window->type;
+        }
 
-            if (!resizeCallback && window->onResize)
-                resizeCallback = window->onResize;
+        if (!resizeCallback && window->onResize)
+            resizeCallback = window->onResize;
 
-            if (window->hwnd)
-                windowId = reinterpret_cast<std::uintptr_t>(window->hwnd);
-        }
+        if (window->hwnd)
+            windowId = reinterpret_cast<std::uintptr_t>(window->hwnd);
 
         if (window)
         {
@@ -1259,7 +1369,7 @@ namespace almondnamespace::core
                         telemetry::RendererTelemetryTags{ contextType, windowId, "height" });
 
                     if (cb) cb(clampedWidth, clampedHeight);
-                });
+                }, core::CommandPriority::PresentCritical);
         }
     }
 
@@ -1270,69 +1380,50 @@ namespace almondnamespace::core
         {
             if (!win) continue;
 
-            ::Window xwin = to_xwindow(win->hwnd);
-            if (!threads.contains(xwin))
-            {
-                WindowData* raw = win.get();
-                threads[xwin] = std::thread([this, raw]() { RenderLoop(*raw); });
-            }
+            LaunchRenderLoop(*win);
         }
     }
 
     void MultiContextManager::EnqueueRenderCommand(HWND hwnd, RenderCommand cmd)
     {
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
+        if (const auto w = windowIndex.acquire(hwnd))
+            w->EnqueueCommand(std::move(cmd));
+    }
 
-        if (it != windows.end() && *it)
-            (*it)->EnqueueCommand(std::move(cmd));
+    void MultiContextManager::RebuildWindowIndex()
+    {
+        auto next = std::make_shared<WindowIndex::Table>();
+        next->byHandle.reserve(windows.size());
+        next->byContext.reserve(windows.size());
+
+        for (const auto& w : windows)
+        {
+            if (!w) continue;
+            if (w->hwnd) next->byHandle.emplace(w->hwnd, w);
+            if (w->context) next->byContext.emplace(w->context.get(), w);
+        }
+
+        windowIndex.publish(std::move(next));
     }
 
     WindowData* MultiContextManager::findWindowByHWND(HWND hwnd)
     {
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(hwnd);
     }
 
     const WindowData* MultiContextManager::findWindowByHWND(HWND hwnd) const
     {
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(hwnd);
     }
 
     WindowData* MultiContextManager::findWindowByContext(const std::shared_ptr<core::Context>& ctx)
     {
-        if (!ctx) return nullptr;
-
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [&](const std::unique_ptr<WindowData>& w)
-            {
-                return w && w->context && w->context.get() == ctx.get();
-            });
-
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(ctx.get());
     }
 
     const WindowData* MultiContextManager::findWindowByContext(const std::shared_ptr<core::Context>& ctx) const
     {
-        if (!ctx) return nullptr;
-
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [&](const std::unique_ptr<WindowData>& w)
-            {
-                return w && w->context && w->context.get() == ctx.get();
-            });
-
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(ctx.get());
     }
 
     void MultiContextManager::RenderLoop(WindowData& win)
@@ -1401,6 +1492,32 @@ namespace almondnamespace::core
             }
         } reset{ localDisplay, glxCtx };
 
+        if (!InitializeRenderContext(win)) return;
+
+        // Frame telemetry is recorded lock-free and emitted off-thread.
+        const auto frameRecords = telemetry::register_frame_records(
+            telemetry::RendererTelemetryTags{ ctx->type, reinterpret_cast<std::uintptr_t>(&win) });
+
+        for (;;)
+        {
+            telemetry::FrameRecord record{};
+            if (!RenderFrame(win, record)) break;
+
+            win.pacer.wait(record.queueDepth == 0);
+            telemetry::fill_pacing(record, win.pacer.stats());
+            frameRecords->push(record);
+        }
+
+        telemetry::unregister_frame_records(frameRecords);
+        ShutdownRenderContext(win);
+    }
+
+    // Backend bring-up on the thread that will render `win`. Returns false
+    // (and stops the window) when the backend cannot start.
+    bool MultiContextManager::InitializeRenderContext(WindowData& win)
+    {
+        auto ctx = win.context;
+
         if (win.threadInitialize)
         {
             auto init = std::move(win.threadInitialize);
@@ -1409,7 +1526,7 @@ namespace almondnamespace::core
             if (!init || !init(ctx))
             {
                 win.running = false;
-                return;
+                return false;
             }
         }
 
@@ -1432,7 +1549,7 @@ namespace almondnamespace::core
             else
             {
                 win.running = false;
-                return;
+                return false;
             }
         }
 
@@ -1446,43 +1563,163 @@ namespace almondnamespace::core
             ctx->process = nullptr;
         }
 
-        while (running.load(std::memory_order_acquire) && win.running)
+        if (!win.pacer.is_configured())
+            win.pacer.configure(cli::pacing_config());
+
+        // Bulk uploads carry over rather than hold back this window's present.
+        win.commandQueue.set_drain_budget(std::chrono::microseconds(cli::drain_budget_us));
+
+        return true;
+    }
+
+    // One frame of `win` on the calling thread. Returns false once the
+    // window should stop.
+    bool MultiContextManager::RenderFrame(WindowData& win, telemetry::FrameRecord& record)
+    {
+        if (!running.load(std::memory_order_acquire) || !win.running)
+            return false;
+
+        const auto& ctx = win.context;
+        bool keepRunning = true;
+
+        record.queueDepth = static_cast<std::uint32_t>(win.commandQueue.depth());
+
+        const auto processStart = std::chrono::steady_clock::now();
+        if (ctx->process)
+            keepRunning = ctx->process_safe(ctx, win.commandQueue);
+        else
+            win.commandQueue.drain();
+        record.processUs = std::chrono::duration<float, std::micro>(
+            std::chrono::steady_clock::now() - processStart).count();
+        record.drainUs = static_cast<float>(win.commandQueue.take_drain_us());
+        record.presentUs = static_cast<float>(win.lastPresentUs.exchange(0, std::memory_order_relaxed));
+
+        if (!keepRunning)
         {
-            bool keepRunning = true;
+            win.running = false;
+            return false;
+        }
+        return true;
+    }
+
+    void MultiContextManager::ShutdownRenderContext(WindowData& win)
+    {
+        win.commandQueue.drain_all();
+
+        if (win.context && win.context->cleanup)
+            win.context->cleanup_safe();
+
+        // Let a main loop blocked in wait_events() notice the window stopped.
+        almondnamespace::platform::wake_event_loop();
+    }
 
+    // Pooled variant of RenderLoop: each step renders one frame on whichever
+    // worker picked it up and returns the next deadline instead of sleeping.
+    RenderWorkerPool::Handle MultiContextManager::SubmitPooledRenderLoop(WindowData& win)
+    {
+        struct LoopState
+        {
+            bool initialized = false;
+            std::shared_ptr<telemetry::FrameRecordRing> frameRecords;
+        };
+
+        return renderPool->submit([this, &win, state = std::make_shared<LoopState>()]()
+            -> std::optional<RenderWorkerPool::Clock::time_point>
             {
-                std::size_t depth = 0;
+                auto ctx = win.context;
+                if (!ctx)
                 {
-                    std::scoped_lock lock(win.commandQueue.get_mutex());
-                    depth = win.commandQueue.get_queue().size();
+                    win.running = false;
+                    return std::nullopt;
                 }
-                telemetry::emit_gauge(
-                    "renderer.command_queue.depth",
-                    static_cast<std::int64_t>(depth),
-                    telemetry::RendererTelemetryTags{
-                        ctx->type,
-                        reinterpret_cast<std::uintptr_t>(win.hwnd)
-                    });
-            }
 
-            if (ctx->process)
-                keepRunning = ctx->process_safe(ctx, win.commandQueue);
-            else
-                win.commandQueue.drain();
+                // Workers are shared: the current context is bound per step.
+                MultiContextManager::SetCurrent(ctx);
+                struct ResetGuard { ~ResetGuard() { MultiContextManager::SetCurrent(nullptr); } } reset;
 
-            if (!keepRunning)
-            {
+                try
+                {
+                    if (!state->initialized)
+                    {
+                        ctx->windowData = &win;
+                        if (!InitializeRenderContext(win)) return std::nullopt;
+
+                        state->frameRecords = telemetry::register_frame_records(
+                            telemetry::RendererTelemetryTags{ ctx->type, reinterpret_cast<std::uintptr_t>(&win) });
+                        state->initialized = true;
+                    }
+                    else
+                    {
+                        win.pacer.begin_frame();
+                    }
+
+                    telemetry::FrameRecord record{};
+                    if (!RenderFrame(win, record))
+                    {
+                        telemetry::unregister_frame_records(state->frameRecords);
+                        ShutdownRenderContext(win);
+                        return std::nullopt;
+                    }
+
+                    const auto due = win.pacer.plan(record.queueDepth == 0);
+                    telemetry::fill_pacing(record, win.pacer.stats());
+                    state->frameRecords->push(record);
+                    return due;
+                }
+                catch (const std::exception& e)
+                {
+                    almondnamespace::logger::get(kLogSys).logf(
+                        almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                        std::source_location::current(),
+                        "Render step threw for hwnd={}: {}",
+                        win.hwnd,
+                        e.what());
+                }
+                catch (...)
+                {
+                    almondnamespace::logger::get(kLogSys).logf(
+                        almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                        std::source_location::current(),
+                        "Render step threw an unknown exception for hwnd={}",
+                        win.hwnd);
+                }
+
+                // The pool only marks a throwing job finished, so end the loop
+                // here as a failed frame would.
                 win.running = false;
-                break;
-            }
+                if (state->initialized)
+                {
+                    telemetry::unregister_frame_records(state->frameRecords);
+                    ShutdownRenderContext(win);
+                }
+                return std::nullopt;
+            });
+    }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
-        }
+    // Software, noop and Vulkan windows without a GLX context have no thread
+    // affinity and join the shared pool when one is requested; everything
+    // else gets its own thread.
+    void MultiContextManager::LaunchRenderLoop(WindowData& win)
+    {
+        ::Window xwin = to_xwindow(win.hwnd);
+        if (threads.contains(xwin) || pooledLoops.contains(xwin))
+            return;
 
-        win.commandQueue.drain();
+        if (cli::render_workers != 0 && !win.glContext
+            && win.context && render_pool_eligible(win.context->type))
+        {
+            if (!renderPool)
+            {
+                renderPool = std::make_unique<RenderWorkerPool>(cli::render_workers > 0
+                    ? static_cast<std::size_t>(cli::render_workers)
+                    : RenderWorkerPool::default_worker_count());
+            }
+            pooledLoops[xwin] = SubmitPooledRenderLoop(win);
+            return;
+        }
 
-        if (ctx->cleanup)
-            ctx->cleanup_safe();
+        WindowData* raw = &win;
+        threads[xwin] = std::thread([this, raw]() { RenderLoop(*raw); });
     }
 
 } // namespace almondnamespace::core
@@ -1550,6 +1787,53 @@ namespace almondnamespace::platform
 
         return keepRunning;
     }
+
+    bool wait_events(std::chrono::steady_clock::time_point until)
+    {
+        Display* display = global_display;
+        if (!display)
+            return false;
+
+        const int wakeFd = wake_fd();
+
+        for (;;)
+        {
+            // Xlib may already hold queued events that poll() cannot see.
+            if (XEventsQueued(display, QueuedAfterFlush) > 0)
+                return true;
+
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                until - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0)
+                return false;
+
+            pollfd fds[2]{};
+            fds[0].fd = ConnectionNumber(display);
+            fds[0].events = POLLIN;
+            fds[1].fd = wakeFd;
+            fds[1].events = POLLIN;
+            const nfds_t count = wakeFd >= 0 ? 2 : 1;
+
+            const int ready = ::poll(fds, count, static_cast<int>(remaining.count()));
+            if (ready < 0)
+            {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (ready == 0)
+                return false;
+
+            if (count == 2 && (fds[1].revents & POLLIN))
+            {
+                std::uint64_t pending = 0;
+                [[maybe_unused]] const auto drained = ::read(wakeFd, &pending, sizeof(pending));
+                return true;
+            }
+
+            // The X fd became readable; loop so XEventsQueued() reads it. Replies
+            // and other non-event traffic do not end the wait.
+        }
+    }
 } // namespace almondnamespace::platform
 
 #endif // __linux__
@@ -68,6 +68,7 @@ import autility.string.converter;
 import aengine.cli;
 import aengine.core.context;
 import aengine.core.logger;
+import aengine.core.renderpool;
 
 import aengine.context.commandqueue;
 import aengine.context.multiplexer;
@@ -97,12 +98,15 @@ namespace
 {
     // TU-owned globals.
     std::unordered_map<HWND, std::thread> g_threads;
+    std::unordered_map<HWND, almondnamespace::core::RenderWorkerPool::Handle> g_pooledLoops;
+    std::unique_ptr<almondnamespace::core::RenderWorkerPool> g_renderPool;
     almondnamespace::core::DragState       g_drag;
     struct PendingWindowCleanup
     {
         HWND hwnd{};
         std::thread thread{};
-        std::unique_ptr<almondnamespace::core::WindowData> window{};
+        almondnamespace::core::RenderWorkerPool::Handle job{}; // pooled render loop instead of a thread
+        std::shared_ptr<almondnamespace::core::WindowData> window{};
     };
     std::vector<PendingWindowCleanup> g_pendingCleanups;
     constexpr std::string_view kLogSys = "Context.Multiplexer.Win";
@@ -192,7 +196,7 @@ namespace
     }
 #endif
 
-    inline void cleanup_window_resources(std::unique_ptr<almondnamespace::core::WindowData>& window) noexcept
+    inline void cleanup_window_resources(std::shared_ptr<almondnamespace::core::WindowData>& window) noexcept
     {
 #if defined(ALMOND_USING_OPENGL)
         if (window && window->glContext)
@@ -282,38 +286,40 @@ namespace almondnamespace::core
     // ------------------------------------------------------------
     // Window lookup
     // ------------------------------------------------------------
+    void MultiContextManager::RebuildWindowIndex()
+    {
+        auto next = std::make_shared<WindowIndex::Table>();
+        next->byHandle.reserve(windows.size());
+        next->byContext.reserve(windows.size());
+
+        for (const auto& w : windows)
+        {
+            if (!w) continue;
+            if (w->hwnd) next->byHandle.emplace(w->hwnd, w);
+            if (w->context) next->byContext.emplace(w->context.get(), w);
+        }
+
+        windowIndex.publish(std::move(next));
+    }
+
     WindowData* MultiContextManager::findWindowByHWND(HWND hwnd)
     {
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(hwnd);
     }
 
     const WindowData* MultiContextManager::findWindowByHWND(HWND hwnd) const
     {
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(hwnd);
     }
 
     WindowData* MultiContextManager::findWindowByContext(const std::shared_ptr<Context>& ctx)
     {
-        if (!ctx) return nullptr;
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [&](const std::unique_ptr<WindowData>& w) { return w && w->context && w->context.get() == ctx.get(); });
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(ctx.get());
     }
 
     const WindowData* MultiContextManager::findWindowByContext(const std::shared_ptr<Context>& ctx) const
     {
-        if (!ctx) return nullptr;
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [&](const std::unique_ptr<WindowData>& w) { return w && w->context && w->context.get() == ctx.get(); });
-        return (it != windows.end()) ? it->get() : nullptr;
+        return windowIndex.find(ctx.get());
     }
 
     // ------------------------------------------------------------
@@ -331,10 +337,7 @@ namespace almondnamespace::core
 
     void MultiContextManager::EnqueueRenderCommand(HWND hwnd, RenderCommand cmd)
     {
-        std::scoped_lock lock(windowsMutex);
-        auto it = std::find_if(windows.begin(), windows.end(),
-            [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-        if (it != windows.end()) (*it)->EnqueueCommand(std::move(cmd));
+        if (const auto w = windowIndex.acquire(hwnd)) w->EnqueueCommand(std::move(cmd));
     }
 
     // ------------------------------------------------------------
@@ -585,7 +588,7 @@ namespace almondnamespace::core
 #endif
 #endif
 
-                    auto winPtr = std::make_unique<WindowData>(hwnd, hdc, glrc, usesSharedContext, type);
+                    auto winPtr = std::make_shared<WindowData>(hwnd, hdc, glrc, usesSharedContext, type);
                     winPtr->running = true;
                     winPtr->titleWide = windowTitle;
                     winPtr->titleNarrow = narrowTitle;
@@ -595,6 +598,7 @@ namespace almondnamespace::core
                     {
                         std::scoped_lock lock(windowsMutex);
                         windows.emplace_back(std::move(winPtr));
+                        RebuildWindowIndex();
                     }
 
                     created.push_back(hwnd);
@@ -651,6 +655,7 @@ namespace almondnamespace::core
                     }
                     ctxs.push_back(std::move(cloned));
                 }
+                publish_context_snapshot();
 
                 const size_t n = (std::min)(created.size(), ctxs.size());
                 for (size_t i = 0; i < n; ++i)
@@ -676,6 +681,10 @@ namespace almondnamespace::core
                         ctx->hglrc = w->glContext;
                         ctx->windowData = w;
                         w->context = ctx;
+                        {
+                            std::scoped_lock lock(windowsMutex);
+                            RebuildWindowIndex();
+                        }
                         w->width = width;
                         w->height = height;
                         w->running = true;
@@ -816,6 +825,78 @@ namespace almondnamespace::core
         }
     }
 
+    // Like Initialize(), but every window is a noop or software context keyed
+    // by a synthetic handle; no Win32 window, DC or GL context is created.
+    bool MultiContextManager::InitializeHeadless(int windowCount, ContextType type)
+    {
+        if (windowCount <= 0) return false;
+
+#if !defined(ALMOND_USING_NOOP_HEADLESS)
+        if (type == ContextType::Noop)
+        {
+            almondnamespace::logger::get(kLogSys).log(
+                almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                "Headless mode needs the noop backend (configure with ALMOND_ENABLE_NOOP_HEADLESS=ON)",
+                std::source_location::current());
+            return false;
+        }
+#endif
+
+        running.store(true, std::memory_order_release);
+        s_activeInstance = this;
+
+        almondnamespace::core::InitializeAllContexts();
+
+        const auto created = make_headless_windows(windowCount, type);
+        {
+            std::scoped_lock lock(windowsMutex);
+            windows.insert(windows.end(), created.begin(), created.end());
+            RebuildWindowIndex();
+        }
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+        // The software renderer sizes its framebuffer at initialize; with
+        // --headless set it never presents, so the handle is only a key.
+        if (type == ContextType::Software)
+        {
+            for (const auto& win : created)
+            {
+                auto& ctx = *win->context;
+                ctx.width = clamp_positive(cli::window_width);
+                ctx.height = clamp_positive(cli::window_height);
+                win->width = ctx.width;
+                win->height = ctx.height;
+
+                if (!almondnamespace::anativecontext::softrenderer_initialize(
+                    win->context, win->hwnd,
+                    static_cast<unsigned>(ctx.width), static_cast<unsigned>(ctx.height),
+                    win->onResize))
+                {
+                    almondnamespace::logger::get(kLogSys).logf(
+                        almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                        std::source_location::current(),
+                        "Failed to initialize headless Software renderer for hwnd={}",
+                        static_cast<void*>(win->hwnd));
+                    win->running = false;
+                }
+            }
+        }
+#endif
+        publish_context_snapshot();
+
+        for (const auto& win : created)
+            LaunchRenderLoop(*win);
+
+        if (created.empty())
+        {
+            almondnamespace::logger::get(kLogSys).log(
+                almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                "Headless mode: backend is not registered",
+                std::source_location::current());
+        }
+        return !created.empty();
+    }
+
     void MultiContextManager::AddWindow(
         HWND hwnd,
         HWND parentWnd,
@@ -910,7 +991,7 @@ namespace almondnamespace::core
         ctx->native_drawable = hdc;
         ctx->native_gl_context = glContext;
 
-        auto winPtr = std::make_unique<WindowData>(hwnd, hdc, glContext, usesSharedContext, type);
+        auto winPtr = std::make_shared<WindowData>(hwnd, hdc, glContext, usesSharedContext, type);
         winPtr->running = true;
         winPtr->onResize = std::move(onResize);
         winPtr->context = ctx;
@@ -930,11 +1011,12 @@ namespace almondnamespace::core
         {
             std::scoped_lock lock(windowsMutex);
             windows.emplace_back(std::move(winPtr));
+            RebuildWindowIndex();
         }
+        publish_context_snapshot();
 
-        auto& threads = Threads();
-        if (!threads.contains(hwnd) && rawWin)
-            threads[hwnd] = std::thread([this, rawWin]() { RenderLoop(*rawWin); });
+        if (rawWin)
+            LaunchRenderLoop(*rawWin);
 
         ArrangeDockedWindowsGrid();
     }
@@ -950,35 +1032,30 @@ namespace almondnamespace::core
         std::function<void(int, int)> resizeCallback;
         core::ContextType contextType = core::ContextType::None;
         std::uintptr_t windowId = 0;
-        WindowData* window = nullptr;
 
-        {
-            std::scoped_lock lock(windowsMutex);
-            auto it = std::find_if(windows.begin(), windows.end(),
-                [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-            if (it == windows.end()) return;
+        // Held for the whole update so a concurrent RemoveWindow cannot free it.
+        const std::shared_ptr<WindowData> window = windowIndex.acquire(hwnd);
+        if (!window) return;
 
-            window = it->get();
-            window->width = clampedWidth;
-            window->height = clampedHeight;
+        window->width = clampedWidth;
+        window->height = clampedHeight;
 
-            if (window->context)
-            {
-                window->context->width = clampedWidth;
-                window->context->height = clampedHeight;
-                contextType = window->context->type;
-                if (window->context->onResize) resizeCallback = window->context->onResize;
-            }
-            else
-            {
-                contextType = window->type;
-            }
+        if (window->context)
+        {
+            window->context->width = clampedWidth;
+            window->context->height = clampedHeight;
+            contextType = window->context->type;
+            if (window->context->onResize) resizeCallback = window->context->onResize;
+        }
+        else
+        {
+            contextType = window->type;
+        }
 
-            if (!resizeCallback && window->onResize) resizeCallback = window->onResize;
+        if (!resizeCallback && window->onResize) resizeCallback = window->onResize;
 
-            if (window->hwnd)
-                windowId = reinterpret_cast<std::uintptr_t>(window->hwnd);
-        }
+        if (window->hwnd)
+            windowId = reinterpret_cast<std::uintptr_t>(window->hwnd);
 
         if (window)
         {
@@ -1004,7 +1081,7 @@ namespace almondnamespace::core
                         telemetry::RendererTelemetryTags{ contextType, windowId, "height" });
 
                     if (cb) cb(w, h);
-                });
+                }, core::CommandPriority::PresentCritical);
         }
     }
 
@@ -1018,36 +1095,21 @@ namespace almondnamespace::core
                 if (w && w->hwnd) hwnds.push_back(w->hwnd);
         }
 
-        auto& threads = Threads();
-
         for (HWND hwnd : hwnds)
         {
-            if (threads.contains(hwnd)) continue;
-
-            threads[hwnd] = std::thread([this, hwnd]()
-                {
-                    WindowData* win = nullptr;
-                    {
-                        std::scoped_lock lock(windowsMutex);
-                        auto it = std::find_if(windows.begin(), windows.end(),
-                            [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
-                        if (it != windows.end()) win = it->get();
-                    }
-
-                    if (win) RenderLoop(*win);
-                });
+            if (auto* win = windowIndex.find(hwnd)) LaunchRenderLoop(*win);
         }
     }
 
     void MultiContextManager::RemoveWindow(HWND hwnd)
     {
-        std::unique_ptr<WindowData> removed;
+        std::shared_ptr<WindowData> removed;
         bool should_quit = false;
 
         {
             std::scoped_lock lock(windowsMutex);
             auto it = std::find_if(windows.begin(), windows.end(),
-                [hwnd](const std::unique_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
+                [hwnd](const std::shared_ptr<WindowData>& w) { return w && w->hwnd == hwnd; });
             if (it == windows.end()) return;
 
             (*it)->running = false;
@@ -1066,6 +1128,7 @@ namespace almondnamespace::core
 
             removed = std::move(*it);
             windows.erase(it);
+            RebuildWindowIndex();
             should_quit = windows.empty();
         }
 
@@ -1079,11 +1142,21 @@ namespace almondnamespace::core
             threads.erase(hwnd);
             g_pendingCleanups.emplace_back(std::move(pending));
         }
+        else if (auto job = g_pooledLoops.find(hwnd); job != g_pooledLoops.end())
+        {
+            PendingWindowCleanup pending{};
+            pending.hwnd = hwnd;
+            pending.job = std::move(job->second);
+            pending.window = std::move(removed);
+            g_pooledLoops.erase(job);
+            g_pendingCleanups.emplace_back(std::move(pending));
+        }
         else
         {
             cleanup_window_resources(removed);
         }
 
+        publish_context_snapshot();
         CleanupFinishedWindows();
 
         if (should_quit)
@@ -1098,7 +1171,8 @@ namespace almondnamespace::core
         auto it = g_pendingCleanups.begin();
         while (it != g_pendingCleanups.end())
         {
-            if (!thread_finished(it->thread))
+            const bool finished = it->job ? it->job->finished() : thread_finished(it->thread);
+            if (!finished)
             {
                 ++it;
                 continue;
@@ -1159,30 +1233,29 @@ namespace almondnamespace::core
             if (th.joinable()) th.join();
         g_threads.clear();
 
+        for (auto& [hwnd, job] : g_pooledLoops)
+            if (job) job->wait();
+        g_pooledLoops.clear();
+
         for (auto& pending : g_pendingCleanups)
         {
+            if (pending.job)
+                pending.job->wait();
             if (pending.thread.joinable())
                 pending.thread.join();
             cleanup_window_resources(pending.window);
         }
         g_pendingCleanups.clear();
+        g_renderPool.reset();
 
         if (s_activeInstance == this) s_activeInstance = nullptr;
     }
 
-    void MultiContextManager::RenderLoop(WindowData& win)
+    // Backend bring-up on the thread that will render `win`. Returns false
+    // (and stops the window) when the backend cannot start.
+    bool MultiContextManager::InitializeRenderContext(WindowData& win)
     {
         auto ctx = win.context;
-        if (!ctx)
-        {
-            win.running = false;
-            return;
-        }
-
-        ctx->windowData = &win;
-        MultiContextManager::SetCurrent(ctx);
-
-        struct ResetGuard { ~ResetGuard() { MultiContextManager::SetCurrent(nullptr); } } resetGuard;
 
         // Raylib/SDL must be created+initialized on the SAME thread that will render them.
 		// they are passed the HWND from outside, but they create their own internal windowing context.
@@ -1220,7 +1293,7 @@ namespace almondnamespace::core
                 win.titleNarrow
             );
 
-            if (!ok) { win.running = false; return; }
+            if (!ok) { win.running = false; return false; }
         }
 #endif
 #if defined(ALMOND_USING_RAYLIB)
@@ -1242,7 +1315,7 @@ namespace almondnamespace::core
             if (!initialized)
             {
                 win.running = false;
-                return;
+                return false;
             }
         }
 #endif
@@ -1264,7 +1337,7 @@ namespace almondnamespace::core
         if (!skipGenericInit)
         {
             if (ctx->initialize) ctx->initialize_safe();
-            else { win.running = false; return; }
+            else { win.running = false; return false; }
         }
 
         if (ctx->init_failed)
@@ -1277,36 +1350,189 @@ namespace almondnamespace::core
             ctx->process = nullptr;
         }
 
-        while (running.load(std::memory_order_acquire) && win.running)
+        if (!win.pacer.is_configured())
+            win.pacer.configure(cli::pacing_config());
+
+        // Bulk uploads carry over rather than hold back this window's present.
+        win.commandQueue.set_drain_budget(std::chrono::microseconds(cli::drain_budget_us));
+
+        return true;
+    }
+
+    // One frame of `win` on the calling thread. Returns false once the
+    // window should stop.
+    bool MultiContextManager::RenderFrame(WindowData& win, telemetry::FrameRecord& record)
+    {
+        if (!running.load(std::memory_order_acquire) || !win.running)
+            return false;
+
+        const auto& ctx = win.context;
+        bool keepRunning = true;
+
+        record.queueDepth = static_cast<std::uint32_t>(win.commandQueue.depth());
+
+        const auto processStart = std::chrono::steady_clock::now();
+        if (ctx->process) keepRunning = ctx->process_safe(ctx, win.commandQueue);
+        else win.commandQueue.drain();
+        record.processUs = std::chrono::duration<float, std::micro>(
+            std::chrono::steady_clock::now() - processStart).count();
+        record.drainUs = static_cast<float>(win.commandQueue.take_drain_us());
+        record.presentUs = static_cast<float>(win.lastPresentUs.exchange(0, std::memory_order_relaxed));
+
+        if (!keepRunning)
         {
-            bool keepRunning = true;
+            win.running = false;
+            return false;
+        }
+        return true;
+    }
 
-            {
-                const std::size_t depth = win.commandQueue.depth();
-                telemetry::emit_gauge(
-                    "renderer.command_queue.depth",
-                    static_cast<std::int64_t>(depth),
-                    telemetry::RendererTelemetryTags{
-                        ctx->type,
-                        reinterpret_cast<std::uintptr_t>(win.hwnd)
-                    });
-            }
+    void MultiContextManager::ShutdownRenderContext(WindowData& win)
+    {
+        win.commandQueue.drain_all();
+
+        if (win.context && win.context->cleanup) win.context->cleanup_safe();
+    }
+
+    void MultiContextManager::RenderLoop(WindowData& win)
+    {
+        auto ctx = win.context;
+        if (!ctx)
+        {
+            win.running = false;
+            return;
+        }
+
+        ctx->windowData = &win;
+        MultiContextManager::SetCurrent(ctx);
+
+        struct ResetGuard { ~ResetGuard() { MultiContextManager::SetCurrent(nullptr); } } resetGuard;
+
+        if (!InitializeRenderContext(win)) return;
+
+        // Frame telemetry is recorded lock-free and emitted off-thread.
+        const auto frameRecords = telemetry::register_frame_records(
+            telemetry::RendererTelemetryTags{ ctx->type, reinterpret_cast<std::uintptr_t>(win.hwnd) });
+
+        for (;;)
+        {
+            telemetry::FrameRecord record{};
+            if (!RenderFrame(win, record)) break;
+
+            win.pacer.wait(record.queueDepth == 0);
+            telemetry::fill_pacing(record, win.pacer.stats());
+            frameRecords->push(record);
+        }
+
+        telemetry::unregister_frame_records(frameRecords);
+        ShutdownRenderContext(win);
+    }
 
-            if (ctx->process) keepRunning = ctx->process_safe(ctx, win.commandQueue);
-            else win.commandQueue.drain();
+    // Pooled variant of RenderLoop: each step renders one frame on whichever
+    // worker picked it up and returns the next deadline instead of sleeping.
+    RenderWorkerPool::Handle MultiContextManager::SubmitPooledRenderLoop(WindowData& win)
+    {
+        struct LoopState
+        {
+            bool initialized = false;
+            std::shared_ptr<telemetry::FrameRecordRing> frameRecords;
+        };
 
-            if (!keepRunning)
+        return g_renderPool->submit([this, &win, state = std::make_shared<LoopState>()]()
+            -> std::optional<RenderWorkerPool::Clock::time_point>
             {
+                auto ctx = win.context;
+                if (!ctx)
+                {
+                    win.running = false;
+                    return std::nullopt;
+                }
+
+                // Workers are shared: the current context is bound per step.
+                MultiContextManager::SetCurrent(ctx);
+                struct ResetGuard { ~ResetGuard() { MultiContextManager::SetCurrent(nullptr); } } resetGuard;
+
+                try
+                {
+                    if (!state->initialized)
+                    {
+                        ctx->windowData = &win;
+                        if (!InitializeRenderContext(win)) return std::nullopt;
+
+                        state->frameRecords = telemetry::register_frame_records(
+                            telemetry::RendererTelemetryTags{ ctx->type, reinterpret_cast<std::uintptr_t>(win.hwnd) });
+                        state->initialized = true;
+                    }
+                    else
+                    {
+                        win.pacer.begin_frame();
+                    }
+
+                    telemetry::FrameRecord record{};
+                    if (!RenderFrame(win, record))
+                    {
+                        telemetry::unregister_frame_records(state->frameRecords);
+                        ShutdownRenderContext(win);
+                        return std::nullopt;
+                    }
+
+                    const auto due = win.pacer.plan(record.queueDepth == 0);
+                    telemetry::fill_pacing(record, win.pacer.stats());
+                    state->frameRecords->push(record);
+                    return due;
+                }
+                catch (const std::exception& e)
+                {
+                    almondnamespace::logger::get(kLogSys).logf(
+                        almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                        std::source_location::current(),
+                        "Render step threw for hwnd={}: {}",
+                        static_cast<void*>(win.hwnd),
+                        e.what());
+                }
+                catch (...)
+                {
+                    almondnamespace::logger::get(kLogSys).logf(
+                        almondnamespace::logger::LogLevel::ALMOND_ERROR,
+                        std::source_location::current(),
+                        "Render step threw an unknown exception for hwnd={}",
+                        static_cast<void*>(win.hwnd));
+                }
+
+                // The pool only marks a throwing job finished, so end the loop
+                // here as a failed frame would.
                 win.running = false;
-                break;
-            }
+                if (state->initialized)
+                {
+                    telemetry::unregister_frame_records(state->frameRecords);
+                    ShutdownRenderContext(win);
+                }
+                return std::nullopt;
+            });
+    }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
-        }
+    // Software, noop and Vulkan windows have no thread affinity and join the
+    // shared pool when one is requested; everything else gets its own thread.
+    void MultiContextManager::LaunchRenderLoop(WindowData& win)
+    {
+        HWND hwnd = win.hwnd;
+        if (g_threads.contains(hwnd) || g_pooledLoops.contains(hwnd))
+            return;
 
-        win.commandQueue.drain();
+        if (cli::render_workers != 0 && win.context && render_pool_eligible(win.context->type))
+        {
+            if (!g_renderPool)
+            {
+                g_renderPool = std::make_unique<RenderWorkerPool>(cli::render_workers > 0
+                    ? static_cast<std::size_t>(cli::render_workers)
+                    : RenderWorkerPool::default_worker_count());
+            }
+            g_pooledLoops[hwnd] = SubmitPooledRenderLoop(win);
+            return;
+        }
 
-        if (ctx->cleanup) ctx->cleanup_safe();
+        WindowData* raw = &win;
+        g_threads[hwnd] = std::thread([this, raw]() { RenderLoop(*raw); });
     }
 
     void MultiContextManager::HandleDropFiles(HWND, HDROP hDrop)
@@ -112,6 +112,7 @@ import acontext.opengl.context;
 #endif
 #if defined(ALMOND_USING_SOFTWARE_RENDERER)
 import acontext.softrenderer.context;
+import acontext.softrenderer.capture;
 #endif
 #if defined(ALMOND_USING_SDL)
 import acontext.sdl.context;
@@ -138,6 +139,7 @@ namespace almondnamespace::core
         using PumpFunction = std::function<bool()>;
 
         int RunEditorInterfaceLoop(MultiContextManager& mgr, PumpFunction pump_events);
+        int RunHeadlessStress(int windowCount);
 #if defined(_WIN32)
         int RunEngineMainLoopInternal(HINSTANCE hInstance, int nCmdShow);
 #elif defined(__linux__)
@@ -175,6 +177,43 @@ namespace almondnamespace::core
 
     inline std::vector<std::unique_ptr<TextureUploadQueue>> uploadQueues;
 
+    // Applies --headless / --capture for the lifetime of a run; the stream
+    // is flushed and joined when the scope ends.
+    struct SoftwareCaptureScope
+    {
+        SoftwareCaptureScope()
+        {
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+            if (cli::software_headless)
+                anativecontext::softrenderer_set_headless(true);
+
+            if (!cli::capture_directory.empty())
+            {
+                anativecontext::capture::start_frame_stream({
+                    .directory = cli::capture_directory,
+                    .everyNthFrame = cli::capture_every });
+                streaming = true;
+            }
+#else
+            if (cli::software_headless || !cli::capture_directory.empty())
+                std::cerr << "[Engine] --headless/--capture need the software renderer; ignoring.\n";
+#endif
+        }
+
+        ~SoftwareCaptureScope()
+        {
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+            if (streaming)
+                anativecontext::capture::stop_frame_stream();
+#endif
+        }
+
+        SoftwareCaptureScope(const SoftwareCaptureScope&) = delete;
+        SoftwareCaptureScope& operator=(const SoftwareCaptureScope&) = delete;
+
+        bool streaming = false;
+    };
+
     BackendWindowCounts ResolveBackendWindowCounts()
     {
         BackendWindowCounts counts{};
@@ -415,6 +454,10 @@ int WINAPI wWinMain(
             return 0;
         }
 
+        if (almondnamespace::core::cli::headless_stress_windows > 0)
+            return almondnamespace::core::engine::RunHeadlessStress(almondnamespace::core::cli::headless_stress_windows);
+
+        const almondnamespace::core::SoftwareCaptureScope capture_scope{};
         return almondnamespace::core::engine::RunEngineMainLoopInternal(hInstance, SW_SHOWNORMAL);
     }
     catch (const std::exception& ex)
@@ -459,6 +502,10 @@ int main(int argc, char** argv)
             return 0;
         }
 
+        if (almondnamespace::core::cli::headless_stress_windows > 0)
+            return almondnamespace::core::engine::RunHeadlessStress(almondnamespace::core::cli::headless_stress_windows);
+
+        const almondnamespace::core::SoftwareCaptureScope capture_scope{};
         almondnamespace::core::StartEngine();
         return 0;
     }
@@ -25,6 +25,7 @@
  // aengine.gui.cpp  (TU version of former aengine.gui module unit)
 
 import aengine.core.context;
+import aengine.context.commandqueue;
 import aengine.context.multiplexer;
 import aengine.context.window;
 
@@ -178,6 +179,31 @@ namespace almondnamespace::gui
     static thread_local std::vector<InputEvent> g_pendingEvents{};
     static thread_local const void* g_activeWidget = nullptr;
 
+    struct WindowState::Impl
+    {
+        FrameState frame{};
+        const void* activeWidget = nullptr;
+    };
+
+    WindowState::WindowState() : impl_(std::make_unique<Impl>()) {}
+    WindowState::~WindowState() = default;
+    WindowState::WindowState(WindowState&&) noexcept = default;
+    WindowState& WindowState::operator=(WindowState&&) noexcept = default;
+
+    // Swaps the window's state into this thread's slots and back out again.
+    WindowStateScope::WindowStateScope(WindowState& state) noexcept
+        : state_(state)
+    {
+        std::swap(g_frame, state_.impl_->frame);
+        std::swap(g_activeWidget, state_.impl_->activeWidget);
+    }
+
+    WindowStateScope::~WindowStateScope()
+    {
+        std::swap(g_frame, state_.impl_->frame);
+        std::swap(g_activeWidget, state_.impl_->activeWidget);
+    }
+
     [[nodiscard]] static std::vector<std::uint8_t> make_solid_pixels(
         std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a,
         std::uint32_t w, std::uint32_t h)
@@ -462,7 +488,7 @@ namespace almondnamespace::gui
                         try { perform_backend_upload(*self); }
                         catch (...) { /* GUI optional */ }
                     }
-                });
+                }, core::CommandPriority::Upload);
             return;
         }
 
@@ -44,6 +44,8 @@
 // -----------------------------
 import <algorithm>;
 import <chrono>;
+import <exception>;
+import <format>;
 import <functional>;
 import <iostream>;
 import <memory>;
@@ -67,10 +69,17 @@ import aengine.cli;
 import aengine.input;
 import aengine.engine_components;
 
+import aengine.context.commandqueue;
 import aengine.context.multiplexer;
 import aengine.context.type;
+import aengine.context.window;
 import aengine.core.context;
+import aengine.core.framepacer;
 import aengine.core.logger;
+import aengine.core.time;
+import aengine.systems;            // Task
+import aengine.taskgraph.dotsystem; // taskgraph::TaskGraph
+import aengine.telemetry;
 
 import aengine.gui;
 import aengine.gui.menu;
@@ -93,6 +102,9 @@ import acontext.sfml.context;
 #if defined(ALMOND_USING_RAYLIB)
 import acontext.raylib.context;
 #endif
+#if defined(ALMOND_USING_NOOP_HEADLESS)
+import acontext.noop.context;
+#endif
 
 namespace input = almondnamespace::input;
 namespace menu = almondnamespace::menu;
@@ -102,6 +114,107 @@ namespace almondnamespace::core::engine
 {
     using PumpFunction = std::function<bool()>;
 
+    namespace
+    {
+        // Input is sampled once per frame on the main thread and shared by
+        // every window's update.
+        struct FrameInput
+        {
+            bool mouse_left_down = false;
+            bool up_pressed = false;
+            bool down_pressed = false;
+            bool left_pressed = false;
+            bool right_pressed = false;
+            bool enter_pressed = false;
+        };
+
+        FrameInput sample_frame_input()
+        {
+            FrameInput in{};
+            in.mouse_left_down = input::mouseDown.test(input::MouseButton::MouseLeft);
+            in.up_pressed = input::keyPressed.test(input::Key::Up);
+            in.down_pressed = input::keyPressed.test(input::Key::Down);
+            in.left_pressed = input::keyPressed.test(input::Key::Left);
+            in.right_pressed = input::keyPressed.test(input::Key::Right);
+            in.enter_pressed = input::keyPressed.test(input::Key::Enter);
+            return in;
+        }
+
+        // Drops per-window slots whose context left the snapshot.
+        template <class Slot>
+        void prune_window_slots(std::unordered_map<Context*, Slot>& slots, const ContextSnapshot& snapshot)
+        {
+            std::erase_if(slots, [&](const auto& entry)
+                {
+                    for (const auto& [type, contexts] : snapshot.groups)
+                        for (const auto& ctx : contexts)
+                            if (ctx.get() == entry.first) return false;
+                    return true;
+                });
+        }
+
+        inline Task run_window_update(const std::function<void(std::size_t)>* fn, std::size_t index)
+        {
+            (*fn)(index);
+            co_return;
+        }
+
+        // Runs one update per window and returns once all have finished. With
+        // more than one window and concurrent set, each update is a TaskGraph
+        // node and the main thread only joins; otherwise they run inline in
+        // window order. The first exception is rethrown on the caller.
+        class WindowUpdateBatch
+        {
+        public:
+            void run(std::size_t count, const std::function<void(std::size_t)>& update, bool concurrent = true)
+            {
+                std::exception_ptr failure{};
+                std::mutex failureMutex;
+                const std::function<void(std::size_t)> guarded = [&](std::size_t index)
+                    {
+                        try
+                        {
+                            update(index);
+                        }
+                        catch (...)
+                        {
+                            std::scoped_lock lock(failureMutex);
+                            if (!failure) failure = std::current_exception();
+                        }
+                    };
+
+                const std::size_t hw = std::thread::hardware_concurrency();
+                if (!concurrent || count < 2 || hw <= 1)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                        guarded(i);
+                }
+                else
+                {
+                    if (!graph_)
+                        graph_ = std::make_unique<taskgraph::TaskGraph>(hw - 1);
+
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        auto node = std::make_unique<taskgraph::Node>(run_window_update(&guarded, i));
+                        node->Label = "WindowUpdate";
+                        graph_->AddNode(std::move(node));
+                    }
+
+                    graph_->Execute();
+                    graph_->WaitAll();
+                    graph_->PruneFinished();
+                }
+
+                if (failure)
+                    std::rethrow_exception(failure);
+            }
+
+        private:
+            std::unique_ptr<taskgraph::TaskGraph> graph_;
+        };
+    }
+
     int RunEditorInterfaceLoop(MultiContextManager& mgr, PumpFunction pump_events)
     {
         enum class EditorSceneState
@@ -116,60 +229,100 @@ namespace almondnamespace::core::engine
 
         using MenuOverlay = almondnamespace::menu::MenuOverlay;
         using EditorCommandOverlay = almondnamespace::menu::EditorCommandOverlay;
-        MenuOverlay games_menu{};
-        EditorCommandOverlay editor_menu{};
 
-        games_menu.set_max_columns(almondnamespace::core::cli::menu_columns);
-        editor_menu.initialize();
-
-        auto collect_backend_contexts = []()
-            {
-                using ContextGroup = std::pair<
-                    almondnamespace::core::ContextType,
-                    std::vector<std::shared_ptr<almondnamespace::core::Context>>
-                >;
-
-                std::vector<ContextGroup> snapshot;
-
-                {
-                    std::shared_lock lock(almondnamespace::core::g_backendsMutex);
-                    snapshot.reserve(almondnamespace::core::g_backends.size());
-
-                    for (auto& [type, state] : almondnamespace::core::g_backends)
-                    {
-                        std::vector<std::shared_ptr<almondnamespace::core::Context>> contexts;
-                        contexts.reserve(1 + state.duplicates.size());
+        // Everything a window's update touches lives in its slot, so windows
+        // update concurrently; shared state is applied after the join.
+        struct WindowSlot
+        {
+            gui::WindowState gui_state{};
+            MenuOverlay games_menu{};
+            EditorCommandOverlay editor_menu{};
+            std::optional<std::chrono::steady_clock::time_point> last_frame{};
+        };
 
-                        if (state.master) contexts.push_back(state.master);
-                        for (auto& dup : state.duplicates) contexts.push_back(dup);
+        struct WindowResult
+        {
+            bool alive = true;
+            bool editor_clicked = false;
+            bool scene_ended = false;
+            std::optional<almondnamespace::menu::EditorCommandChoice> command{};
+            std::optional<almondnamespace::menu::Choice> game{};
+        };
 
-                        snapshot.emplace_back(type, std::move(contexts));
-                    }
-                }
+        struct WindowWork
+        {
+            std::shared_ptr<Context> ctx{};
+            WindowData* win = nullptr;
+            WindowSlot* slot = nullptr;
+            WindowResult result{};
+        };
 
-                return snapshot;
-            };
+        std::unordered_map<Context*, WindowSlot> window_slots;
+        std::vector<WindowWork> work;
+        WindowUpdateBatch batch{};
 
-        auto init_menus = [&]()
+        auto reset_menus = [&](WindowSlot& slot)
             {
-                auto snapshot = collect_backend_contexts();
-                for (auto& [_, contexts] : snapshot)
-                    for (auto& ctx : contexts)
-                    {
-                        if (ctx)
-                        {
-                            games_menu.initialize_game_choices();
-                            games_menu.recompute_layout(ctx, ctx->get_width_safe(), ctx->get_height_safe());
-                        }
-                    }
+                slot.games_menu.set_max_columns(almondnamespace::core::cli::menu_columns);
+                slot.games_menu.initialize_game_choices();
+                slot.editor_menu.initialize();
             };
 
-        init_menus();
-
-        std::unordered_map<Context*, std::chrono::steady_clock::time_point> last_frame_times;
         bool running = true;
         bool show_games_popup = false;
         PumpFunction pump = std::move(pump_events);
+        FramePacer pacer{ cli::pacing_config() };
+        std::shared_ptr<const ContextSnapshot> context_set{};
+        auto sim_clock = almondnamespace::timing::createFixedStep(60.0);
+
+        auto begin_scene = [&](auto make_scene, const char* label)
+            {
+                for (auto& [__, group] : context_set->groups)
+                    for (auto& c : group)
+                        if (c && c->windowData) c->windowData->commandQueue.clear();
+
+                for (auto& [__, slot] : window_slots)
+                    slot.games_menu.cleanup();
+
+                if (active_scene)
+                    active_scene->unload();
+
+                active_scene = make_scene();
+                active_scene->load();
+                almondnamespace::timing::resetFixed(sim_clock);
+                // state = EditorSceneState::Game;
+                state = EditorSceneState::Editor;
+                show_games_popup = false;
+                std::cout << "[Editor] Launching " << label << " scene.\n";
+            };
+
+        auto launch_game = [&](almondnamespace::menu::Choice choice)
+            {
+                using almondnamespace::menu::Choice;
+
+                if (choice == Choice::Snake)
+                    begin_scene(CreateSnakeScene, "Snake");
+                else if (choice == Choice::Tetris)
+                    begin_scene(CreateTetrisScene, "Tetris");
+                else if (choice == Choice::Frogger)
+                    begin_scene(CreateFroggerScene, "Frogger");
+                else if (choice == Choice::Pacman)
+                    begin_scene(CreatePacmanScene, "Pacman");
+                else if (choice == Choice::Sokoban)
+                    begin_scene(CreateSokobanScene, "Sokoban");
+                else if (choice == Choice::Bejeweled)
+                    begin_scene(CreateMatch3Scene, "Match-3");
+                else if (choice == Choice::Puzzle)
+                    begin_scene(CreateSlidingPuzzleScene, "Sliding Puzzle");
+                else if (choice == Choice::Minesweep)
+                    begin_scene(CreateMinesweeperScene, "Minesweeper");
+                else if (choice == Choice::Fourty)
+                    begin_scene(Create2048Scene, "2048");
+                else if (choice == Choice::Sandsim)
+                    begin_scene(CreateSandSimScene, "Sand Sim");
+                else if (choice == Choice::Cellular)
+                    begin_scene(CreateCellularSimScene, "Cellular");
+            };
 
         while (running)
         {
@@ -181,242 +334,210 @@ namespace almondnamespace::core::engine
 
             mgr.CleanupFinishedWindows();
 
-            auto snapshot = collect_backend_contexts();
-#if !defined(ALMOND_SINGLE_PARENT)
+            // Simulate once per tick for the whole loop, not once per window.
+            bool scene_finished = false;
+            if (state == EditorSceneState::Game && active_scene)
+            {
+                const int steps = almondnamespace::timing::tickFixed(sim_clock);
+                for (int i = 0; i < steps && !scene_finished; ++i)
+                    scene_finished = !active_scene->update(sim_clock.step);
+            }
+
+            // Republished by the multiplexer on window add/remove; steady-state
+            // frames only compare versions.
+            if (refresh_context_snapshot(context_set))
+                prune_window_slots(window_slots, *context_set);
+
+            const EditorSceneState frame_state = state;
+            const bool frame_popup = show_games_popup;
+            const FrameInput frame_input = sample_frame_input();
+
             bool any_context_alive = false;
-#endif
-            for (auto& [type, contexts] : snapshot)
+            work.clear();
+            for (auto& [type, contexts] : context_set->groups)
             {
-                auto update_on_ctx = [&](std::shared_ptr<Context> ctx) -> bool
+                for (auto& ctx : contexts)
+                {
+                    if (!ctx) continue;
+
+                    auto* win = mgr.findWindowByContext(ctx);
+                    if (!win)
                     {
-                        if (!ctx) return true;
+                        any_context_alive = true;
+                        continue;
+                    }
 
-                        auto* win = mgr.findWindowByContext(ctx);
-                        if (!win) return true;
+                    auto [slot, inserted] = window_slots.try_emplace(ctx.get());
+                    if (inserted)
+                    {
+                        reset_menus(slot->second);
+                        slot->second.games_menu.recompute_layout(ctx, ctx->get_width_safe(), ctx->get_height_safe());
+                    }
+                    work.push_back(WindowWork{ ctx, win, &slot->second });
+                }
+            }
 
-                        bool ctx_running = win->running;
+            batch.run(work.size(), [&](std::size_t index)
+                {
+                    auto& [ctx, win, slot, result] = work[index];
+                    result.alive = win->running;
 
-                        const auto now = std::chrono::steady_clock::now();
-                        const auto raw = ctx.get();
+                    const auto now = std::chrono::steady_clock::now();
+                    const float dt = slot->last_frame
+                        ? std::chrono::duration<float>(now - *slot->last_frame).count()
+                        : 0.0f;
+                    slot->last_frame = now;
 
-                        float dt = 0.0f;
-                        auto [it, inserted] = last_frame_times.emplace(raw, now);
-                        if (!inserted)
+                    if (frame_state == EditorSceneState::Editor)
+                    {
+                        int mx = 0, my = 0;
+                        ctx->get_mouse_position_safe(mx, my);
+
+                        const gui::Vec2 mouse_pos{
+                            static_cast<float>(mx),
+                            static_cast<float>(my)
+                        };
+
+                        ctx->clear_safe();
+                        gui::WindowStateScope gui_scope{ slot->gui_state };
+                        gui::begin_frame(ctx, dt, mouse_pos, frame_input.mouse_left_down);
+                        gui::WidgetBounds editor_bounds{};
+                        result.editor_clicked = almondnamespace::editor_run(ctx, &editor_bounds);
+
+                        // Popup toggles from this window apply to its own draw at
+                        // once and to the shared flag after the join.
+                        bool popup = frame_popup != result.editor_clicked;
+
+                        const bool draw_editor_overlay = !popup;
+                        const bool menu_has_focus = draw_editor_overlay;
+                        if (draw_editor_overlay)
                         {
-                            dt = std::chrono::duration<float>(now - it->second).count();
-                            it->second = now;
+                            result.command = slot->editor_menu.update_and_draw(
+                                ctx,
+                                win,
+                                dt,
+                                menu_has_focus ? frame_input.up_pressed : false,
+                                menu_has_focus ? frame_input.down_pressed : false,
+                                menu_has_focus ? frame_input.enter_pressed : false,
+                                menu_has_focus,
+                                editor_bounds);
                         }
 
-                        auto begin_scene = [&](auto make_scene, const char* label)
-                            {
-                                auto clear_commands = [](const std::shared_ptr<Context>& c)
-                                    {
-                                        if (c && c->windowData) c->windowData->commandQueue.clear();
-                                    };
-
-                                auto snap2 = collect_backend_contexts();
-                                for (auto& [__, group] : snap2)
-                                    for (auto& c : group)
-                                        clear_commands(c);
-
-                                games_menu.cleanup();
-
-                                if (active_scene)
-                                    active_scene->unload();
-
-                                active_scene = make_scene();
-                                active_scene->load();
-                                // state = EditorSceneState::Game;
-                                state = EditorSceneState::Editor;
-                                show_games_popup = false;
-                                std::cout << "[Editor] Launching " << label << " scene.\n";
-                            };
+                        if (result.command == almondnamespace::menu::EditorCommandChoice::RunGame)
+                            popup = !popup;
 
-                        if (state == EditorSceneState::Editor)
+                        if (popup)
                         {
-                            int mx = 0, my = 0;
-                            ctx->get_mouse_position_safe(mx, my);
+                            const float popup_width = (std::max)(600.0f, ctx->get_width_safe() * 0.7f);
+                            const float popup_height = (std::max)(360.0f, ctx->get_height_safe() * 0.6f);
 
-                            const gui::Vec2 mouse_pos{
-                                static_cast<float>(mx),
-                                static_cast<float>(my)
+                            const gui::Vec2 popup_size{ popup_width, popup_height };
+                            const gui::Vec2 popup_pos{
+                                (ctx->get_width_safe() - popup_size.x) * 0.5f,
+                                (ctx->get_height_safe() - popup_size.y) * 0.5f
                             };
 
-                            const bool mouse_left_down =
-                                almondnamespace::input::mouseDown.test(almondnamespace::input::MouseButton::MouseLeft);
-
-                            const bool up_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Up);
-                            const bool down_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Down);
-                            const bool left_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Left);
-                            const bool right_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Right);
-                            const bool enter_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Enter);
-
-                            ctx->clear_safe();
-                            gui::begin_frame(ctx, dt, mouse_pos, mouse_left_down);
-                            gui::WidgetBounds editor_bounds{};
-                            const bool editor_clicked = almondnamespace::editor_run(ctx, &editor_bounds);
-                            if (editor_clicked)
-                                show_games_popup = !show_games_popup;
-
-                            const bool draw_editor_overlay = !show_games_popup;
-                            const bool menu_has_focus = draw_editor_overlay;
-                            std::optional<almondnamespace::menu::EditorCommandChoice> command_choice{};
-                            if (draw_editor_overlay)
-                            {
-                                command_choice = editor_menu.update_and_draw(
-                                    ctx,
-                                    win,
-                                    dt,
-                                    menu_has_focus ? up_pressed : false,
-                                    menu_has_focus ? down_pressed : false,
-                                    menu_has_focus ? enter_pressed : false,
-                                    menu_has_focus,
-                                    editor_bounds);
-                            }
-
-                            if (command_choice)
-                            {
-                                using almondnamespace::menu::EditorCommandChoice;
-
-                                switch (*command_choice)
-                                {
-                                case EditorCommandChoice::OpenProject:
-                                    std::cout << "[Editor] Open Project selected.\n";
-                                    break;
-                                case EditorCommandChoice::Settings:
-                                    std::cout << "[Editor] Settings selected.\n";
-                                    break;
-                                case EditorCommandChoice::RunGame:
-                                    show_games_popup = !show_games_popup;
-                                    break;
-                                case EditorCommandChoice::Exit:
-                                    state = EditorSceneState::Exit;
-                                    running = false;
-                                    break;
-                                }
-                            }
-
-                            if (show_games_popup)
-                            {
-                                const float popup_width = (std::max)(600.0f, ctx->get_width_safe() * 0.7f);
-                                const float popup_height = (std::max)(360.0f, ctx->get_height_safe() * 0.6f);
-
-                                const gui::Vec2 popup_size{ popup_width, popup_height };
-                                const gui::Vec2 popup_pos{
-                                    (ctx->get_width_safe() - popup_size.x) * 0.5f,
-                                    (ctx->get_height_safe() - popup_size.y) * 0.5f
-                                };
-
-                                auto game_choice = games_menu.update_and_draw_in_window(
-                                    ctx,
-                                    win,
-                                    dt,
-                                    up_pressed,
-                                    down_pressed,
-                                    left_pressed,
-                                    right_pressed,
-                                    enter_pressed,
-                                    "Games",
-                                    popup_pos,
-                                    popup_size,
-                                    true);
-
-                                if (game_choice)
-                                {
-                                    using almondnamespace::menu::Choice;
-
-                                    if (*game_choice == Choice::Snake)
-                                        begin_scene(CreateSnakeScene, "Snake");
-                                    else if (*game_choice == Choice::Tetris)
-                                        begin_scene(CreateTetrisScene, "Tetris");
-                                    else if (*game_choice == Choice::Frogger)
-                                        begin_scene(CreateFroggerScene, "Frogger");
-                                    else if (*game_choice == Choice::Pacman)
-                                        begin_scene(CreatePacmanScene, "Pacman");
-                                    else if (*game_choice == Choice::Sokoban)
-                                        begin_scene(CreateSokobanScene, "Sokoban");
-                                    else if (*game_choice == Choice::Bejeweled)
-                                        begin_scene(CreateMatch3Scene, "Match-3");
-                                    else if (*game_choice == Choice::Puzzle)
-                                        begin_scene(CreateSlidingPuzzleScene, "Sliding Puzzle");
-                                    else if (*game_choice == Choice::Minesweep)
-                                        begin_scene(CreateMinesweeperScene, "Minesweeper");
-                                    else if (*game_choice == Choice::Fourty)
-                                        begin_scene(Create2048Scene, "2048");
-                                    else if (*game_choice == Choice::Sandsim)
-                                        begin_scene(CreateSandSimScene, "Sand Sim");
-                                    else if (*game_choice == Choice::Cellular)
-                                        begin_scene(CreateCellularSimScene, "Cellular");
-                                }
-                            }
-
-                            gui::end_frame();
-                            ctx->present_safe();
-                        }
-                        else if (state == EditorSceneState::Game)
-                        {
-                            if (active_scene)
-                            {
-                                ctx_running = active_scene->frame(ctx, win);
-                                if (!ctx_running)
-                                {
-                                    active_scene->unload();
-                                    active_scene.reset();
-                                    state = EditorSceneState::Editor;
-                                    games_menu.cleanup();
-                                    games_menu.initialize_game_choices();
-                                    editor_menu.reset_selection();
-                                }
-                            }
-                            else
-                            {
-                                state = EditorSceneState::Editor;
-                            }
-                        }
-                        else if (state == EditorSceneState::Exit)
-                        {
-                            running = false;
+                            result.game = slot->games_menu.update_and_draw_in_window(
+                                ctx,
+                                win,
+                                dt,
+                                frame_input.up_pressed,
+                                frame_input.down_pressed,
+                                frame_input.left_pressed,
+                                frame_input.right_pressed,
+                                frame_input.enter_pressed,
+                                "Games",
+                                popup_pos,
+                                popup_size,
+                                true);
                         }
 
-                        if (!ctx_running)
-                            last_frame_times.erase(raw);
+                        gui::end_frame();
+                        ctx->present_safe();
+                    }
+                    else if (frame_state == EditorSceneState::Game && active_scene)
+                    {
+                        result.alive = !scene_finished && active_scene->render(ctx, win, sim_clock.alpha);
+                        result.scene_ended = !result.alive;
+                    }
 
-                        return ctx_running;
-                    };
+                    if (!result.alive)
+                        slot->last_frame.reset();
+                },
+                // One scene instance is shared by every window, so game frames
+                // render in window order; editor frames run in parallel.
+                frame_state != EditorSceneState::Game);
 
-#if defined(ALMOND_SINGLE_PARENT)
-                if (!contexts.empty())
+            // Apply shared transitions in window order, as the serial loop did.
+            bool scene_changed = false;
+            for (auto& [ctx, win, slot, result] : work)
+            {
+                if (result.editor_clicked)
+                    show_games_popup = !show_games_popup;
+
+                if (result.command)
                 {
-                    auto master = contexts.front();
-                    if (master && !update_on_ctx(master)) { running = false; break; }
+                    using almondnamespace::menu::EditorCommandChoice;
 
-                    for (std::size_t i = 1; i < contexts.size(); ++i)
-                        if (!update_on_ctx(contexts[i])) running = false;
+                    switch (*result.command)
+                    {
+                    case EditorCommandChoice::OpenProject:
+                        std::cout << "[Editor] Open Project selected.\n";
+                        break;
+                    case EditorCommandChoice::Settings:
+                        std::cout << "[Editor] Settings selected.\n";
+                        break;
+                    case EditorCommandChoice::RunGame:
+                        show_games_popup = !show_games_popup;
+                        break;
+                    case EditorCommandChoice::Exit:
+                        state = EditorSceneState::Exit;
+                        running = false;
+                        break;
+                    }
                 }
-#else
-                bool any_alive = false;
-                for (std::size_t i = 0; i < contexts.size(); ++i)
+
+                // The first launch or scene exit wins; later windows saw the old scene.
+                if (result.game && !scene_changed)
                 {
-                    auto& ctx = contexts[i];
-                    if (!ctx) continue;
+                    launch_game(*result.game);
+                    scene_changed = true;
+                }
 
-                    const bool alive = update_on_ctx(ctx);
-                    if (alive) any_alive = true;
+                if (result.scene_ended && !scene_changed && active_scene)
+                {
+                    active_scene->unload();
+                    active_scene.reset();
+                    state = EditorSceneState::Editor;
+                    for (auto& [__, other] : window_slots)
+                    {
+                        other.games_menu.cleanup();
+                        reset_menus(other);
+                        other.editor_menu.reset_selection();
+                    }
+                    scene_changed = true;
                 }
-                if (any_alive) any_context_alive = true;
+
+#if defined(ALMOND_SINGLE_PARENT)
+                if (!result.alive) running = false;
+#else
+                if (result.alive) any_context_alive = true;
 #endif
-                if (!running) break;
             }
+
+            if (frame_state == EditorSceneState::Game && !active_scene)
+                state = EditorSceneState::Editor;
+            else if (frame_state == EditorSceneState::Exit)
+                running = false;
+
 #if !defined(ALMOND_SINGLE_PARENT)
             if (!any_context_alive) running = false;
+#else
+            (void)any_context_alive;
 #endif
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            // Input (or an engine wakeup) starts the next frame early.
+            pacer.wait(false, almondnamespace::platform::wait_events);
+            telemetry::emit_frame_pacing("main", pacer.stats(), {});
         }
 
         if (active_scene)
@@ -425,10 +546,11 @@ namespace almondnamespace::core::engine
             active_scene.reset();
         }
 
-        games_menu.cleanup();
+        for (auto& [__, slot] : window_slots)
+            slot.games_menu.cleanup();
 
-        auto snapshot2 = collect_backend_contexts();
-        for (auto& [type, contexts] : snapshot2)
+        auto snapshot2 = almondnamespace::core::context_snapshot();
+        for (auto& [type, contexts] : snapshot2->groups)
         {
             auto cleanup_backend = [&](std::shared_ptr<almondnamespace::core::Context> ctx)
                 {
@@ -499,51 +621,100 @@ namespace almondnamespace::core::engine
         std::unique_ptr<almondnamespace::scene::Scene> active_scene{};
 
         using MenuOverlay = almondnamespace::menu::MenuOverlay;
-        MenuOverlay menu{};
-        menu.set_max_columns(almondnamespace::core::cli::menu_columns);
 
-        auto collect_backend_contexts = []()
-            {
-                using ContextGroup = std::pair<
-                    almondnamespace::core::ContextType,
-                    std::vector<std::shared_ptr<almondnamespace::core::Context>>
-                >;
+        // Everything a window's update touches lives in its slot, so windows
+        // update concurrently; shared state is applied after the join.
+        struct WindowSlot
+        {
+            gui::WindowState gui_state{};
+            MenuOverlay menu{};
+            std::optional<std::chrono::steady_clock::time_point> last_frame{};
+        };
 
-                std::vector<ContextGroup> snapshot;
+        struct WindowResult
+        {
+            bool alive = true;
+            bool scene_ended = false;
+            std::optional<almondnamespace::menu::Choice> choice{};
+        };
 
-                {
-                    std::shared_lock lock(almondnamespace::core::g_backendsMutex);
-                    snapshot.reserve(almondnamespace::core::g_backends.size());
+        struct WindowWork
+        {
+            std::shared_ptr<Context> ctx{};
+            WindowData* win = nullptr;
+            WindowSlot* slot = nullptr;
+            WindowResult result{};
+        };
 
-                    for (auto& [type, state] : almondnamespace::core::g_backends)
-                    {
-                        std::vector<std::shared_ptr<almondnamespace::core::Context>> contexts;
-                        contexts.reserve(1 + state.duplicates.size());
+        std::unordered_map<Context*, WindowSlot> window_slots;
+        std::vector<WindowWork> work;
+        WindowUpdateBatch batch{};
 
-                        if (state.master) contexts.push_back(state.master);
-                        for (auto& dup : state.duplicates) contexts.push_back(dup);
+        auto init_menu = [&](WindowSlot& slot, const std::shared_ptr<Context>& ctx)
+            {
+                slot.menu.set_max_columns(almondnamespace::core::cli::menu_columns);
+                slot.menu.initialize(ctx);
+            };
 
-                        snapshot.emplace_back(type, std::move(contexts));
-                    }
-                }
+        bool running = true;
+        PumpFunction pump = std::move(pump_events);
+        FramePacer pacer{ cli::pacing_config() };
+        std::shared_ptr<const ContextSnapshot> context_set{};
+        auto sim_clock = almondnamespace::timing::createFixedStep(60.0);
+
+        auto begin_scene = [&](auto make_scene, SceneID id)
+            {
+                for (auto& [__, group] : context_set->groups)
+                    for (auto& c : group)
+                        if (c && c->windowData) c->windowData->commandQueue.clear();
+
+                for (auto& [__, slot] : window_slots)
+                    slot.menu.cleanup();
 
-                return snapshot;
+                if (active_scene)
+                    active_scene->unload();
+
+                active_scene = make_scene();
+                active_scene->load();
+                almondnamespace::timing::resetFixed(sim_clock);
+                scene_id = id;
             };
 
-        auto init_menu = [&]()
+        auto apply_choice = [&](almondnamespace::menu::Choice choice)
             {
-                auto snapshot = collect_backend_contexts();
-                for (auto& [_, contexts] : snapshot)
-                    for (auto& ctx : contexts)
-                        if (ctx) menu.initialize(ctx);
+                using almondnamespace::menu::Choice;
+
+                if (choice == Choice::Snake)
+                    begin_scene(CreateSnakeScene, SceneID::Snake);
+                else if (choice == Choice::Tetris)
+                    begin_scene(CreateTetrisScene, SceneID::Tetris);
+                else if (choice == Choice::Frogger)
+                    begin_scene(CreateFroggerScene, SceneID::Frogger);
+                else if (choice == Choice::Pacman)
+                    begin_scene(CreatePacmanScene, SceneID::Pacman);
+                else if (choice == Choice::Sokoban)
+                    begin_scene(CreateSokobanScene, SceneID::Sokoban);
+                else if (choice == Choice::Bejeweled)
+                    begin_scene(CreateMatch3Scene, SceneID::Match3);
+                else if (choice == Choice::Puzzle)
+                    begin_scene(CreateSlidingPuzzleScene, SceneID::Sliding);
+                else if (choice == Choice::Minesweep)
+                    begin_scene(CreateMinesweeperScene, SceneID::Minesweeper);
+                else if (choice == Choice::Fourty)
+                    begin_scene(Create2048Scene, SceneID::Game2048);
+                else if (choice == Choice::Sandsim)
+                    begin_scene(CreateSandSimScene, SceneID::Sandsim);
+                else if (choice == Choice::Cellular)
+                    begin_scene(CreateCellularSimScene, SceneID::Cellular);
+                else if (choice == Choice::Settings)
+                    std::cout << "[Menu] Settings selected.\n";
+                else if (choice == Choice::Exit)
+                {
+                    scene_id = SceneID::Exit;
+                    running = false;
+                }
             };
 
-        init_menu();
-
-        std::unordered_map<Context*, std::chrono::steady_clock::time_point> last_frame_times;
-        bool running = true;
-        PumpFunction pump = std::move(pump_events);
-
         while (running)
         {
             if (!pump())
@@ -554,191 +725,152 @@ namespace almondnamespace::core::engine
 
             mgr.CleanupFinishedWindows();
 
-            auto snapshot = collect_backend_contexts();
-#if !defined(ALMOND_SINGLE_PARENT)
-            bool any_context_alive = false;
-#endif
-            for (auto& [type, contexts] : snapshot)
+            // Simulate once per tick for the whole loop, not once per window.
+            bool scene_finished = false;
+            if (active_scene && scene_id != SceneID::Menu && scene_id != SceneID::Exit)
             {
-                auto update_on_ctx = [&](std::shared_ptr<Context> ctx) -> bool
-                    {
-                        if (!ctx) return true;
-
-                        // FIX: never touch ctx->hwnd (private). Manager can resolve by context.
-                        auto* win = mgr.findWindowByContext(ctx);
-                        if (!win) return true;
-
-                        bool ctx_running = win->running;
-
-                        const auto now = std::chrono::steady_clock::now();
-                        const auto raw = ctx.get();
-
-                        float dt = 0.0f;
-                        auto [it, inserted] = last_frame_times.emplace(raw, now);
-                        if (!inserted)
-                        {
-                            dt = std::chrono::duration<float>(now - it->second).count();
-                            it->second = now;
-                        }
+                const int steps = almondnamespace::timing::tickFixed(sim_clock);
+                for (int i = 0; i < steps && !scene_finished; ++i)
+                    scene_finished = !active_scene->update(sim_clock.step);
+            }
 
-                        auto begin_scene = [&](auto make_scene, SceneID id)
-                            {
-                                auto clear_commands = [](const std::shared_ptr<Context>& c)
-                                    {
-                                        // If your WindowData/queue moved behind accessors, change this here.
-                                        if (c && c->windowData) c->windowData->commandQueue.clear();
-                                    };
+            // Republished by the multiplexer on window add/remove; steady-state
+            // frames only compare versions.
+            if (refresh_context_snapshot(context_set))
+                prune_window_slots(window_slots, *context_set);
 
-                                auto snap2 = collect_backend_contexts();
-                                for (auto& [__, group] : snap2)
-                                    for (auto& c : group)
-                                        clear_commands(c);
+            const SceneID frame_scene = scene_id;
+            const FrameInput frame_input = sample_frame_input();
 
-                                menu.cleanup();
+            bool any_context_alive = false;
+            work.clear();
+            for (auto& [type, contexts] : context_set->groups)
+            {
+                for (auto& ctx : contexts)
+                {
+                    if (!ctx) continue;
 
-                                if (active_scene)
-                                    active_scene->unload();
+                    // FIX: never touch ctx->hwnd (private). Manager can resolve by context.
+                    auto* win = mgr.findWindowByContext(ctx);
+                    if (!win)
+                    {
+                        any_context_alive = true;
+                        continue;
+                    }
 
-                                active_scene = make_scene();
-                                active_scene->load();
-                                scene_id = id;
-                            };
+                    auto [slot, inserted] = window_slots.try_emplace(ctx.get());
+                    if (inserted)
+                        init_menu(slot->second, ctx);
+                    work.push_back(WindowWork{ ctx, win, &slot->second });
+                }
+            }
 
-                        switch (scene_id)
-                        {
-                        case SceneID::Menu:
-                        {
-                            int mx = 0, my = 0;
-                            ctx->get_mouse_position_safe(mx, my);
+            batch.run(work.size(), [&](std::size_t index)
+                {
+                    auto& [ctx, win, slot, result] = work[index];
+                    result.alive = win->running;
 
-                            const gui::Vec2 mouse_pos{
-                                static_cast<float>(mx),
-                                static_cast<float>(my)
-                            };
+                    const auto now = std::chrono::steady_clock::now();
+                    const float dt = slot->last_frame
+                        ? std::chrono::duration<float>(now - *slot->last_frame).count()
+                        : 0.0f;
+                    slot->last_frame = now;
 
-                            const bool mouse_left_down =
-                                almondnamespace::input::mouseDown.test(almondnamespace::input::MouseButton::MouseLeft);
-
-                            const bool up_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Up);
-                            const bool down_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Down);
-                            const bool left_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Left);
-                            const bool right_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Right);
-                            const bool enter_pressed =
-                                almondnamespace::input::keyPressed.test(almondnamespace::input::Key::Enter);
-
-                            ctx->clear_safe();
-                            gui::begin_frame(ctx, dt, mouse_pos, mouse_left_down);
-                            auto choice = menu.update_and_draw(ctx, win, dt, up_pressed, down_pressed, left_pressed, right_pressed, enter_pressed);
-                            gui::end_frame();
-                            ctx->present_safe();
-
-                            if (choice)
-                            {
-                                using almondnamespace::menu::Choice;
-
-                                if (*choice == Choice::Snake)
-                                    begin_scene(CreateSnakeScene, SceneID::Snake);
-                                else if (*choice == Choice::Tetris)
-                                    begin_scene(CreateTetrisScene, SceneID::Tetris);
-                                else if (*choice == Choice::Frogger)
-                                    begin_scene(CreateFroggerScene, SceneID::Frogger);
-                                else if (*choice == Choice::Pacman)
-                                    begin_scene(CreatePacmanScene, SceneID::Pacman);
-                                else if (*choice == Choice::Sokoban)
-                                    begin_scene(CreateSokobanScene, SceneID::Sokoban);
-                                else if (*choice == Choice::Bejeweled)
-                                    begin_scene(CreateMatch3Scene, SceneID::Match3);
-                                else if (*choice == Choice::Puzzle)
-                                    begin_scene(CreateSlidingPuzzleScene, SceneID::Sliding);
-                                else if (*choice == Choice::Minesweep)
-                                    begin_scene(CreateMinesweeperScene, SceneID::Minesweeper);
-                                else if (*choice == Choice::Fourty)
-                                    begin_scene(Create2048Scene, SceneID::Game2048);
-                                else if (*choice == Choice::Sandsim)
-                                    begin_scene(CreateSandSimScene, SceneID::Sandsim);
-                                else if (*choice == Choice::Cellular)
-                                    begin_scene(CreateCellularSimScene, SceneID::Cellular);
-                                else if (*choice == Choice::Settings)
-                                    std::cout << "[Menu] Settings selected.\n";
-                                else if (*choice == Choice::Exit)
-                                {
-                                    scene_id = SceneID::Exit;
-                                    running = false;
-                                }
-                            }
-                            break;
-                        }
+                    switch (frame_scene)
+                    {
+                    case SceneID::Menu:
+                    {
+                        int mx = 0, my = 0;
+                        ctx->get_mouse_position_safe(mx, my);
+
+                        const gui::Vec2 mouse_pos{
+                            static_cast<float>(mx),
+                            static_cast<float>(my)
+                        };
+
+                        ctx->clear_safe();
+                        gui::WindowStateScope gui_scope{ slot->gui_state };
+                        gui::begin_frame(ctx, dt, mouse_pos, frame_input.mouse_left_down);
+                        result.choice = slot->menu.update_and_draw(ctx, win, dt,
+                            frame_input.up_pressed, frame_input.down_pressed,
+                            frame_input.left_pressed, frame_input.right_pressed,
+                            frame_input.enter_pressed);
+                        gui::end_frame();
+                        ctx->present_safe();
+                        break;
+                    }
 
-                        // cascading case to reset to menu after game exit
-                        case SceneID::Snake:
-                        case SceneID::Tetris:
-                        case SceneID::Pacman:
-                        case SceneID::Frogger:
-                        case SceneID::Sokoban:
-                        case SceneID::Match3:
-                        case SceneID::Sliding:
-                        case SceneID::Minesweeper:
-                        case SceneID::Game2048:
-                        case SceneID::Sandsim:
-                        case SceneID::Cellular:
+                    // cascading case to reset to menu after game exit
+                    case SceneID::Snake:
+                    case SceneID::Tetris:
+                    case SceneID::Pacman:
+                    case SceneID::Frogger:
+                    case SceneID::Sokoban:
+                    case SceneID::Match3:
+                    case SceneID::Sliding:
+                    case SceneID::Minesweeper:
+                    case SceneID::Game2048:
+                    case SceneID::Sandsim:
+                    case SceneID::Cellular:
+                    {
+                        if (active_scene)
                         {
-                            if (active_scene)
-                            {
-                                ctx_running = active_scene->frame(ctx, win);
-                                if (!ctx_running)
-                                {
-                                    active_scene->unload();
-                                    active_scene.reset();
-                                    scene_id = SceneID::Menu;
-                                    init_menu();
-                                }
-                            }
-                            break;
-                        }
-
-                        case SceneID::Exit:
-                            running = false;
-                            break;
+                            result.alive = !scene_finished && active_scene->render(ctx, win, sim_clock.alpha);
+                            result.scene_ended = !result.alive;
                         }
+                        break;
+                    }
 
-                        if (!ctx_running)
-                            last_frame_times.erase(raw);
+                    case SceneID::Exit:
+                        break;
+                    }
 
-                        return ctx_running;
-                    };
+                    if (!result.alive)
+                        slot->last_frame.reset();
+                },
+                // Game frames share one scene instance and render in window
+                // order; only menu frames run in parallel.
+                frame_scene == SceneID::Menu);
 
-#if defined(ALMOND_SINGLE_PARENT)
-                if (!contexts.empty())
+            // Apply shared transitions in window order, as the serial loop did.
+            bool scene_changed = false;
+            for (auto& [ctx, win, slot, result] : work)
+            {
+                // The first choice or scene exit wins; later windows saw the old scene.
+                if (result.choice && !scene_changed)
                 {
-                    auto master = contexts.front();
-                    if (master && !update_on_ctx(master)) { running = false; break; }
-
-                    for (std::size_t i = 1; i < contexts.size(); ++i)
-                        if (!update_on_ctx(contexts[i])) running = false;
+                    apply_choice(*result.choice);
+                    scene_changed = true;
                 }
-#else
-                bool any_alive = false;
-                for (std::size_t i = 0; i < contexts.size(); ++i)
-                {
-                    auto& ctx = contexts[i];
-                    if (!ctx) continue;
 
-                    const bool alive = update_on_ctx(ctx);
-                    if (alive) any_alive = true;
+                if (result.scene_ended && !scene_changed && active_scene)
+                {
+                    active_scene->unload();
+                    active_scene.reset();
+                    scene_id = SceneID::Menu;
+                    for (auto& entry : work)
+                        init_menu(*entry.slot, entry.ctx);
+                    scene_changed = true;
                 }
-                if (any_alive) any_context_alive = true;
+
+#if defined(ALMOND_SINGLE_PARENT)
+                if (!result.alive) running = false;
+#else
+                if (result.alive) any_context_alive = true;
 #endif
-                if (!running) break;
             }
+
+            if (frame_scene == SceneID::Exit)
+                running = false;
+
 #if !defined(ALMOND_SINGLE_PARENT)
             if (!any_context_alive) running = false;
+#else
+            (void)any_context_alive;
 #endif
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            // Input (or an engine wakeup) starts the next frame early.
+            pacer.wait(false, almondnamespace::platform::wait_events);
+            telemetry::emit_frame_pacing("main", pacer.stats(), {});
         }
 
         if (active_scene)
@@ -747,11 +879,12 @@ namespace almondnamespace::core::engine
             active_scene.reset();
         }
 
-        menu.cleanup();
+        for (auto& [__, slot] : window_slots)
+            slot.menu.cleanup();
 
         // Backend cleanup
-        auto snapshot2 = collect_backend_contexts();
-        for (auto& [type, contexts] : snapshot2)
+        auto snapshot2 = almondnamespace::core::context_snapshot();
+        for (auto& [type, contexts] : snapshot2->groups)
         {
             auto cleanup_backend = [&](std::shared_ptr<almondnamespace::core::Context> ctx)
                 {
@@ -801,6 +934,192 @@ namespace almondnamespace::core::engine
         return 0;
     }
 
+    namespace
+    {
+        using SceneFactory = std::unique_ptr<almondnamespace::scene::Scene>(*)();
+
+        SceneFactory find_stress_scene(std::string_view name)
+        {
+            static constexpr std::pair<std::string_view, SceneFactory> kScenes[] = {
+                { "snake", CreateSnakeScene },
+                { "tetris", CreateTetrisScene },
+                { "pacman", CreatePacmanScene },
+                { "frogger", CreateFroggerScene },
+                { "sokoban", CreateSokobanScene },
+                { "match3", CreateMatch3Scene },
+                { "puzzle", CreateSlidingPuzzleScene },
+                { "minesweeper", CreateMinesweeperScene },
+                { "2048", Create2048Scene },
+                { "sandsim", CreateSandSimScene },
+                { "cellular", CreateCellularSimScene },
+            };
+
+            for (const auto& [key, factory] : kScenes)
+                if (key == name) return factory;
+            return nullptr;
+        }
+
+        double percentile_us(std::vector<double>& samples, double p)
+        {
+            if (samples.empty()) return 0.0;
+            const auto index = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+            std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+            return samples[index];
+        }
+    }
+
+    // --headless-stress: runs one scene on N noop windows with pacing off,
+    // the way the Game state of the engine loops does (one update per tick,
+    // one render per window), then reports where the frame time went.
+    // Nothing is drawn, so what remains is engine overhead.
+    int RunHeadlessStress(int windowCount)
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto to_us = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+
+        const SceneFactory make_scene = find_stress_scene(cli::stress_scene);
+        if (!make_scene)
+        {
+            std::cerr << "[Stress] Unknown scene '" << cli::stress_scene << "'\n";
+            return -1;
+        }
+
+        // Render threads read the pacing config when they start.
+        cli::target_fps = 0.0;
+
+        try
+        {
+            MultiContextManager mgr;
+            if (!mgr.InitializeHeadless(windowCount))
+            {
+                std::cerr << "[Stress] Failed to create noop windows\n";
+                return -1;
+            }
+
+            struct StressWindow
+            {
+                std::shared_ptr<Context> ctx{};
+                WindowData* win = nullptr;
+                bool ended = false;
+            };
+
+            std::vector<StressWindow> work;
+            for (const auto& win : mgr.GetWindows())
+                if (win && win->context) work.push_back(StressWindow{ win->context, win.get() });
+
+            auto queue_totals = [&]()
+                {
+                    CommandQueueTotals sum{};
+                    for (const auto& entry : work)
+                    {
+                        const auto t = entry.win->commandQueue.totals();
+                        sum.drains += t.drains;
+                        sum.commands += t.commands;
+                        sum.drainNs += t.drainNs;
+                    }
+                    return sum;
+                };
+
+            auto scene = make_scene();
+            scene->load();
+            auto sim_clock = almondnamespace::timing::createFixedStep(60.0);
+
+
+            std::vector<double> frame_us;
+            double update_us = 0.0;
+            double render_us = 0.0;
+            std::size_t peak_depth = 0;
+            std::uint64_t restarts = 0;
+
+            const auto queue_start = queue_totals();
+#if defined(ALMOND_USING_NOOP_HEADLESS)
+            const auto upload_start = almondnamespace::noopcontext::upload_totals();
+#endif
+            const auto start = Clock::now();
+            const auto stop = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(cli::stress_seconds));
+
+            while (mgr.IsRunning() && Clock::now() < stop)
+            {
+                const auto frame_start = Clock::now();
+
+                bool scene_finished = false;
+                const int steps = almondnamespace::timing::tickFixed(sim_clock);
+                for (int i = 0; i < steps && !scene_finished; ++i)
+                    scene_finished = !scene->update(sim_clock.step);
+                const auto update_end = Clock::now();
+
+                // One scene instance is shared by every window, as in the
+                // engine loops, so windows render in order; they only enqueue
+                // and the render threads drain in parallel.
+                for (auto& entry : work)
+                    entry.ended = !scene->render(entry.ctx, entry.win, sim_clock.alpha);
+                const auto frame_end = Clock::now();
+
+                std::size_t depth = 0;
+                for (auto& entry : work)
+                {
+                    depth += entry.win->commandQueue.depth();
+                    scene_finished = scene_finished || entry.ended;
+                    entry.ended = false;
+                }
+                peak_depth = (std::max)(peak_depth, depth);
+
+                update_us += to_us(update_end - frame_start);
+                render_us += to_us(frame_end - update_end);
+                frame_us.push_back(to_us(frame_end - frame_start));
+
+                // Scenes end on game over; restart so the run keeps its load.
+                if (scene_finished)
+                {
+                    scene->unload();
+                    scene = make_scene();
+                    scene->load();
+                    almondnamespace::timing::resetFixed(sim_clock);
+                    ++restarts;
+                }
+            }
+
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            scene->unload();
+            scene.reset();
+            mgr.StopAll();
+
+            const auto queue_end = queue_totals();
+            const double frames = static_cast<double>((std::max)<std::size_t>(frame_us.size(), 1));
+            const std::uint64_t drains = queue_end.drains - queue_start.drains;
+            const std::uint64_t commands = queue_end.commands - queue_start.commands;
+            const double drain_us = static_cast<double>(queue_end.drainNs - queue_start.drainNs) / 1000.0;
+
+            double mean_frame = 0.0;
+            for (double us : frame_us) mean_frame += us;
+            mean_frame /= frames;
+            const double p50 = percentile_us(frame_us, 0.50);
+            const double p99 = percentile_us(frame_us, 0.99);
+
+            std::cout << std::format("[Stress] {} noop windows, scene '{}': {} frames in {:.2f} s ({:.0f} fps), {} scene restarts\n",
+                work.size(), cli::stress_scene, frame_us.size(), seconds, frame_us.size() / seconds, restarts);
+            std::cout << std::format("[Stress] engine loop: {:.1f} us mean, {:.1f} us p50, {:.1f} us p99 per frame "
+                "(scene update {:.1f} us, window renders {:.1f} us)\n",
+                mean_frame, p50, p99, update_us / frames, render_us / frames);
+            std::cout << std::format("[Stress] command queue: {:.1f} commands per frame, {} drains at {:.2f} us each, peak depth {}\n",
+                static_cast<double>(commands) / frames, drains,
+                drains ? drain_us / static_cast<double>(drains) : 0.0, peak_depth);
+#if defined(ALMOND_USING_NOOP_HEADLESS)
+            const auto upload_end = almondnamespace::noopcontext::upload_totals();
+            const std::uint64_t passes = upload_end.passes - upload_start.passes;
+            std::cout << std::format("[Stress] atlas uploads: {} bookkeeping passes at {:.2f} us each\n",
+                passes, passes ? static_cast<double>(upload_end.ns - upload_start.ns) / 1000.0 / static_cast<double>(passes) : 0.0);
+#endif
+            return 0;
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "[Stress] " << ex.what() << '\n';
+            return -1;
+        }
+    }
+
     static int RunEngineMainLoopCommon(MultiContextManager& mgr, PumpFunction pump_events)
     {
         if (almondnamespace::core::cli::run_menu_loop)
@@ -821,16 +1140,19 @@ namespace almondnamespace::core::engine
             HINSTANCE hi = hInstance ? hInstance : GetModuleHandleW(nullptr);
 
             const BackendWindowCounts counts = ResolveBackendWindowCounts();
-            const bool ok = mgr.Initialize(
-                hi,
-                /*RayLib*/   counts.raylib,
-                /*SDL*/      counts.sdl,
-                /*SFML*/     counts.sfml,
-                /*Vulkan*/   counts.vulkan,
-                /*OpenGL*/   counts.opengl,
-                /*Software*/ counts.software,
-                ALMOND_SINGLE_PARENT == 1
-            );
+            // --headless never presents, so the software window needs no display.
+            const bool ok = (cli::software_headless && counts.software > 0)
+                ? mgr.InitializeHeadless(counts.software, ContextType::Software)
+                : mgr.Initialize(
+                    hi,
+                    /*RayLib*/   counts.raylib,
+                    /*SDL*/      counts.sdl,
+                    /*SFML*/     counts.sfml,
+                    /*Vulkan*/   counts.vulkan,
+                    /*OpenGL*/   counts.opengl,
+                    /*Software*/ counts.software,
+                    ALMOND_SINGLE_PARENT == 1
+                );
 
             if (!ok)
             {
@@ -883,16 +1205,19 @@ namespace almondnamespace::core::engine
             almondnamespace::core::MultiContextManager mgr;
 
             const BackendWindowCounts counts = ResolveBackendWindowCounts();
-            const bool ok = mgr.Initialize(
-                nullptr,
-                /*RayLib*/   counts.raylib,
-                /*SDL*/      counts.sdl,
-                /*SFML*/     counts.sfml,
-                /*Vulkan*/   counts.vulkan,
-                /*OpenGL*/   counts.opengl,
-                /*Software*/ counts.software,
-                ALMOND_SINGLE_PARENT == 1
-            );
+            // --headless never presents, so the software window needs no display.
+            const bool ok = (cli::software_headless && counts.software > 0)
+                ? mgr.InitializeHeadless(counts.software, ContextType::Software)
+                : mgr.Initialize(
+                    nullptr,
+                    /*RayLib*/   counts.raylib,
+                    /*SDL*/      counts.sdl,
+                    /*SFML*/     counts.sfml,
+                    /*Vulkan*/   counts.vulkan,
+                    /*OpenGL*/   counts.opengl,
+                    /*Software*/ counts.software,
+                    ALMOND_SINGLE_PARENT == 1
+                );
 
             if (!ok)
             {
@@ -0,0 +1,405 @@
+// src/asoftrenderer.bench.cpp
+//
+// Throughput benchmark for the software renderer. Everything runs headless
+// against SoftFrameResources, so it works on CI machines without a display:
+//
+//   raster/*   triangle soup and the textured cube through the tile rasterizer
+//   blit/*     sprite blits at several sizes, scales and filters (ns/sprite)
+//   atlas/*    RGBA8 -> ARGB mirror conversion, full and dirty-region refresh
+//   scene/*    grid-game frames (clear + background + one sprite per cell) at
+//              several resolutions, following the draw pattern of the games
+//
+//   almondshell_software_bench [--filter text] [--min-time ms] [--csv file]
+//
+// Every case prints Mpix/s (destination pixels written) and ns per operation;
+// --csv appends "name,metric,value" rows for tracking results per commit.
+
+import <algorithm>;
+import <chrono>;
+import <cmath>;
+import <cstdint>;
+import <cstdlib>;
+import <fstream>;
+import <functional>;
+import <iomanip>;
+import <iostream>;
+import <random>;
+import <span>;
+import <string>;
+import <string_view>;
+import <vector>;
+
+import aatlas.texture;                   // TextureAtlas
+import atexture;                         // almondnamespace::Texture (atlas input)
+import apixel.convert;                   // pixel::rgba8_to_argb32
+import acontext.softrenderer.state;      // SoftFrameResources
+import acontext.softrenderer.textures;   // anativecontext::Texture, AtlasTextureCache
+import acontext.softrenderer.renderer;   // SoftwareRenderer
+import acontext.softrenderer.blit;       // blit::blit_scaled
+import acontext.softrenderer.sampler;    // sampler::Filter
+
+namespace
+{
+    using namespace almondnamespace;
+    using namespace almondnamespace::anativecontext;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string filter{};
+        double minSeconds = 0.25;
+        std::string csvPath{};
+    };
+
+    struct Result
+    {
+        std::string name;
+        double nsPerOp = 0.0;
+        double mpixPerSecond = 0.0;
+        const char* opName = "op";
+    };
+
+    // Runs `op` until minSeconds have elapsed (after one warm-up call).
+    // `pixelsPerOp` is the number of destination pixels one call writes.
+    Result measure(const Options& options, std::string name, const char* opName,
+        double pixelsPerOp, const std::function<void()>& op)
+    {
+        op();
+
+        std::uint64_t ops = 0;
+        const auto start = Clock::now();
+        double elapsed = 0.0;
+        do
+        {
+            op();
+            ++ops;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < options.minSeconds);
+
+        Result r{ std::move(name) };
+        r.nsPerOp = elapsed * 1.0e9 / double(ops);
+        r.mpixPerSecond = pixelsPerOp * double(ops) / elapsed / 1.0e6;
+        r.opName = opName;
+        return r;
+    }
+
+    void print(const Result& r)
+    {
+        std::cout << "  " << std::left << std::setw(44) << r.name << std::right
+            << std::fixed << std::setprecision(1)
+            << std::setw(10) << r.mpixPerSecond << " Mpix/s "
+            << std::setw(12) << r.nsPerOp << " ns/" << r.opName << "\n";
+    }
+
+    // ─── Fixtures ───────────────────────────────────────────────
+
+    std::vector<std::uint8_t> random_rgba(std::mt19937& rng, std::size_t pixels, bool translucent)
+    {
+        std::vector<std::uint8_t> bytes(pixels * 4);
+        for (std::size_t i = 0; i < pixels; ++i)
+        {
+            const std::uint32_t v = rng();
+            bytes[i * 4 + 0] = std::uint8_t(v);
+            bytes[i * 4 + 1] = std::uint8_t(v >> 8);
+            bytes[i * 4 + 2] = std::uint8_t(v >> 16);
+            bytes[i * 4 + 3] = translucent ? std::uint8_t(v >> 24) : std::uint8_t(0xFF);
+        }
+        return bytes;
+    }
+
+    // One atlas holding a background and a handful of opaque/translucent tiles.
+    struct SpriteAtlas
+    {
+        TextureAtlas atlas{};
+        std::vector<AtlasRegion> tiles{};
+        AtlasRegion background{};
+    };
+
+    void build_atlas(SpriteAtlas& out, std::mt19937& rng)
+    {
+        out.atlas.init({ .name = "bench_atlas", .width = 1024, .height = 1024 });
+        out.tiles.clear();
+
+        auto add = [&](const std::string& id, std::uint32_t size, bool translucent) -> AtlasRegion
+            {
+                almondnamespace::Texture tex{};
+                tex.name = id;
+                tex.width = size;
+                tex.height = size;
+                tex.pixels = random_rgba(rng, std::size_t(size) * size, translucent);
+                const auto entry = out.atlas.add_entry(id, tex);
+                return entry ? entry->region : AtlasRegion{};
+            };
+
+        out.background = add("bg", 256, false);
+        for (int i = 0; i < 12; ++i)
+            out.tiles.push_back(add("tile" + std::to_string(i), 64, (i % 3) == 0));
+    }
+
+    blit::BlitSource region_source(const anativecontext::Texture& mirror, const AtlasRegion& r)
+    {
+        return { mirror.pixels.data(), mirror.width,
+            int(r.x), int(r.y), int(r.width), int(r.height), blit::SourceFormat::ARGB32 };
+    }
+
+    std::vector<Triangle> triangle_soup(std::mt19937& rng, int count, float maxSize)
+    {
+        std::uniform_real_distribution<float> cx(-1.6f, 1.6f), cy(-1.2f, 1.2f), z(0.5f, 6.0f);
+        std::uniform_real_distribution<float> d(-maxSize, maxSize);
+
+        std::vector<Triangle> tris(static_cast<std::size_t>(count));
+        for (auto& t : tris)
+        {
+            const float x = cx(rng), y = cy(rng), depth = z(rng);
+            // Counter-clockwise in view space (|skew| < size) so back-face culling keeps them.
+            const float size = std::abs(d(rng)) + 0.05f;
+            const float skew = d(rng) / maxSize * 0.3f * size;
+            t.v0.pos = { x, y, depth };
+            t.v1.pos = { x + size, y + skew, depth };
+            t.v2.pos = { x + skew, y + size, depth };
+            t.color = rng() | 0xFF000000u;
+        }
+        return tris;
+    }
+
+    struct GridScene
+    {
+        const char* name;
+        int cols;
+        int rows;
+    };
+
+    // Grid sizes of the bundled games.
+    constexpr GridScene kScenes[] = {
+        { "a2048like",      4,  4 },
+        { "slidingpuzzle",  4,  4 },
+        { "match3like",     8,  8 },
+        { "minesweeper",   16, 16 },
+        { "tetrislike",    40, 20 },
+    };
+
+    struct Resolution
+    {
+        int width;
+        int height;
+    };
+
+    constexpr Resolution kResolutions[] = { { 640, 480 }, { 1280, 720 }, { 1920, 1080 } };
+
+    std::string resolution_name(const Resolution& r)
+    {
+        return std::to_string(r.width) + "x" + std::to_string(r.height);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc)
+            options.filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc)
+            options.minSeconds = std::atof(argv[++i]) / 1000.0;
+        else if (arg == "--csv" && i + 1 < argc)
+            options.csvPath = argv[++i];
+        else
+        {
+            std::cerr << "usage: almondshell_software_bench [--filter text] [--min-time ms] [--csv file]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Result> results{};
+    auto run = [&](std::string name, const char* opName, double pixelsPerOp, const std::function<void()>& op)
+        {
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+                return;
+            results.push_back(measure(options, std::move(name), opName, pixelsPerOp, op));
+            print(results.back());
+        };
+
+    std::mt19937 rng{ 1234u };
+    std::cout << "[SoftBench] min " << options.minSeconds * 1000.0 << " ms per case, SIMD "
+        << pixel::to_string(pixel::detect_simd_level()) << "\n";
+
+    SoftFrameResources frame{};
+
+    // ─── Rasterizer ─────────────────────────────────────────────
+    for (const Resolution& res : kResolutions)
+    {
+        frame.resize(res.width, res.height);
+        frame.ensure_depth();
+        const double framePixels = double(frame.pixel_count());
+
+        const auto small = triangle_soup(rng, 4000, 0.08f);
+        const auto large = triangle_soup(rng, 200, 0.6f);
+
+        run("raster/soup_small_4000/" + resolution_name(res), "frame", framePixels, [&]
+            {
+                frame.invalidate_depth();
+                SoftwareRenderer::rasterize_triangles(frame, small);
+            });
+
+        run("raster/soup_large_200/" + resolution_name(res), "frame", framePixels, [&]
+            {
+                frame.invalidate_depth();
+                SoftwareRenderer::rasterize_triangles(frame, large);
+            });
+
+        // Per-call overhead of the single-triangle entry point.
+        run("raster/rasterize_triangle_x200/" + resolution_name(res), "frame", framePixels, [&]
+            {
+                frame.invalidate_depth();
+                for (const Triangle& tri : large)
+                    SoftwareRenderer::rasterize_triangle(frame, tri);
+            });
+
+        auto checker = create_texture(64, 64);
+        for (int y = 0; y < 64; ++y)
+            for (int x = 0; x < 64; ++x)
+                checker->pixels[std::size_t(y) * 64 + std::size_t(x)] = ((x / 8 + y / 8) % 2) ? 0xFFFF0000u : 0xFF00FF00u;
+
+        float angle = 0.0f;
+        run("raster/textured_cube/" + resolution_name(res), "frame", framePixels, [&]
+            {
+                frame.clear_color(0xFF000000u);
+                frame.invalidate_depth();
+                SoftwareRenderer::render_cube(frame, checker, angle += 0.01f);
+            });
+    }
+
+    // ─── Sprite blits ───────────────────────────────────────────
+    SpriteAtlas sprites{};
+    build_atlas(sprites, rng);
+    AtlasTextureCache mirrors{};
+    const anativecontext::Texture* mirror = mirrors.acquire(sprites.atlas);
+    if (!mirror)
+    {
+        std::cerr << "[SoftBench] failed to build the sprite atlas\n";
+        return EXIT_FAILURE;
+    }
+
+    frame.resize(1280, 720);
+    const blit::BlitTarget target{ frame.color.data(), frame.width, frame.height };
+    const AtlasRegion& opaqueTile = sprites.tiles[1];
+    const AtlasRegion& alphaTile = sprites.tiles[0];
+
+    for (const int size : { 16, 64, 256 })
+    {
+        for (const auto filter : { sampler::Filter::Nearest, sampler::Filter::Bilinear })
+        {
+            const char* filterName = filter == sampler::Filter::Bilinear ? "bilinear" : "nearest";
+            const double pixels = double(size) * double(size);
+
+            for (const auto* tile : { &opaqueTile, &alphaTile })
+            {
+                const bool alpha = tile == &alphaTile;
+                const auto source = region_source(*mirror, *tile);
+                int x = 0;
+                run("blit/" + std::to_string(size) + "px_" + filterName + (alpha ? "_alpha" : "_opaque"),
+                    "sprite", pixels, [&]
+                    {
+                        x = (x + 37) % (frame.width - size);
+                        blit::blit_scaled(target, source, x, (x * 7) % (frame.height - size), size, size,
+                            blit::BlendMode::AlphaOver, filter);
+                    });
+            }
+        }
+    }
+
+    // ─── Atlas mirror refresh ───────────────────────────────────
+    {
+        const double atlasPixels = double(sprites.atlas.width) * double(sprites.atlas.height);
+        std::vector<std::uint32_t> argb(static_cast<std::size_t>(atlasPixels));
+
+        run("atlas/rgba8_to_argb32_1024", "atlas", atlasPixels, [&]
+            {
+                pixel::rgba8_to_argb32(sprites.atlas.pixel_data.data(), argb.data(), argb.size());
+            });
+
+        run("atlas/mirror_full_refresh_1024", "refresh", atlasPixels, [&]
+            {
+                sprites.atlas.rebuild_pixels(); // whole page dirty
+                (void)mirrors.acquire(sprites.atlas);
+            });
+
+        // Dirty-region path: one 64x64 region rewritten in place per refresh,
+        // as an animated tile would.
+        const auto patch = random_rgba(rng, 64u * 64u, true);
+        const AtlasRegion& region = sprites.tiles[2];
+        run("atlas/mirror_partial_refresh_64px", "refresh", 64.0 * 64.0, [&]
+            {
+                sprites.atlas.blit_region(region, patch.data());
+                sprites.atlas.mark_region_dirty(region);
+                (void)mirrors.acquire(sprites.atlas);
+            });
+    }
+
+    // ─── Grid-game frames ───────────────────────────────────────
+    build_atlas(sprites, rng);
+    mirror = mirrors.acquire(sprites.atlas);
+
+    for (const GridScene& scene : kScenes)
+    {
+        for (const Resolution& res : kResolutions)
+        {
+            frame.resize(res.width, res.height);
+            const blit::BlitTarget sceneTarget{ frame.color.data(), frame.width, frame.height };
+            const auto background = region_source(*mirror, sprites.background);
+
+            const int cell = (std::min)(res.width / scene.cols, res.height / scene.rows);
+            const int offsetX = (res.width - cell * scene.cols) / 2;
+            const int offsetY = (res.height - cell * scene.rows) / 2;
+            const double sprites_per_frame = 1.0 + double(scene.cols) * double(scene.rows);
+
+            run("scene/" + std::string(scene.name) + "/" + resolution_name(res), "frame",
+                double(frame.pixel_count()) + double(cell) * cell * scene.cols * scene.rows, [&]
+                {
+                    frame.clear_color(0xFF202020u);
+                    blit::blit_scaled(sceneTarget, background, 0, 0, res.width, res.height,
+                        blit::BlendMode::AlphaOver, sampler::Filter::Bilinear);
+
+                    for (int r = 0; r < scene.rows; ++r)
+                    {
+                        for (int c = 0; c < scene.cols; ++c)
+                        {
+                            const AtlasRegion& tile = sprites.tiles[std::size_t(r * scene.cols + c) % sprites.tiles.size()];
+                            blit::blit_scaled(sceneTarget, region_source(*mirror, tile),
+                                offsetX + c * cell, offsetY + r * cell, cell, cell,
+                                blit::BlendMode::AlphaOver, sampler::Filter::Bilinear);
+                        }
+                    }
+                });
+
+            if (results.empty())
+                continue;
+
+            const Result& last = results.back();
+            if (last.name == "scene/" + std::string(scene.name) + "/" + resolution_name(res))
+            {
+                std::cout << "    " << std::fixed << std::setprecision(1)
+                    << last.nsPerOp / sprites_per_frame << " ns/sprite, "
+                    << 1.0e9 / last.nsPerOp << " fps\n";
+            }
+        }
+    }
+
+    if (!options.csvPath.empty())
+    {
+        std::ofstream csv(options.csvPath, std::ios::app);
+        if (!csv)
+        {
+            std::cerr << "[SoftBench] cannot write " << options.csvPath << "\n";
+            return EXIT_FAILURE;
+        }
+        for (const Result& r : results)
+        {
+            csv << r.name << ",mpix_per_s," << r.mpixPerSecond << "\n";
+            csv << r.name << ",ns_per_" << r.opName << "," << r.nsPerOp << "\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
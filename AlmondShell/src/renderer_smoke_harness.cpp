@@ -1,550 +1,774 @@
-﻿///**************************************************************
-// *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
-// *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
-// *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
-// *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
-// *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
-// *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
-// *                                                            *
-// *   This file is part of the Almond Project.                 *
-// *   AlmondShell - Modular C++ Framework                      *
-// *                                                            *
-// *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
-// *                                                            *
-// *   Provided "AS IS", without warranty of any kind.          *
-// *   Use permitted for Non-Commercial Purposes ONLY,          *
-// *   without prior commercial licensing agreement.            *
-// *                                                            *
-// *   Redistribution Allowed with This Notice and              *
-// *   LICENSE file. No obligation to disclose modifications.   *
-// *                                                            *
-// *   See LICENSE file for full terms.                         *
-// *                                                            *
-// **************************************************************/
-//module;
-//
-//#include <include/aengine.config.hpp> // for ALMOND_USING Macros 
-//
-//#include <chrono>
-//#include <filesystem>
-//#include <fstream>
-//#include <iomanip>
-//#include <iostream>
-//#include <optional>
-//#include <sstream>
-//#include <string>
-//#include <string_view>
-//#include <thread>
-//#include <vector>
-//
-//#if defined(_WIN32)
-//#    ifdef ALMOND_USING_WINMAIN
-//#        include "../include/aframework.hpp"
-//#    endif
-//#    ifndef WIN32_LEAN_AND_MEAN
-//#        define WIN32_LEAN_AND_MEAN
-//#    endif
-//#endif
-//
-//export module aengine.renderer.smoke.harness;
-//
-//namespace
-//{
-//    using Clock = std::chrono::steady_clock;
-//
-//    struct BackendScene
-//    {
-//        std::string name;
-//        std::string renderer_arg;
-//        std::string scene_arg;
-//        std::string expected_output;
-//        bool requires_dock_actions = false;
-//        bool include_by_default = true;
-//    };
-//
-//    struct ScheduledAction
-//    {
-//        enum class Type
-//        {
-//            Resize,
-//            DockDetach,
-//            DockAttach,
-//            CaptureHint
-//        };
-//
-//        Type type{};
-//        int at_seconds = 0;
-//        int width = 0;
-//        int height = 0;
-//        std::string note;
-//    };
-//
-//    struct HarnessOptions
-//    {
-//        std::filesystem::path binary_path = "./Bin/GCC-Debug/cmakeapp1/cmakeapp1";
-//        std::optional<std::string> backend_filter;
-//        bool capture = false;
-//        int duration_seconds = 60;
-//    };
-//
-//    std::string format_timestamp()
-//    {
-//        const auto now = std::chrono::system_clock::now();
-//        const auto in_time_t = std::chrono::system_clock::to_time_t(now);
-//        std::tm tm_time{};
-//#if defined(_WIN32)
-//        localtime_s(&tm_time, &in_time_t);
-//#else
-//        localtime_r(&in_time_t, &tm_time);
-//#endif
-//        std::ostringstream oss;
-//        oss << std::put_time(&tm_time, "%Y%m%d-%H%M%S");
-//        return oss.str();
-//    }
-//
-//    std::vector<BackendScene> backend_definitions()
-//    {
-//        return {
-//            {
-//                "opengl",
-//                "opengl",
-//                "dockstress",
-//                "Stable 4-pane layout, consistent GL viewport sizes, animated quad sampler with no shader recompilation errors.",
-//                true,
-//                true,
-//            },
-//            {
-//                "sdl",
-//                "sdl",
-//                "menu_rainbow",
-//                "Background hue cycling without hitching, resize events leave canvas centred, command queue drains to empty each frame.",
-//                false,
-//                true,
-//            },
-//            {
-//                "raylib",
-//                "raylib",
-//                "fit_canvas",
-//                "Render canvas letterboxed with GuiFitViewport scale, framebuffer + logical sizes reported, pointer focus stays aligned after resize/dock, context logs never report a lost binding.",
-//                true,
-//                true,
-//            },
-//            {
-//                "raylib_nogl",
-//                "raylib",
-//                "fit_canvas",
-//                "GUI letterboxes correctly, logs contain no \"Render context became unavailable\" warnings, viewport and input scaling remain stable.",
-//                true,
-//                false,
-//            },
-//            {
-//                "software",
-//                "software",
-//                "cpu_quad",
-//                "CPU renderer updates checkerboard quad without tearing, resize callback fires once per logical size, framebuffer buffer length matches width×height.",
-//                false,
-//                true,
-//            },
-//        };
-//    }
-//
-//    std::vector<ScheduledAction> build_schedule(bool needs_dock_actions, bool capture_enabled)
-//    {
-//        std::vector<ScheduledAction> actions;
-//        actions.push_back({ ScheduledAction::Type::Resize, 0, 640, 360, "Resize to <50% of baseline" });
-//        actions.push_back({ ScheduledAction::Type::Resize, 20, 1920, 1080, "Resize to >150% of baseline" });
-//        actions.push_back({ ScheduledAction::Type::Resize, 40, 1280, 720, "Return to baseline" });
-//
-//        if (needs_dock_actions)
-//        {
-//            actions.push_back({ ScheduledAction::Type::DockDetach, 1, 0, 0, "Detach docked window" });
-//            actions.push_back({ ScheduledAction::Type::DockAttach, 3, 0, 0, "Reattach docked window" });
-//        }
-//
-//        if (capture_enabled)
-//        {
-//            actions.push_back({ ScheduledAction::Type::CaptureHint, 1, 0, 0, "Capture after first resize" });
-//            actions.push_back({ ScheduledAction::Type::CaptureHint, 21, 0, 0, "Capture after second resize" });
-//            actions.push_back({ ScheduledAction::Type::CaptureHint, 41, 0, 0, "Capture after third resize" });
-//        }
-//
-//        return actions;
-//    }
-//
-//    HarnessOptions parse_args(int argc, char** argv)
-//    {
-//        HarnessOptions options{};
-//        for (int i = 1; i < argc; ++i)
-//        {
-//            std::string_view arg{ argv[i] };
-//            if (arg == "--binary" && i + 1 < argc)
-//            {
-//                options.binary_path = argv[++i];
-//            }
-//            else if (arg == "--backend" && i + 1 < argc)
-//            {
-//                options.backend_filter = std::string(argv[++i]);
-//            }
-//            else if (arg == "--capture")
-//            {
-//                options.capture = true;
-//            }
-//            else if (arg == "--duration" && i + 1 < argc)
-//            {
-//                options.duration_seconds = std::stoi(argv[++i]);
-//            }
-//            else if (arg == "--help" || arg == "-h")
-//            {
-//                std::cout
-//                    << "Renderer smoke harness\n"
-//                    << "  --binary <path>    Path to AlmondShell binary (default ./Bin/GCC-Debug/cmakeapp1/cmakeapp1)\n"
-//                    << "  --backend <name>   Run a single backend (opengl|sdl|raylib|raylib_nogl|software)\n"
-//                    << "  --capture          Enable capture scheduling + asset manifests\n"
-//                    << "  --duration <sec>   Override scene duration (default 60)\n";
-//            }
-//        }
-//        return options;
-//    }
-//
-//    std::filesystem::path ensure_backend_log_dir(const std::string& backend)
-//    {
-//        std::filesystem::path root = "Logs";
-//        root /= backend;
-//        std::filesystem::create_directories(root);
-//        return root;
-//    }
-//
-//    std::filesystem::path build_log_path(const std::filesystem::path& dir, const std::string& stamp)
-//    {
-//        return dir / ("run-" + stamp + ".log");
-//    }
-//
-//    std::filesystem::path build_manifest_path(const std::filesystem::path& dir, const std::string& stamp)
-//    {
-//        return dir / ("run-" + stamp + "-manifest.json");
-//    }
-//
-//    std::filesystem::path build_capture_notes_path(const std::filesystem::path& dir, const std::string& stamp)
-//    {
-//        return dir / ("capture-" + stamp + "-notes.txt");
-//    }
-//
-//#if defined(_WIN32)
-//    std::wstring widen(const std::string& value)
-//    {
-//        if (value.empty()) return L"";
-//        int len = MultiByteToWideChar(CP_UTF8, 0, value.c_str(), -1, nullptr, 0);
-//        std::wstring wide(static_cast<size_t>(len), L'\0');
-//        MultiByteToWideChar(CP_UTF8, 0, value.c_str(), -1, wide.data(), len);
-//        if (!wide.empty() && wide.back() == L'\0')
-//        {
-//            wide.pop_back();
-//        }
-//        return wide;
-//    }
-//
-//    std::wstring widen_path(const std::filesystem::path& path)
-//    {
-//        return path.wstring();
-//    }
-//
-//    std::wstring build_window_title(const std::string& backend)
-//    {
-//        std::wstring label = widen(backend);
-//        if (backend == "opengl") label = L"OpenGL";
-//        if (backend == "raylib") label = L"Raylib";
-//        if (backend == "raylib_nogl") label = L"Raylib";
-//        if (backend == "software") label = L"Software";
-//        if (backend == "sdl") label = L"SDL";
-//        return label + L" Dock 1";
-//    }
-//
-//    HWND wait_for_window(const std::wstring& title, std::chrono::seconds timeout)
-//    {
-//        const auto deadline = Clock::now() + timeout;
-//        while (Clock::now() < deadline)
-//        {
-//            if (HWND hwnd = FindWindowW(nullptr, title.c_str()))
-//            {
-//                return hwnd;
-//            }
-//            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-//        }
-//        return nullptr;
-//    }
-//
-//    void resize_window(HWND hwnd, int width, int height)
-//    {
-//        if (!hwnd) return;
-//        RECT rect{ 0, 0, width, height };
-//        DWORD style = static_cast<DWORD>(GetWindowLongPtrW(hwnd, GWL_STYLE));
-//        DWORD ex_style = static_cast<DWORD>(GetWindowLongPtrW(hwnd, GWL_EXSTYLE));
-//        AdjustWindowRectEx(&rect, style, FALSE, ex_style);
-//        int win_w = rect.right - rect.left;
-//        int win_h = rect.bottom - rect.top;
-//        SetWindowPos(hwnd, nullptr, 0, 0, win_w, win_h, SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
-//    }
-//
-//    void set_child_style(HWND hwnd, bool child)
-//    {
-//        if (!hwnd) return;
-//        LONG_PTR style = GetWindowLongPtrW(hwnd, GWL_STYLE);
-//        if (child)
-//        {
-//            style &= ~(WS_OVERLAPPEDWINDOW);
-//            style |= (WS_CHILD | WS_VISIBLE);
-//        }
-//        else
-//        {
-//            style &= ~(WS_CHILD);
-//            style |= (WS_OVERLAPPEDWINDOW | WS_VISIBLE);
-//        }
-//        SetWindowLongPtrW(hwnd, GWL_STYLE, style);
-//        SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
-//            SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED | SWP_NOACTIVATE);
-//    }
-//
-//    bool launch_process(const std::filesystem::path& binary,
-//        const std::string& args,
-//        const std::filesystem::path& log_path,
-//        PROCESS_INFORMATION& process_info)
-//    {
-//        std::wstring command_line = L"\"" + widen_path(binary) + L"\" " + widen(args);
-//
-//        HANDLE log_file = CreateFileW(
-//            widen_path(log_path).c_str(),
-//            GENERIC_WRITE,
-//            FILE_SHARE_READ | FILE_SHARE_WRITE,
-//            nullptr,
-//            CREATE_ALWAYS,
-//            FILE_ATTRIBUTE_NORMAL,
-//            nullptr);
-//
-//        if (log_file == INVALID_HANDLE_VALUE)
-//        {
-//            std::cerr << "[Harness] Failed to open log file: " << log_path << "\n";
-//            return false;
-//        }
-//
-//        STARTUPINFOW startup_info{};
-//        startup_info.cb = sizeof(startup_info);
-//        startup_info.dwFlags = STARTF_USESTDHANDLES;
-//        startup_info.hStdOutput = log_file;
-//        startup_info.hStdError = log_file;
-//        startup_info.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
-//
-//        PROCESS_INFORMATION pi{};
-//        BOOL success = CreateProcessW(
-//            nullptr,
-//            command_line.data(),
-//            nullptr,
-//            nullptr,
-//            TRUE,
-//            CREATE_NO_WINDOW,
-//            nullptr,
-//            nullptr,
-//            &startup_info,
-//            &pi);
-//
-//        CloseHandle(log_file);
-//
-//        if (!success)
-//        {
-//            std::cerr << "[Harness] Failed to launch process for " << binary << "\n";
-//            return false;
-//        }
-//
-//        process_info = pi;
-//        return true;
-//    }
-//#endif
-//
-//    void write_manifest(
-//        const std::filesystem::path& manifest_path,
-//        const BackendScene& backend,
-//        const std::filesystem::path& binary,
-//        const std::string& args,
-//        const std::vector<ScheduledAction>& schedule,
-//        bool capture)
-//    {
-//        std::ofstream manifest(manifest_path);
-//        manifest << "{\n";
-//        manifest << "  \"backend\": \"" << backend.name << "\",\n";
-//        manifest << "  \"binary\": \"" << binary.generic_string() << "\",\n";
-//        manifest << "  \"args\": \"" << args << "\",\n";
-//        manifest << "  \"expected_output\": \"" << backend.expected_output << "\",\n";
-//        manifest << "  \"capture_enabled\": " << (capture ? "true" : "false") << ",\n";
-//        manifest << "  \"schedule\": [\n";
-//        for (size_t i = 0; i < schedule.size(); ++i)
-//        {
-//            const auto& action = schedule[i];
-//            manifest << "    {\n";
-//            manifest << "      \"type\": \"";
-//            switch (action.type)
-//            {
-//            case ScheduledAction::Type::Resize:
-//                manifest << "resize";
-//                break;
-//            case ScheduledAction::Type::DockDetach:
-//                manifest << "dock_detach";
-//                break;
-//            case ScheduledAction::Type::DockAttach:
-//                manifest << "dock_attach";
-//                break;
-//            case ScheduledAction::Type::CaptureHint:
-//                manifest << "capture";
-//                break;
-//            }
-//            manifest << "\",\n";
-//            manifest << "      \"at_seconds\": " << action.at_seconds << ",\n";
-//            manifest << "      \"width\": " << action.width << ",\n";
-//            manifest << "      \"height\": " << action.height << ",\n";
-//            manifest << "      \"note\": \"" << action.note << "\"\n";
-//            manifest << "    }";
-//            if (i + 1 < schedule.size())
-//            {
-//                manifest << ",";
-//            }
-//            manifest << "\n";
-//        }
-//        manifest << "  ]\n";
-//        manifest << "}\n";
-//    }
-//}
-//
-//int main(int argc, char** argv)
-//{
-//    const HarnessOptions options = parse_args(argc, argv);
-//    const auto stamp = format_timestamp();
-//    const auto definitions = backend_definitions();
-//
-//    for (const auto& backend : definitions)
-//    {
-//        if (options.backend_filter && *options.backend_filter != backend.name)
-//        {
-//            continue;
-//        }
-//        if (!backend.include_by_default && !options.backend_filter)
-//        {
-//            continue;
-//        }
-//
-//        const auto log_dir = ensure_backend_log_dir(backend.name);
-//        const auto log_path = build_log_path(log_dir, stamp);
-//        const auto manifest_path = build_manifest_path(log_dir, stamp);
-//        const auto capture_path = build_capture_notes_path(log_dir, stamp);
-//
-//        std::ostringstream args;
-//        args << "--renderer=" << backend.renderer_arg
-//             << " --scene=" << backend.scene_arg
-//             << " --width 1280 --height 720";
-//        if (options.capture)
-//        {
-//            args << " --capture";
-//        }
-//
-//        const auto schedule = build_schedule(backend.requires_dock_actions, options.capture);
-//
-//        write_manifest(manifest_path, backend, options.binary_path, args.str(), schedule, options.capture);
-//
-//        if (options.capture)
-//        {
-//            std::ofstream capture_notes(capture_path);
-//            capture_notes << "Capture schedule for backend " << backend.name << "\n";
-//            capture_notes << "- OpenGL: RenderDoc capture on second frame after each resize.\n";
-//            capture_notes << "- SDL: OBS capture after each resize, verify SDL renderer stats.\n";
-//            capture_notes << "- Raylib: TakeScreenshot after each resize.\n";
-//            capture_notes << "- Software: dump framebuffer PNG after each resize.\n";
-//            capture_notes << "\n";
-//            capture_notes << "Actions:\n";
-//            for (const auto& action : schedule)
-//            {
-//                capture_notes << "  - t=" << action.at_seconds << "s: " << action.note << "\n";
-//            }
-//        }
-//
-//#if defined(_WIN32)
-//        if (options.capture)
-//        {
-//            SetEnvironmentVariableW(L"ALMOND_CAPTURE_DIR", widen_path(log_dir).c_str());
-//        }
-//
-//        PROCESS_INFORMATION pi{};
-//        if (!launch_process(options.binary_path, args.str(), log_path, pi))
-//        {
-//            return 1;
-//        }
-//
-//        const auto window_title = build_window_title(backend.name);
-//        HWND hwnd = wait_for_window(window_title, std::chrono::seconds(10));
-//        HWND parent = nullptr;
-//        if (backend.requires_dock_actions)
-//        {
-//            parent = wait_for_window(L"Almond Docking", std::chrono::seconds(10));
-//        }
-//
-//        const auto start = Clock::now();
-//        size_t action_index = 0;
-//
-//        while (true)
-//        {
-//            DWORD wait_result = WaitForSingleObject(pi.hProcess, 0);
-//            if (wait_result == WAIT_OBJECT_0)
-//            {
-//                break;
-//            }
-//
-//            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - start).count();
-//            if (elapsed >= options.duration_seconds)
-//            {
-//                TerminateProcess(pi.hProcess, 0);
-//                break;
-//            }
-//
-//            while (action_index < schedule.size() && elapsed >= schedule[action_index].at_seconds)
-//            {
-//                const auto& action = schedule[action_index];
-//                switch (action.type)
-//                {
-//                case ScheduledAction::Type::Resize:
-//                    resize_window(hwnd, action.width, action.height);
-//                    break;
-//                case ScheduledAction::Type::DockDetach:
-//                    if (hwnd)
-//                    {
-//                        SetParent(hwnd, nullptr);
-//                        set_child_style(hwnd, false);
-//                    }
-//                    break;
-//                case ScheduledAction::Type::DockAttach:
-//                    if (hwnd && parent)
-//                    {
-//                        SetParent(hwnd, parent);
-//                        set_child_style(hwnd, true);
-//                    }
-//                    break;
-//                case ScheduledAction::Type::CaptureHint:
-//                    break;
-//                }
-//                ++action_index;
-//            }
-//
-//            std::this_thread::sleep_for(std::chrono::milliseconds(200));
-//        }
-//
-//        CloseHandle(pi.hThread);
-//        CloseHandle(pi.hProcess);
-//#else
-//        std::ostringstream command;
-//        command << options.binary_path.string() << " " << args.str() << " > " << log_path.string() << " 2>&1";
-//        std::cout << "[Harness] Non-Windows run: " << command.str() << "\n";
-//        const int result = std::system(command.str().c_str());
-//        if (result != 0)
-//        {
-//            std::cerr << "[Harness] Command failed with status " << result << "\n";
-//        }
-//#endif
-//    }
-//
-//    return 0;
-//}
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondEngine - Modular C++ Game Engine                   *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for non-commercial purposes only           *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution allowed with this notice.                 *
+ *   No obligation to disclose modifications.                 *
+ *   See LICENSE file for full terms.                         *
+ **************************************************************/
+ //
+ // renderer_smoke_harness.cpp
+ // Headless renderer smoke test (almondshell_renderer_smoke, run by CTest)
+ //
+ // Each backend scene is stepped for a fixed number of frames at a fixed
+ // timestep, so the output depends only on the frame index. Every frame's
+ // framebuffer is hashed and folded into one run hash, and the wall time of
+ // each frame (excluding hashing) is recorded. Wall time, not thread CPU time,
+ // so raster tiles running on the TaskGraph workers count toward the frame.
+ // A scene fails when
+ //   - two consecutive runs in the same process disagree (non-determinism),
+ //   - its hash differs from the baseline file (output drift),
+ //   - its p95 frame time exceeds the baseline by more than the tolerance
+ //     (unless --no-perf-gate), or
+ //   - the baseline has no entry for it at this frame count and size.
+ // The baseline lives in the source tree; --update-baseline rewrites the
+ // entries for the scenes that ran after an intentional output change.
+ //
+ // Software frames are published through acontext.softrenderer.capture as the
+ // backend does on present. --capture <dir> streams them to <dir>/<scene>/ and
+ // fails the scene unless every frame was written.
+ //
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+import <algorithm>;
+import <chrono>;
+import <cmath>;
+import <cstdint>;
+import <cstdlib>;
+import <filesystem>;
+import <fstream>;
+import <functional>;
+import <iomanip>;
+import <iostream>;
+import <map>;
+import <memory>;
+import <optional>;
+import <span>;
+import <sstream>;
+import <string>;
+import <string_view>;
+import <system_error>;
+import <vector>;
+
+import aatlas.texture;                   // TextureAtlas
+import atexture;                         // almondnamespace::Texture (atlas input)
+import aengine.context.commandqueue;     // core::CommandQueue
+#if defined(ALMOND_USING_NOOP_HEADLESS)
+import aengine.context.type;             // core::ContextType
+import aengine.core.context;             // core::Context
+import acontext.noop.context;            // noopcontext::noop_process
+import aspritehandle;                    // SpriteHandle
+#endif
+import acontext.softrenderer.state;      // SoftFrameResources
+import acontext.softrenderer.textures;   // anativecontext::Texture, AtlasTextureCache
+import acontext.softrenderer.renderer;   // SoftwareRenderer
+import acontext.softrenderer.blit;       // blit::blit_scaled
+import acontext.softrenderer.sampler;    // sampler::Filter
+import acontext.softrenderer.capture;    // capture::publish_frame, start_frame_stream
+
+namespace
+{
+    using namespace almondnamespace;
+    using namespace almondnamespace::anativecontext;
+
+    constexpr double kFixedStep = 1.0 / 60.0;
+
+    struct HarnessOptions
+    {
+        int frames = 120;
+        int width = 640;
+        int height = 360;
+        std::optional<std::string> backend_filter;
+        std::filesystem::path baseline_path{};
+        std::filesystem::path capture_dir{};
+        bool update_baseline = false;
+        bool perf_gate = true;
+        double tolerance = 0.5;   // allowed p95 growth, as a fraction of the baseline
+        double slack_us = 250.0;  // absolute allowance so tiny scenes don't trip on noise
+    };
+
+    // ─── Hashing / timing ───────────────────────────────────────
+
+    // FNV-1a over 32-bit words; framebuffers are packed 0xAARRGGBB.
+    struct FrameHash
+    {
+        std::uint64_t value = 0xcbf29ce484222325ull;
+
+        void add(std::uint64_t word) noexcept
+        {
+            value ^= word;
+            value *= 0x100000001b3ull;
+        }
+
+        void add(const std::vector<std::uint32_t>& pixels) noexcept
+        {
+            for (const std::uint32_t p : pixels)
+                add(std::uint64_t(p));
+        }
+    };
+
+    double now_us()
+    {
+        return std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct Percentiles
+    {
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    Percentiles percentiles(std::vector<double> samples)
+    {
+        Percentiles p{};
+        if (samples.empty())
+            return p;
+
+        std::sort(samples.begin(), samples.end());
+        auto at = [&](double q)
+            {
+                const auto index = std::size_t(std::ceil(q * double(samples.size()))) - 1;
+                return samples[(std::min)(index, samples.size() - 1)];
+            };
+        p.p50 = at(0.50);
+        p.p95 = at(0.95);
+        p.p99 = at(0.99);
+        p.max = samples.back();
+        return p;
+    }
+
+    // ─── Scenes ─────────────────────────────────────────────────
+
+    // One scene instance. `step` advances to `frame` (time = frame * kFixedStep)
+    // and renders; `hash` folds whatever the frame produced. `framebuffer` is
+    // set by scenes that present one.
+    struct SceneRun
+    {
+        std::function<void(int frame, double time)> step;
+        std::function<void(FrameHash&)> hash;
+        std::function<const SoftFrameResources*()> framebuffer;
+    };
+
+    struct BackendScene
+    {
+        std::string name;
+        std::string renderer_arg;
+        std::string scene_arg;
+        std::string expected_output;
+        std::function<SceneRun(const HarnessOptions&)> create;
+    };
+
+    // xorshift32; std distributions are not reproducible across standard libraries.
+    struct Rng
+    {
+        std::uint32_t state = 0x2545F491u;
+
+        std::uint32_t next() noexcept
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    };
+
+    TexturePtr make_checkerboard(int size, int cell)
+    {
+        auto tex = create_texture(size, size);
+        for (int y = 0; y < size; ++y)
+            for (int x = 0; x < size; ++x)
+                tex->pixels[std::size_t(y) * std::size_t(size) + std::size_t(x)] =
+                    ((x / cell + y / cell) % 2) ? 0xFFE0E0E0u : 0xFF303030u;
+        tex->mark_dirty();
+        return tex;
+    }
+
+    // Checkerboard quad sliding across the frame; the framebuffer grows to
+    // 150% halfway through, as the windowed scene does on resize.
+    SceneRun cpu_quad_scene(const HarnessOptions& options)
+    {
+        struct State
+        {
+            SoftFrameResources frame{};
+            TexturePtr checker = make_checkerboard(64, 8);
+        };
+        auto state = std::make_shared<State>();
+        state->frame.resize(options.width, options.height);
+
+        SceneRun run{};
+        run.step = [state, options](int frame, double time)
+            {
+                auto& fb = state->frame;
+                if (frame == options.frames / 2)
+                    fb.resize(options.width * 3 / 2, options.height * 3 / 2);
+
+                if (fb.color.size() != fb.pixel_count())
+                {
+                    std::cerr << "[Smoke] cpu_quad: framebuffer length does not match width*height\n";
+                    std::exit(EXIT_FAILURE);
+                }
+
+                fb.clear_color(0xFF000000u);
+                const int size = (std::min)(fb.width, fb.height) / 2;
+                const int x = int(std::lround((0.5 + 0.4 * std::sin(time)) * double(fb.width - size)));
+                const int y = (fb.height - size) / 2;
+                const auto& tex = *state->checker;
+                blit::blit_scaled({ fb.color.data(), fb.width, fb.height },
+                    { tex.pixels.data(), tex.width, 0, 0, tex.width, tex.height, blit::SourceFormat::ARGB32 },
+                    x, y, size, size, blit::BlendMode::Copy, tex.filter);
+            };
+        run.hash = [state](FrameHash& h)
+            {
+                h.add(std::uint64_t(state->frame.width) << 32 | std::uint32_t(state->frame.height));
+                h.add(state->frame.color);
+            };
+        run.framebuffer = [state] { return &state->frame; };
+        return run;
+    }
+
+    // Textured cube through the transform, clipping and tile rasterizer.
+    SceneRun cube_scene(const HarnessOptions& options)
+    {
+        struct State
+        {
+            SoftFrameResources frame{};
+            TexturePtr checker = make_checkerboard(64, 8);
+        };
+        auto state = std::make_shared<State>();
+        state->frame.resize(options.width, options.height);
+        state->frame.ensure_depth();
+
+        SceneRun run{};
+        run.step = [state](int, double time)
+            {
+                state->frame.clear_color(0xFF101018u);
+                state->frame.invalidate_depth();
+                SoftwareRenderer::render_cube(state->frame, state->checker, float(time));
+            };
+        run.hash = [state](FrameHash& h) { h.add(state->frame.color); };
+        run.framebuffer = [state] { return &state->frame; };
+        return run;
+    }
+
+    // Atlas-backed sprite grid: background plus one alpha-blended sprite per
+    // cell, with one tile re-uploaded every frame through the dirty-region path.
+    SceneRun sprite_grid_scene(const HarnessOptions& options)
+    {
+        struct State
+        {
+            SoftFrameResources frame{};
+            TextureAtlas atlas{};
+            AtlasTextureCache mirrors{};
+            std::vector<AtlasRegion> tiles{};
+            AtlasRegion background{};
+            std::vector<std::uint8_t> patch{};
+            Rng rng{};
+        };
+        auto state = std::make_shared<State>();
+        state->frame.resize(options.width, options.height);
+
+        auto random_rgba = [&](std::uint32_t size, bool translucent)
+            {
+                std::vector<std::uint8_t> bytes(std::size_t(size) * size * 4);
+                for (std::size_t i = 0; i < bytes.size(); i += 4)
+                {
+                    const std::uint32_t v = state->rng.next();
+                    bytes[i + 0] = std::uint8_t(v);
+                    bytes[i + 1] = std::uint8_t(v >> 8);
+                    bytes[i + 2] = std::uint8_t(v >> 16);
+                    bytes[i + 3] = translucent ? std::uint8_t(v >> 24) : std::uint8_t(0xFF);
+                }
+                return bytes;
+            };
+
+        state->atlas.init({ .name = "smoke_atlas", .width = 512, .height = 512 });
+        auto add = [&](const std::string& id, std::uint32_t size, bool translucent)
+            {
+                almondnamespace::Texture tex{};
+                tex.name = id;
+                tex.width = size;
+                tex.height = size;
+                tex.pixels = random_rgba(size, translucent);
+                const auto entry = state->atlas.add_entry(id, tex);
+                return entry ? entry->region : AtlasRegion{};
+            };
+
+        state->background = add("bg", 128, false);
+        for (int i = 0; i < 8; ++i)
+            state->tiles.push_back(add("tile" + std::to_string(i), 32, (i % 2) == 0));
+        state->patch = random_rgba(32, true);
+
+        SceneRun run{};
+        run.step = [state](int frame, double)
+            {
+                auto& fb = state->frame;
+                const AtlasRegion& updated = state->tiles[std::size_t(frame) % state->tiles.size()];
+                state->atlas.blit_region(updated, state->patch.data());
+                state->atlas.mark_region_dirty(updated);
+
+                const anativecontext::Texture* mirror = state->mirrors.acquire(state->atlas);
+                if (!mirror)
+                {
+                    std::cerr << "[Smoke] sprite_grid: atlas mirror unavailable\n";
+                    std::exit(EXIT_FAILURE);
+                }
+
+                auto source = [&](const AtlasRegion& r) -> blit::BlitSource
+                    {
+                        return { mirror->pixels.data(), mirror->width,
+                            int(r.x), int(r.y), int(r.width), int(r.height), blit::SourceFormat::ARGB32 };
+                    };
+
+                const blit::BlitTarget target{ fb.color.data(), fb.width, fb.height };
+                fb.clear_color(0xFF202020u);
+                blit::blit_scaled(target, source(state->background), 0, 0, fb.width, fb.height,
+                    blit::BlendMode::Copy, sampler::Filter::Bilinear);
+
+                constexpr int cols = 8, rows = 8;
+                const int cell = (std::min)(fb.width / cols, fb.height / rows);
+                const int ox = (fb.width - cell * cols) / 2;
+                const int oy = (fb.height - cell * rows) / 2;
+                for (int r = 0; r < rows; ++r)
+                    for (int c = 0; c < cols; ++c)
+                    {
+                        const auto& tile = state->tiles[std::size_t(r * cols + c + frame) % state->tiles.size()];
+                        blit::blit_scaled(target, source(tile), ox + c * cell, oy + r * cell, cell, cell,
+                            blit::BlendMode::AlphaOver, sampler::Filter::Bilinear);
+                    }
+            };
+        run.hash = [state](FrameHash& h) { h.add(state->frame.color); };
+        run.framebuffer = [state] { return &state->frame; };
+        return run;
+    }
+
+#if defined(ALMOND_USING_NOOP_HEADLESS)
+    // Noop backend: no framebuffer, so the frame is the work noop_process
+    // does for a window - atlas upload bookkeeping plus draining the queue of
+    // sprite draws and state updates. The queue must be empty afterwards.
+    SceneRun noop_scene(const HarnessOptions&)
+    {
+        struct State
+        {
+            std::shared_ptr<core::Context> ctx = std::make_shared<core::Context>();
+            core::CommandQueue queue{};
+            std::uint64_t accumulator = 0;
+            std::uint64_t executed = 0;
+            std::uint64_t uploadPasses = 0;
+
+            State() { noopcontext::noop_initialize(); }
+            ~State() { noopcontext::noop_cleanup(); }
+        };
+        auto state = std::make_shared<State>();
+        state->ctx->type = core::ContextType::Noop;
+
+        SceneRun run{};
+        run.step = [state](int frame, double)
+            {
+                const int commands = 64 + (frame % 7) * 32;
+                for (int i = 0; i < commands; ++i)
+                {
+                    state->queue.enqueue([state, frame, i]
+                        {
+                            noopcontext::noop_draw_sprite(SpriteHandle{}, {},
+                                float(i), float(frame), 16.0f, 16.0f);
+                            state->accumulator = state->accumulator * 6364136223846793005ull
+                                + std::uint64_t(frame) * 1442695040888963407ull + std::uint64_t(i);
+                            ++state->executed;
+                        });
+                }
+
+                const auto passesBefore = noopcontext::upload_totals().passes;
+                const bool running = noopcontext::noop_process(state->ctx, state->queue);
+                const auto passes = noopcontext::upload_totals().passes - passesBefore;
+                state->uploadPasses += passes;
+
+                if (!running || passes != 1 || state->queue.depth() != 0
+                    || state->ctx->width != 1 || state->ctx->height != 1)
+                {
+                    std::cerr << "[Smoke] noop: frame did not complete (running " << running
+                        << ", upload passes " << passes << ", queue depth " << state->queue.depth() << ")\n";
+                    std::exit(EXIT_FAILURE);
+                }
+            };
+        run.hash = [state](FrameHash& h)
+            {
+                h.add(state->accumulator);
+                h.add(state->executed);
+                h.add(state->uploadPasses);
+            };
+        return run;
+    }
+#endif
+
+    std::vector<BackendScene> backend_definitions()
+    {
+        return {
+            {
+                "software_quad",
+                "software",
+                "cpu_quad",
+                "Checkerboard quad slides without tearing; framebuffer length matches width*height across the mid-run resize.",
+                cpu_quad_scene,
+            },
+            {
+                "software_cube",
+                "software",
+                "cube",
+                "Textured cube rotates with stable depth and clipping.",
+                cube_scene,
+            },
+            {
+                "software_sprites",
+                "software",
+                "sprite_grid",
+                "Atlas mirror refreshes one tile per frame; blended sprite grid is stable.",
+                sprite_grid_scene,
+            },
+#if defined(ALMOND_USING_NOOP_HEADLESS)
+            {
+                "noop",
+                "noop",
+                "headless",
+                "Noop backend runs one upload pass and drains its command queue to empty each frame, in submission order.",
+                noop_scene,
+            },
+#endif
+        };
+    }
+
+    // ─── Baseline ───────────────────────────────────────────────
+
+    struct BaselineEntry
+    {
+        int frames = 0;
+        int width = 0;
+        int height = 0;
+        std::uint64_t hash = 0;
+        double p95_us = 0.0;
+    };
+
+    using Baseline = std::map<std::string, BaselineEntry>;
+
+    // One scene per line: name frames width height hash(hex) p95_us
+    Baseline load_baseline(const std::filesystem::path& path)
+    {
+        Baseline baseline{};
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line.front() == '#')
+                continue;
+
+            std::istringstream fields(line);
+            std::string name;
+            BaselineEntry entry{};
+            if (fields >> name >> entry.frames >> entry.width >> entry.height >> std::hex >> entry.hash >> std::dec >> entry.p95_us)
+                baseline[name] = entry;
+        }
+        return baseline;
+    }
+
+    bool save_baseline(const std::filesystem::path& path, const Baseline& baseline)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+            return false;
+
+        out << "# almondshell_renderer_smoke baseline: name frames width height hash p95_us\n";
+        for (const auto& [name, entry] : baseline)
+        {
+            out << name << ' ' << entry.frames << ' ' << entry.width << ' ' << entry.height << ' '
+                << std::hex << std::setw(16) << std::setfill('0') << entry.hash << std::dec << std::setfill(' ')
+                << ' ' << std::fixed << std::setprecision(1) << entry.p95_us << "\n";
+        }
+        return bool(out);
+    }
+
+    struct SceneResult
+    {
+        std::uint64_t hash = 0;
+        Percentiles frame_us{};
+        std::uint64_t published = 0;   // frames offered to the capture hook
+    };
+
+    SceneResult run_scene(const BackendScene& scene, const HarnessOptions& options)
+    {
+        SceneRun run = scene.create(options);
+
+        std::vector<double> frame_us{};
+        frame_us.reserve(std::size_t(options.frames));
+        FrameHash total{};
+
+        std::uint64_t published = 0;
+
+        for (int frame = 0; frame < options.frames; ++frame)
+        {
+            const double start = now_us();
+            run.step(frame, double(frame) * kFixedStep);
+            frame_us.push_back(now_us() - start);
+
+            FrameHash frame_hash{};
+            run.hash(frame_hash);
+            total.add(frame_hash.value);
+
+            if (const SoftFrameResources* fb = run.framebuffer ? run.framebuffer() : nullptr)
+            {
+                capture::publish_frame({ std::span<const std::uint32_t>(fb->color),
+                    fb->width, fb->height, std::uint64_t(frame) });
+                ++published;
+            }
+        }
+
+        return { total.value, percentiles(std::move(frame_us)), published };
+    }
+
+    std::uint64_t count_frames(const std::filesystem::path& dir)
+    {
+        std::uint64_t count = 0;
+        std::error_code ec{};
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+            count += entry.path().extension() == ".ppm" ? 1u : 0u;
+        return count;
+    }
+
+    std::string hex(std::uint64_t value)
+    {
+        std::ostringstream oss;
+        oss << std::hex << std::setw(16) << std::setfill('0') << value;
+        return oss.str();
+    }
+
+    std::optional<HarnessOptions> parse_args(int argc, char** argv)
+    {
+        HarnessOptions options{};
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (arg == "--frames" && i + 1 < argc)
+            {
+                options.frames = (std::max)(1, std::atoi(argv[++i]));
+            }
+            else if (arg == "--width" && i + 1 < argc)
+            {
+                options.width = (std::max)(16, std::atoi(argv[++i]));
+            }
+            else if (arg == "--height" && i + 1 < argc)
+            {
+                options.height = (std::max)(16, std::atoi(argv[++i]));
+            }
+            else if (arg == "--backend" && i + 1 < argc)
+            {
+                options.backend_filter = std::string(argv[++i]);
+            }
+            else if (arg == "--baseline" && i + 1 < argc)
+            {
+                options.baseline_path = argv[++i];
+            }
+            else if (arg == "--capture" && i + 1 < argc)
+            {
+                options.capture_dir = argv[++i];
+            }
+            else if (arg == "--update-baseline")
+            {
+                options.update_baseline = true;
+            }
+            else if (arg == "--tolerance" && i + 1 < argc)
+            {
+                options.tolerance = std::atof(argv[++i]);
+            }
+            else if (arg == "--no-perf-gate")
+            {
+                options.perf_gate = false;
+            }
+            else
+            {
+                std::cout
+                    << "Renderer smoke harness\n"
+                    << "  --frames <n>         Fixed-timestep frames per scene (default 120)\n"
+                    << "  --width/--height <n> Framebuffer size (default 640x360)\n"
+                    << "  --backend <name>     Run one scene (software_quad|software_cube|software_sprites|noop)\n"
+                    << "  --baseline <file>    Compare against a baseline file; scenes missing from it fail\n"
+                    << "  --update-baseline    Record this run's entries into the baseline file instead\n"
+                    << "  --capture <dir>      Stream every software frame to <dir>/<scene>/ as PPM\n"
+                    << "  --tolerance <x>      Allowed p95 frame time growth over baseline (default 0.5 = +50%)\n"
+                    << "  --no-perf-gate       Report timings without failing on regressions\n";
+                return std::nullopt;
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const auto parsed = parse_args(argc, argv);
+    if (!parsed)
+        return EXIT_FAILURE;
+    const HarnessOptions& options = *parsed;
+    if (options.update_baseline && options.baseline_path.empty())
+    {
+        std::cerr << "[Smoke] --update-baseline needs --baseline <file>\n";
+        return EXIT_FAILURE;
+    }
+
+    Baseline baseline = options.baseline_path.empty() ? Baseline{} : load_baseline(options.baseline_path);
+    bool baseline_changed = false;
+    int failures = 0;
+    int ran = 0;
+
+    std::cout << "[Smoke] " << options.frames << " frames @ " << options.width << "x" << options.height
+        << ", dt " << std::setprecision(4) << kFixedStep << "s\n";
+
+    for (const auto& scene : backend_definitions())
+    {
+        if (options.backend_filter && *options.backend_filter != scene.name)
+            continue;
+        ++ran;
+
+        // The callback sees each published frame in place; it must agree with
+        // the framebuffer the scene reports.
+        std::uint64_t captured = 0;
+        bool capture_mismatch = false;
+        capture::set_frame_capture_callback([&](const capture::CapturedFrame& frame)
+            {
+                ++captured;
+                capture_mismatch = capture_mismatch
+                    || frame.pixels.size() != std::size_t(frame.width) * std::size_t(frame.height);
+            });
+
+        const SceneResult first = run_scene(scene, options);
+
+        // Stream only the second run; it must match the first anyway.
+        const std::filesystem::path capture_dir = options.capture_dir.empty()
+            ? std::filesystem::path{} : options.capture_dir / scene.name;
+        if (!capture_dir.empty() && first.published != 0)
+        {
+            std::error_code ec{};
+            std::filesystem::remove_all(capture_dir, ec); // stale frames would skew the count
+            capture::start_frame_stream({ .directory = capture_dir });
+        }
+
+        const SceneResult second = run_scene(scene, options);
+
+        capture::stop_frame_stream();
+        capture::set_frame_capture_callback({});
+
+        std::cout << "  " << std::left << std::setw(18) << scene.name << std::right
+            << " --renderer=" << scene.renderer_arg << " --scene=" << scene.scene_arg
+            << "  hash " << hex(second.hash) << std::fixed << std::setprecision(1)
+            << "  frame us p50 " << second.frame_us.p50 << " p95 " << second.frame_us.p95
+            << " p99 " << second.frame_us.p99 << " max " << second.frame_us.max << "\n";
+
+        bool failed = false;
+        if (captured != first.published + second.published || capture_mismatch)
+        {
+            std::cerr << "[Smoke] " << scene.name << ": capture hook saw " << captured << " of "
+                << (first.published + second.published) << " published frames"
+                << (capture_mismatch ? " (bad frame dimensions)" : "") << "\n";
+            failed = true;
+        }
+
+        if (!capture_dir.empty() && second.published != 0)
+        {
+            const auto written = count_frames(capture_dir);
+            if (written != second.published)
+            {
+                std::cerr << "[Smoke] " << scene.name << ": frame stream wrote " << written << " of "
+                    << second.published << " frames to " << capture_dir << "\n";
+                failed = true;
+            }
+        }
+
+        if (first.hash != second.hash)
+        {
+            std::cerr << "[Smoke] " << scene.name << ": non-deterministic output ("
+                << hex(first.hash) << " vs " << hex(second.hash) << ")\n";
+            failed = true;
+        }
+
+        const BaselineEntry current{ options.frames, options.width, options.height, second.hash, second.frame_us.p95 };
+        const auto it = baseline.find(scene.name);
+        const bool comparable = it != baseline.end()
+            && it->second.frames == options.frames
+            && it->second.width == options.width
+            && it->second.height == options.height;
+
+        if (comparable && !options.update_baseline)
+        {
+            const BaselineEntry& expected = it->second;
+            if (expected.hash != current.hash)
+            {
+                std::cerr << "[Smoke] " << scene.name << ": frame hash drifted from baseline ("
+                    << hex(expected.hash) << " -> " << hex(current.hash) << ")\n"
+                    << "        expected: " << scene.expected_output << "\n";
+                failed = true;
+            }
+
+            const double limit = expected.p95_us * (1.0 + options.tolerance) + options.slack_us;
+            if (options.perf_gate && current.p95_us > limit)
+            {
+                std::cerr << "[Smoke] " << scene.name << ": p95 frame time " << current.p95_us
+                    << " us exceeds baseline " << expected.p95_us << " us (limit " << limit << " us)\n";
+                failed = true;
+            }
+        }
+        else if (options.update_baseline && !failed)
+        {
+            baseline[scene.name] = current;
+            baseline_changed = true;
+        }
+        else if (!options.baseline_path.empty())
+        {
+            std::cerr << "[Smoke] " << scene.name << ": no baseline entry for " << options.frames << " frames @ "
+                << options.width << "x" << options.height << " in " << options.baseline_path
+                << "; rerun with --update-baseline to record one\n";
+            failed = true;
+        }
+
+        if (failed)
+            ++failures;
+    }
+
+    if (ran == 0)
+    {
+        std::cerr << "[Smoke] no scene matches --backend " << options.backend_filter.value_or("") << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if (baseline_changed)
+    {
+        if (!save_baseline(options.baseline_path, baseline))
+        {
+            std::cerr << "[Smoke] cannot write baseline " << options.baseline_path << "\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << "[Smoke] baseline recorded in " << options.baseline_path << "\n";
+    }
+
+    if (failures != 0)
+    {
+        std::cerr << "[Smoke] " << failures << " scene(s) failed\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[Smoke] all scenes passed\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+// src/x11present_smoke.cpp
+//
+// Smoke test for the software renderer's X11 presenter. Opens a window on
+// $DISPLAY and presents a few frames through MIT-SHM (when built with
+// ALMOND_SOFT_XSHM) and then through XPutImage. Each pass checks that every
+// present succeeded on the expected path, that no SHM completion timed out,
+// and that the window holds the last frame. CTest runs it under xvfb-run.
+// Exit code is non-zero on any failure.
+//
+//   almondshell_x11present_smoke [frames]
+
+#include <include/aengine.config.hpp> // for ALMOND_USING Macros
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+import <algorithm>;
+import <cstdint>;
+import <cstdlib>;
+import <iostream>;
+import <vector>;
+
+import acontext.softrenderer.x11present;
+
+namespace
+{
+    using almondnamespace::anativecontext::x11present::X11Presenter;
+
+    constexpr int kWidth = 160;
+    constexpr int kHeight = 120;
+
+    // Red equals blue so the expected colour survives the BGR swizzle.
+    constexpr std::uint32_t frame_colour(int frame) noexcept
+    {
+        return 0xFF400040u | ((std::uint32_t(0x20 + frame * 16) & 0xFFu) << 8);
+    }
+
+    // The window's pixel at its centre as 0x00RRGGBB.
+    std::uint32_t read_centre(Display* display, ::Window window)
+    {
+        XImage* image = XGetImage(display, window, kWidth / 2, kHeight / 2, 1, 1, AllPlanes, ZPixmap);
+        if (!image)
+            return 0;
+
+        const unsigned long pixel = XGetPixel(image, 0, 0);
+        XDestroyImage(image);
+        return static_cast<std::uint32_t>(pixel) & 0x00FFFFFFu;
+    }
+
+    int run_pass(Display* display, ::Window window, bool shm, int frames)
+    {
+        const char* name = shm ? "MIT-SHM" : "XPutImage";
+        int failures = 0;
+
+        X11Presenter presenter{};
+        presenter.set_shm_enabled(shm);
+
+        std::vector<std::uint32_t> pixels(std::size_t(kWidth) * std::size_t(kHeight));
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            std::fill(pixels.begin(), pixels.end(), frame_colour(frame));
+            if (!presenter.present(display, window, pixels.data(), kWidth, kHeight))
+            {
+                std::cerr << "[X11Present] " << name << ": present failed on frame " << frame << "\n";
+                return 1;
+            }
+        }
+
+        if (presenter.using_shm() != shm)
+        {
+            std::cerr << "[X11Present] " << name << ": presented through "
+                << (presenter.using_shm() ? "MIT-SHM" : "XPutImage") << "\n";
+            ++failures;
+        }
+        if (presenter.completion_timeouts() != 0)
+        {
+            std::cerr << "[X11Present] " << name << ": " << presenter.completion_timeouts()
+                << " completion timeouts\n";
+            ++failures;
+        }
+
+        // Closing the presenter's connection waits for its requests, so the
+        // read below sees the last frame.
+        presenter.detach();
+
+        const std::uint32_t expected = frame_colour(frames - 1) & 0x00FFFFFFu;
+        const std::uint32_t actual = read_centre(display, window);
+        if (actual != expected)
+        {
+            std::cerr << "[X11Present] " << name << ": window shows " << std::hex << actual
+                << ", expected " << expected << std::dec << "\n";
+            ++failures;
+        }
+
+        if (failures == 0)
+            std::cout << "[X11Present] " << name << ": " << frames << " frames ok\n";
+        return failures;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? (std::max)(1, std::atoi(argv[1])) : 8;
+
+    Display* display = XOpenDisplay(nullptr);
+    if (!display)
+    {
+        std::cerr << "[X11Present] cannot open display (is DISPLAY set?)\n";
+        return 1;
+    }
+
+    const int screen = DefaultScreen(display);
+    const ::Window window = XCreateSimpleWindow(display, RootWindow(display, screen),
+        0, 0, kWidth, kHeight, 0, BlackPixel(display, screen), BlackPixel(display, screen));
+    XSelectInput(display, window, StructureNotifyMask);
+    XMapWindow(display, window);
+
+    for (XEvent event{}; event.type != MapNotify;)
+        XNextEvent(display, &event);
+
+    int failures = 0;
+#if defined(ALMOND_SOFT_XSHM)
+    failures += run_pass(display, window, true, frames);
+#else
+    std::cout << "[X11Present] built without ALMOND_SOFT_XSHM; MIT-SHM pass skipped\n";
+#endif
+    failures += run_pass(display, window, false, frames);
+
+    XDestroyWindow(display, window);
+    XCloseDisplay(display);
+    return failures == 0 ? 0 : 1;
+}